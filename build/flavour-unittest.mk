@@ -2,7 +2,7 @@
 # Build executable that runs unit tests.
 
 # Debug flags.
-CXXFLAGS+=-O3 -g -DUNITTEST -IContrib/catch2 -fsanitize=address
+CXXFLAGS+=-O3 -g -DUNITTEST -DCATCH_CONFIG_ENABLE_BENCHMARKING -IContrib/catch2 -fsanitize=address
 
 # Strip executable?
 OPENMSX_STRIP:=false
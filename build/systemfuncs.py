@@ -13,6 +13,13 @@ class SystemFunction(object):
 	def iterHeaders(cls, targetPlatform):
 		raise NotImplementedError
 
+class ClockNanosleepFunction(SystemFunction):
+	name = 'clock_nanosleep'
+
+	@classmethod
+	def iterHeaders(cls, targetPlatform):
+		yield '<time.h>'
+
 class FTruncateFunction(SystemFunction):
 	name = 'ftruncate'
 
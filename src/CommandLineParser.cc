@@ -6,6 +6,7 @@
 #include "FileContext.hh"
 #include "FileOperations.hh"
 #include "GlobalCliComm.hh"
+#include "StartupTrace.hh"
 #include "StdioMessages.hh"
 #include "Version.hh"
 #include "CliConnection.hh"
@@ -161,12 +162,14 @@ void CommandLineParser::parse(std::span<char*> argv)
 	     (phase <= PHASE_LAST) && (parseStatus != EXIT);
 	     phase = static_cast<ParsePhase>(phase + 1)) {
 		switch (phase) {
-		case PHASE_INIT:
+		case PHASE_INIT: {
+			StartupTrace::Phase tracePhase("Reactor::init");
 			reactor.init();
 			fileTypeCategoryInfo.emplace(
 				reactor.getOpenMSXInfoCommand(), *this);
 			getInterpreter().init(argv[0]);
 			break;
+		}
 		case PHASE_LOAD_SETTINGS:
 			// after -control and -setting has been parsed
 			if (parseStatus != CONTROL) {
@@ -176,6 +179,7 @@ void CommandLineParser::parse(std::span<char*> argv)
 				cliComm.addListener(std::make_unique<StdioMessages>());
 			}
 			if (!haveSettings) {
+				StartupTrace::Phase tracePhase("load settings");
 				auto& settingsConfig =
 					reactor.getGlobalCommandController().getSettingsConfig();
 				// Load default settings file in case the user
@@ -204,6 +208,7 @@ void CommandLineParser::parse(std::span<char*> argv)
 			break;
 		case PHASE_DEFAULT_MACHINE: {
 			if (!haveConfig) {
+				StartupTrace::Phase tracePhase("load default machine");
 				// load default config file in case the user didn't specify one
 				const auto& machine =
 					reactor.getMachineSetting().getString();
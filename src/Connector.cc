@@ -24,6 +24,10 @@ Connector::~Connector()
 
 void Connector::plug(Pluggable& device, EmuTime::param time)
 {
+	if (pluggingController.isShadow() && device.isHostOutput()) {
+		// run-ahead machine: leave the connector empty
+		return;
+	}
 	device.plug(*this, time);
 	plugged = &device; // not executed if plug fails
 }
@@ -55,8 +59,13 @@ void Connector::serialize(Archive& ar, unsigned /*version*/)
 		if (plugName.empty()) {
 			// was not plugged in
 			plugged = dummy.get();
-		} else if (Pluggable* pluggable =
-			       pluggingController.findPluggable(plugName)) {
+		} else if (Pluggable* pluggable = pluggingController.findPluggable(plugName);
+		           pluggable && pluggingController.isShadow() && pluggable->isHostOutput()) {
+			// Don't let the run-ahead machine write to the host (e.g.
+			// truncate a printer log or resend MIDI data).
+			ar.skipSection(true);
+			plugged = dummy.get();
+		} else if (pluggable) {
 			plugged = pluggable;
 			// set connector before loading the pluggable so that
 			// the pluggable can test whether it was connected
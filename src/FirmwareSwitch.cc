@@ -1,5 +1,6 @@
 #include "FirmwareSwitch.hh"
 #include "MSXCliComm.hh"
+#include "MSXMotherBoard.hh"
 #include "FileContext.hh"
 #include "File.hh"
 #include "FileException.hh"
@@ -33,6 +34,7 @@ FirmwareSwitch::FirmwareSwitch(const DeviceConfig& config_)
 FirmwareSwitch::~FirmwareSwitch()
 {
 	// save firmware switch setting value to persistent data
+	if (config.getMotherBoard().isShadow()) return; // run-ahead machine
 	try {
 		File file(config.getFileContext().resolveCreate(filename),
 		          File::OpenMode::SAVE_PERSISTENT);
@@ -7,6 +7,7 @@
 #include "CacheLine.hh"
 #include "TclObject.hh"
 #include "MSXException.hh"
+#include "narrow.hh"
 #include "one_of.hh"
 #include "ranges.hh"
 #include "serialize.hh"
@@ -523,6 +524,53 @@ void MSXDevice::fillDeviceWCache(unsigned start, unsigned size, byte* wData)
 	clip(start, size, [&](auto... args) { getCPUInterface().fillWCache(args...); }, wData);
 }
 
+void MSXDevice::refillDeviceRCache(unsigned start, unsigned size)
+{
+	assert(!allowUnaligned());
+	assert((start & CacheLine::LOW) == 0);
+	assert((size  & CacheLine::LOW) == 0);
+
+	// Current run of cache lines: [runStart, runStart + runSize) maps to
+	// [runData, runData + runSize) (or to nullptr: not cacheable (yet)).
+	unsigned runStart = start;
+	unsigned runSize = 0;
+	const byte* runData = nullptr;
+	auto flush = [&] {
+		if (runSize == 0) return;
+		if (runData) {
+			fillDeviceRCache(runStart, runSize, runData);
+		} else {
+			invalidateDeviceRCache(runStart, runSize);
+		}
+	};
+
+	// An interval passed to getReadCacheLine() never contains address
+	// 0xFFFF (see MSXCPUInterface::getReadCacheLine()), so that cache line
+	// is only invalidated. The CPU refills it via its slow path, that path
+	// checks whether the line may be cached (secondary slot register).
+	assert((start + size) <= 0x10000);
+	constexpr unsigned LAST_LINE = 0xFFFF & CacheLine::HIGH;
+	unsigned end = std::min(start + size, LAST_LINE);
+	for (unsigned addr = start; addr < end; addr += CacheLine::SIZE) {
+		const byte* line = getReadCacheLine(narrow<word>(addr));
+		bool samePage = (addr & 0x3FFF) != 0; // a fill never crosses a 16kB page
+		bool extends = (runSize != 0) && samePage &&
+		               (runData ? (line == runData + runSize) : (line == nullptr));
+		if (extends) {
+			runSize += CacheLine::SIZE;
+		} else {
+			flush();
+			runStart = addr;
+			runSize = CacheLine::SIZE;
+			runData = line;
+		}
+	}
+	flush();
+	if ((start + size) > LAST_LINE) {
+		invalidateDeviceRCache(LAST_LINE, CacheLine::SIZE);
+	}
+}
+
 template<typename Archive>
 void MSXDevice::serialize(Archive& ar, unsigned /*version*/)
 {
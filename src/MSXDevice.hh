@@ -11,6 +11,7 @@
 #include <cassert>
 #include <span>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 namespace openmsx {
@@ -135,6 +136,18 @@ public:
 	 */
 	[[nodiscard]] virtual byte peekIO(word port, EmuTime::param time) const;
 
+	/**
+	 * Non-virtual entry points for readIO() and writeIO(), these are used
+	 * by MSXCPUInterface to dispatch the emulated I/O. By default they
+	 * call the virtual methods above. Devices with very frequently
+	 * accessed ports install handlers that directly call their own
+	 * implementation, see setFastIOHandlers().
+	 */
+	using IOReadFunc  = byte(*)(MSXDevice& device, word port, EmuTime::param time);
+	using IOWriteFunc = void(*)(MSXDevice& device, word port, byte value, EmuTime::param time);
+	[[nodiscard]] IOReadFunc  getIOReadFunc()  const { return ioReadFunc; }
+	[[nodiscard]] IOWriteFunc getIOWriteFunc() const { return ioWriteFunc; }
+
 
 	// Memory
 
@@ -226,6 +239,20 @@ public:
 	void fillDeviceRCache (unsigned start, unsigned size, const byte* rData);
 	void fillDeviceWCache (unsigned start, unsigned size, byte* wData);
 
+	/** Eagerly refill the read cache for (part of) the slot of this device.
+	  * Instead of invalidating the cache lines (and letting the CPU call
+	  * getReadCacheLine() again on the next access, via its slow path),
+	  * this queries getReadCacheLine() for each cache line in the range
+	  * right away and stores the result. Consecutive lines that map to
+	  * consecutive memory are combined in a single fill.
+	  * This is intended for bank switches: call it after the device state
+	  * has been updated to select the new bank.
+	  * The range must be aligned to CacheLine::SIZE. The cache line that
+	  * contains address 0xFFFF is not refilled, only invalidated, so that
+	  * getReadCacheLine() is never called for an interval containing 0xFFFF.
+	  */
+	void refillDeviceRCache(unsigned start, unsigned size);
+
 	/** Get the mother board this device belongs to
 	  */
 	[[nodiscard]] MSXMotherBoard& getMotherBoard() const;
@@ -301,6 +328,22 @@ protected:
 	 */
 	virtual void getExtraDeviceInfo(TclObject& result) const;
 
+	/** Install I/O handlers that call Derived::readIO() and
+	  * Derived::writeIO() without going through the vtable (so the
+	  * implementation can be inlined in the handler). Must be called from
+	  * the constructor of 'Derived' (the I/O ports get registered later,
+	  * in init()).
+	  */
+	template<typename Derived> void setFastIOHandlers() {
+		static_assert(std::is_final_v<Derived>);
+		ioReadFunc = [](MSXDevice& device, word port, EmuTime::param time) {
+			return static_cast<Derived&>(device).Derived::readIO(port, time);
+		};
+		ioWriteFunc = [](MSXDevice& device, word port, byte value, EmuTime::param time) {
+			static_cast<Derived&>(device).Derived::writeIO(port, value, time);
+		};
+	}
+
 public:
 	// public to allow non-MSXDevices to use these same arrays
 	static inline std::array<byte, 0x10000> unmappedRead;  // Read only
@@ -341,6 +384,12 @@ private:
 	MemRegions memRegions;
 	IterableBitSet<256> inPorts;
 	IterableBitSet<256> outPorts;
+	IOReadFunc ioReadFunc = [](MSXDevice& device, word port, EmuTime::param time) {
+		return device.readIO(port, time);
+	};
+	IOWriteFunc ioWriteFunc = [](MSXDevice& device, word port, byte value, EmuTime::param time) {
+		device.writeIO(port, value, time);
+	};
 
 	DeviceConfig deviceConfig;
 
@@ -15,6 +15,7 @@
 #include "GlobalSettings.hh"
 #include "HardwareConfig.hh"
 #include "InfoTopic.hh"
+#include "InputLatency.hh"
 #include "JoystickPort.hh"
 #include "LedStatus.hh"
 #include "MSXCPU.hh"
@@ -33,11 +34,13 @@
 #include "RealTime.hh"
 #include "RenShaTurbo.hh"
 #include "ReverseManager.hh"
+#include "RunAhead.hh"
 #include "Schedulable.hh"
 #include "Scheduler.hh"
 #include "SimpleDebuggable.hh"
 #include "StateChangeDistributor.hh"
 #include "TclObject.hh"
+#include "VideoLayer.hh"
 #include "XMLElement.hh"
 #include "serialize.hh"
 #include "serialize_stl.hh"
@@ -186,6 +189,15 @@ private:
 	MSXMotherBoard& motherBoard;
 };
 
+class ConfigCacheInfo final : public InfoTopic
+{
+public:
+	explicit ConfigCacheInfo(MSXMotherBoard& motherBoard);
+	void execute(std::span<const TclObject> tokens,
+	             TclObject& result) const override;
+	[[nodiscard]] string help(std::span<const TclObject> tokens) const override;
+};
+
 class FastForwardHelper final : private Schedulable
 {
 public:
@@ -216,9 +228,10 @@ private:
 
 static unsigned machineIDCounter = 0;
 
-MSXMotherBoard::MSXMotherBoard(Reactor& reactor_)
+MSXMotherBoard::MSXMotherBoard(Reactor& reactor_, bool shadow_)
 	: reactor(reactor_)
 	, machineID(strCat("machine", ++machineIDCounter))
+	, shadow(shadow_)
 	, msxCliComm(make_unique<MSXCliComm>(*this, reactor.getGlobalCliComm()))
 	, msxEventDistributor(make_unique<MSXEventDistributor>())
 	, stateChangeDistributor(make_unique<StateChangeDistributor>())
@@ -242,6 +255,10 @@ MSXMotherBoard::MSXMotherBoard(Reactor& reactor_)
 {
 	slotManager = make_unique<CartridgeSlotManager>(*this);
 	reverseManager = make_unique<ReverseManager>(*this);
+	runAhead = make_unique<RunAhead>(*this);
+	inputLatency = make_unique<InputLatency>(getMachineInfoCommand());
+	msxEventDistributor->setInputLatency(inputLatency.get());
+	stateChangeDistributor->setInputLatency(inputLatency.get());
 	resetCommand = make_unique<ResetCmd>(*this);
 	loadMachineCommand = make_unique<LoadMachineCmd>(*this);
 	listExtCommand = make_unique<ListExtCmd>(*this);
@@ -252,6 +269,7 @@ MSXMotherBoard::MSXMotherBoard(Reactor& reactor_)
 	machineExtensionInfo = make_unique<MachineExtensionInfo>(*this);
 	machineMediaInfo = make_unique<MachineMediaInfo>(*this);
 	deviceInfo = make_unique<DeviceInfo>(*this);
+	configCacheInfo = make_unique<ConfigCacheInfo>(*this);
 	debugger = make_unique<Debugger>(*this);
 
 	// Do this before machine-specific settings are created, otherwise
@@ -553,6 +571,7 @@ bool MSXMotherBoard::execute()
 	assert(getMachineConfig()); // otherwise powered cannot be true
 
 	getCPU().execute(false);
+	runAhead->execute();
 	return true;
 }
 
@@ -685,6 +704,15 @@ void MSXMotherBoard::activate(bool active_)
 	}
 }
 
+void MSXMotherBoard::setVideoHidden(bool hidden)
+{
+	if (videoHidden == hidden) return;
+	videoHidden = hidden;
+	for (auto* layer : videoLayers) {
+		layer->calcCoverage();
+	}
+}
+
 void MSXMotherBoard::exitCPULoopAsync()
 {
 	if (getMachineConfig()) {
@@ -758,12 +786,14 @@ void MSXMotherBoard::unregisterMediaInfo(MediaInfoProvider& provider)
 AddRemoveUpdate::AddRemoveUpdate(MSXMotherBoard& motherBoard_)
 	: motherBoard(motherBoard_)
 {
+	if (motherBoard.isShadow()) return;
 	motherBoard.getReactor().getGlobalCliComm().update(
 		CliComm::UpdateType::HARDWARE, motherBoard.getMachineID(), "add");
 }
 
 AddRemoveUpdate::~AddRemoveUpdate()
 {
+	if (motherBoard.isShadow()) return;
 	motherBoard.getReactor().getGlobalCliComm().update(
 		CliComm::UpdateType::HARDWARE, motherBoard.getMachineID(), "remove");
 }
@@ -1142,6 +1172,30 @@ void DeviceInfo::tabCompletion(std::vector<string>& tokens) const
 }
 
 
+// ConfigCacheInfo
+
+ConfigCacheInfo::ConfigCacheInfo(MSXMotherBoard& motherBoard_)
+	: InfoTopic(motherBoard_.getMachineInfoCommand(), "config_cache")
+{
+}
+
+void ConfigCacheInfo::execute(std::span<const TclObject> /*tokens*/,
+                              TclObject& result) const
+{
+	auto stats = HardwareConfig::getConfigCacheStats();
+	result.addDictKeyValues("hits", stats.hits,
+	                        "misses", stats.misses,
+	                        "entries", stats.entries);
+}
+
+string ConfigCacheInfo::help(std::span<const TclObject> /*tokens*/) const
+{
+	return "Returns statistics of the cache of parsed machine and extension "
+	       "configuration files (shared by all machines): the number of "
+	       "cache hits, misses and the number of cached files.";
+}
+
+
 // FastForwardHelper
 
 FastForwardHelper::FastForwardHelper(MSXMotherBoard& motherBoard_)
@@ -22,6 +22,7 @@ class AddRemoveUpdate;
 class CartridgeSlotManager;
 class CassettePortInterface;
 class CommandController;
+class ConfigCacheInfo;
 class Debugger;
 class DeviceInfo;
 class EventDelay;
@@ -29,6 +30,7 @@ class ExtCmd;
 class FastForwardHelper;
 class HardwareConfig;
 class InfoCommand;
+class InputLatency;
 class JoyPortDebuggable;
 class JoystickPortIf;
 class Keyboard;
@@ -56,9 +58,11 @@ class RemoveExtCmd;
 class RenShaTurbo;
 class ResetCmd;
 class ReverseManager;
+class RunAhead;
 class SettingObserver;
 class Scheduler;
 class StateChangeDistributor;
+class VideoLayer;
 
 class MediaInfoProvider
 {
@@ -88,7 +92,12 @@ public:
 	MSXMotherBoard& operator=(const MSXMotherBoard&) = delete;
 	MSXMotherBoard& operator=(MSXMotherBoard&&) = delete;
 
-	explicit MSXMotherBoard(Reactor& reactor);
+	/** @param shadow True for the (temporary) machine that is used to run
+	  *               ahead of the real machine, see RunAhead. Such a
+	  *               machine has no (externally) visible side effects
+	  *               other than its video output.
+	  */
+	explicit MSXMotherBoard(Reactor& reactor, bool shadow = false);
 	~MSXMotherBoard();
 
 	[[nodiscard]] std::string_view getMachineID()   const { return machineID; }
@@ -121,6 +130,15 @@ public:
 	void activate(bool active);
 	[[nodiscard]] bool isActive() const { return active; }
 	[[nodiscard]] bool isFastForwarding() const { return fastForwarding; }
+	[[nodiscard]] bool isShadow() const { return shadow; }
+
+	/** Hide the video output of this (active) machine, e.g. because
+	  * run-ahead shows the output of a shadow machine instead. */
+	void setVideoHidden(bool hidden);
+	/** Should the video output of this machine be rendered and shown? */
+	[[nodiscard]] bool isVideoShown() const {
+		return shadow || (active && !videoHidden);
+	}
 
 	[[nodiscard]] byte readIRQVector() const;
 
@@ -161,6 +179,7 @@ public:
 	[[nodiscard]] RenShaTurbo& getRenShaTurbo();
 	[[nodiscard]] LedStatus& getLedStatus();
 	[[nodiscard]] ReverseManager& getReverseManager() { return *reverseManager; }
+	[[nodiscard]] InputLatency& getInputLatency() { return *inputLatency; }
 	[[nodiscard]] Reactor& getReactor() { return reactor; }
 	[[nodiscard]] VideoSourceSetting& getVideoSource() { return videoSourceSetting; }
 	[[nodiscard]] BooleanSetting& suppressMessages() { return suppressMessagesSetting; }
@@ -242,6 +261,16 @@ public:
 		auto it = find_unguarded(keyboards, &keyboard);
 		keyboards.erase(it);
 	}
+
+	/** VideoLayers register themselves, so that they can be told when
+	  * isVideoShown() changes.
+	  */
+	void registerVideoLayer(VideoLayer& layer) {
+		videoLayers.push_back(&layer);
+	}
+	void unregisterVideoLayer(VideoLayer& layer) {
+		move_pop_back(videoLayers, rfind_unguarded(videoLayers, &layer));
+	}
 	[[nodiscard]] Keyboard* getKeyboard() const {
 		// Typically there's exactly 1 keyboard, except for early during
 		// machine construction, or on artificial machine configs
@@ -261,6 +290,7 @@ private:
 	Reactor& reactor;
 	std::string machineID;
 	std::string machineName;
+	const bool shadow;
 
 	std::vector<MSXDevice*> availableDevices; // no ownership, no order
 
@@ -308,6 +338,8 @@ private:
 
 	std::unique_ptr<CartridgeSlotManager> slotManager;
 	std::unique_ptr<ReverseManager> reverseManager;
+	std::unique_ptr<RunAhead> runAhead;
+	std::unique_ptr<InputLatency> inputLatency;
 	std::unique_ptr<ResetCmd>     resetCommand;
 	std::unique_ptr<LoadMachineCmd> loadMachineCommand;
 	std::unique_ptr<ListExtCmd>   listExtCommand;
@@ -317,6 +349,7 @@ private:
 	std::unique_ptr<MachineTypeInfo> machineTypeInfo;
 	std::unique_ptr<MachineExtensionInfo> machineExtensionInfo;
 	std::unique_ptr<DeviceInfo>   deviceInfo;
+	std::unique_ptr<ConfigCacheInfo> configCacheInfo;
 	friend class DeviceInfo;
 
 	std::unique_ptr<FastForwardHelper> fastForwardHelper;
@@ -326,10 +359,12 @@ private:
 	BooleanSetting& powerSetting;
 
 	std::vector<Keyboard*> keyboards; // typically contains exactly 1 item
+	std::vector<VideoLayer*> videoLayers; // no order
 
 	bool powered = false;
 	bool active = false;
 	bool fastForwarding = false;
+	bool videoHidden = false;
 };
 SERIALIZE_CLASS_VERSION(MSXMotherBoard, 5);
 
@@ -1,4 +1,5 @@
 #include "MSXPPI.hh"
+#include "InputLatency.hh"
 #include "LedStatus.hh"
 #include "MSXCPUInterface.hh"
 #include "MSXMotherBoard.hh"
@@ -25,6 +26,7 @@ MSXPPI::MSXPPI(const DeviceConfig& config)
 		config.getMotherBoard().getStateChangeDistributor(),
 		Keyboard::Matrix::MSX, config)
 {
+	setFastIOHandlers<MSXPPI>();
 	reset(getCurrentTime());
 }
 
@@ -83,6 +85,8 @@ void MSXPPI::writeA(byte value, EmuTime::param /*time*/)
 
 byte MSXPPI::readB(EmuTime::param time)
 {
+	getMotherBoard().getInputLatency().inputRead(
+		InputLatency::Source::KEYBOARD, time);
 	return peekB(time);
 }
 byte MSXPPI::peekB(EmuTime::param time) const
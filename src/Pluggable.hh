@@ -26,6 +26,13 @@ public:
 	  */
 	[[nodiscard]] virtual std::string_view getDescription() const = 0;
 
+	/** Does this pluggable send data to the host (a file, a MIDI port, a
+	  * network socket, ...)? Such pluggables are never plugged into a
+	  * run-ahead (shadow) machine, that machine must not have any visible
+	  * side effects.
+	  */
+	[[nodiscard]] virtual bool isHostOutput() const { return false; }
+
 	/** This method is called when this pluggable is inserted in a
 	  * connector.
 	  * @throws PlugException
@@ -225,6 +225,11 @@ CliComm& PluggingController::getCliComm()
 	return motherBoard.getMSXCliComm();
 }
 
+bool PluggingController::isShadow() const
+{
+	return motherBoard.isShadow();
+}
+
 EmuTime::param PluggingController::getCurrentTime() const
 {
 	return motherBoard.getCurrentTime();
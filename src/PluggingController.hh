@@ -50,6 +50,11 @@ public:
 	 */
 	[[nodiscard]] CliComm& getCliComm();
 
+	/** Is this the controller of a run-ahead (shadow) machine? Pluggables
+	  * that send data to the host are never plugged into such a machine.
+	  */
+	[[nodiscard]] bool isShadow() const;
+
 	/** Convenience method: get current time.
 	 */
 	[[nodiscard]] EmuTime::param getCurrentTime() const;
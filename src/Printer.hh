@@ -32,6 +32,7 @@ public:
 	void writeData(uint8_t data, EmuTime::param time) override;
 
 	// Pluggable
+	[[nodiscard]] bool isHostOutput() const override { return true; }
 	void plugHelper(Connector& connector, EmuTime::param time) override;
 	void unplugHelper(EmuTime::param time) override;
 
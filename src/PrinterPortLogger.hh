@@ -22,6 +22,7 @@ public:
 	// Pluggable
 	[[nodiscard]] std::string_view getName() const override;
 	[[nodiscard]] std::string_view getDescription() const override;
+	[[nodiscard]] bool isHostOutput() const override { return true; }
 	void plugHelper(Connector& connector, EmuTime::param time) override;
 	void unplugHelper(EmuTime::param time) override;
 
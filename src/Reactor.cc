@@ -1,9 +1,12 @@
 #include "Reactor.hh"
 
 #include "AfterCommand.hh"
+#include "AsyncFileWriter.hh"
 #include "AviRecorder.hh"
 #include "BooleanSetting.hh"
+#include "BreakPoint.hh"
 #include "Command.hh"
+#include "DebugCondition.hh"
 #include "CommandException.hh"
 #include "CommandLineParser.hh"
 #include "DiskChanger.hh"
@@ -24,6 +27,7 @@
 #include "InfoTopic.hh"
 #include "InputEventGenerator.hh"
 #include "Keyboard.hh"
+#include "MSXCPUInterface.hh"
 #include "MSXMotherBoard.hh"
 #include "MessageCommand.hh"
 #include "Mixer.hh"
@@ -31,12 +35,15 @@
 #include "RTScheduler.hh"
 #include "RomDatabase.hh"
 #include "RomInfo.hh"
+#include "StartupTrace.hh"
 #include "StateChangeDistributor.hh"
 #include "SymbolManager.hh"
+#include "TclCallback.hh"
 #include "TclCallbackMessages.hh"
 #include "TclObject.hh"
 #include "UserSettings.hh"
 #include "VideoSystem.hh"
+#include "WatchPoint.hh"
 #include "XMLElement.hh"
 #include "XMLException.hh"
 
@@ -45,10 +52,12 @@
 #include "Thread.hh"
 #include "Timer.hh"
 
+#include "enumerate.hh"
 #include "narrow.hh"
 #include "ranges.hh"
 #include "serialize.hh"
 #include "stl.hh"
+#include "strCat.hh"
 #include "unreachable.hh"
 #include "build-info.hh"
 
@@ -205,6 +214,28 @@ private:
 	const uint64_t reference;
 };
 
+class EventLatencyInfo final : public InfoTopic
+{
+public:
+	EventLatencyInfo(InfoCommand& openMSXInfoCommand, EventDistributor& eventDistributor);
+	void execute(std::span<const TclObject> tokens,
+	             TclObject& result) const override;
+	[[nodiscard]] string help(std::span<const TclObject> tokens) const override;
+private:
+	EventDistributor& eventDistributor;
+};
+
+class CallbackStatsInfo final : public InfoTopic
+{
+public:
+	CallbackStatsInfo(InfoCommand& openMSXInfoCommand, Reactor& reactor);
+	void execute(std::span<const TclObject> tokens,
+	             TclObject& result) const override;
+	[[nodiscard]] string help(std::span<const TclObject> tokens) const override;
+private:
+	Reactor& reactor;
+};
+
 class SoftwareInfoTopic final : public InfoTopic
 {
 public:
@@ -217,6 +248,32 @@ private:
 };
 
 
+// Collects the messages that are printed while the software database is being
+// loaded in a background thread. Only the main thread may use GlobalCliComm,
+// so these messages are forwarded once the database is picked up.
+class DeferredCliComm final : public CliComm
+{
+public:
+	void log(LogLevel level, std::string_view message, float /*fraction*/) override {
+		messages.emplace_back(level, string(message));
+	}
+	void update(UpdateType /*type*/, std::string_view /*name*/,
+	            std::string_view /*value*/) override {}
+	void updateFiltered(UpdateType /*type*/, std::string_view /*name*/,
+	                    std::string_view /*value*/) override {}
+
+	void forward(CliComm& cliComm) {
+		for (const auto& [level, message] : messages) {
+			cliComm.log(level, message);
+		}
+		messages.clear();
+	}
+
+private:
+	std::vector<std::pair<LogLevel, string>> messages;
+};
+
+
 Reactor::Reactor() = default;
 
 void Reactor::init()
@@ -225,6 +282,7 @@ void Reactor::init()
 	rtScheduler = make_unique<RTScheduler>();
 	eventDistributor = make_unique<EventDistributor>(*this);
 	globalCliComm = make_unique<GlobalCliComm>();
+	asyncFileWriter = make_unique<AsyncFileWriter>(*globalCliComm);
 	globalCommandController = make_unique<GlobalCommandController>(
 		*eventDistributor, *globalCliComm, *this);
 	globalSettings = make_unique<GlobalSettings>(
@@ -275,11 +333,25 @@ void Reactor::init()
 		getOpenMSXInfoCommand(), "machines");
 	realTimeInfo = make_unique<RealTimeInfo>(
 		getOpenMSXInfoCommand());
+	eventLatencyInfo = make_unique<EventLatencyInfo>(
+		getOpenMSXInfoCommand(), *eventDistributor);
+	callbackStatsInfo = make_unique<CallbackStatsInfo>(
+		getOpenMSXInfoCommand(), *this);
 	softwareInfoTopic = make_unique<SoftwareInfoTopic>(
 		getOpenMSXInfoCommand(), *this);
 	tclCallbackMessages = make_unique<TclCallbackMessages>(
 		*globalCliComm, *globalCommandController);
 
+	// Loading the software database is independent of the rest of the
+	// initialization, so do it in parallel. Note: the system file context
+	// (the search paths) has been initialized already (by FilePool), so
+	// it's safe to use it from another thread.
+	softwareDatabaseMessages = make_unique<DeferredCliComm>();
+	softwareDatabaseLoader = std::async(std::launch::async, [&messages = *softwareDatabaseMessages] {
+		StartupTrace::Phase phase("load software database");
+		return make_unique<RomDatabase>(messages);
+	});
+
 	createMachineSetting();
 
 	getGlobalSettings().getPauseSetting().attach(*this);
@@ -315,7 +387,9 @@ Mixer& Reactor::getMixer()
 RomDatabase& Reactor::getSoftwareDatabase()
 {
 	if (!softwareDatabase) {
-		softwareDatabase = make_unique<RomDatabase>(*globalCliComm);
+		assert(softwareDatabaseLoader.valid());
+		softwareDatabase = softwareDatabaseLoader.get();
+		softwareDatabaseMessages->forward(*globalCliComm);
 	}
 	return *softwareDatabase;
 }
@@ -468,6 +542,7 @@ void Reactor::switchMachine(const string& machine)
 	assert(Thread::isMainThread());
 	// Note: loadMachine can throw an exception and in that case the
 	//       motherboard must be considered as not created at all.
+	StartupTrace::Phase phase(tmpStrCat("load machine ", machine));
 	auto newBoard = createEmptyMotherBoard();
 	newBoard->loadMachine(machine);
 	boards.push_back(newBoard);
@@ -539,6 +614,7 @@ void Reactor::runStartupScripts(const CommandLineParser& parser)
 
 	// execute init.tcl
 	try {
+		StartupTrace::Phase phase("init.tcl");
 		commandController.source(
 			preferSystemFileContext().resolve("init.tcl"));
 	} catch (FileException&) {
@@ -547,6 +623,7 @@ void Reactor::runStartupScripts(const CommandLineParser& parser)
 
 	// execute startup scripts
 	for (const auto& s : parser.getStartupScripts()) {
+		StartupTrace::Phase phase(tmpStrCat("script ", s));
 		try {
 			commandController.source(userFileContext().resolve(s));
 		} catch (FileException& e) {
@@ -1114,6 +1191,92 @@ string RealTimeInfo::help(std::span<const TclObject> /*tokens*/) const
 }
 
 
+// class EventLatencyInfo
+
+EventLatencyInfo::EventLatencyInfo(InfoCommand& openMSXInfoCommand,
+                                   EventDistributor& eventDistributor_)
+	: InfoTopic(openMSXInfoCommand, "event_latency")
+	, eventDistributor(eventDistributor_)
+{
+}
+
+void EventLatencyInfo::execute(std::span<const TclObject> /*tokens*/,
+                               TclObject& result) const
+{
+	for (auto [i, count] : enumerate(eventDistributor.getLatencyHistogram())) {
+		if (count == 0) continue;
+		result.addDictKeyValue(i == 0 ? 0 : (1u << i), tmpStrCat(count));
+	}
+}
+
+string EventLatencyInfo::help(std::span<const TclObject> /*tokens*/) const
+{
+	return "Returns a histogram of the time between posting an event (e.g. a "
+	       "key press or a command received over a socket) and delivering it "
+	       "in the main thread. This is a dictionary that maps the lower bound "
+	       "of a bucket (in microseconds) to the number of events in that "
+	       "bucket. Bucket 'n' contains latencies from 'n' up to (but not "
+	       "including) '2*n', empty buckets are omitted.";
+}
+
+
+// class CallbackStatsInfo
+
+CallbackStatsInfo::CallbackStatsInfo(InfoCommand& openMSXInfoCommand,
+                                     Reactor& reactor_)
+	: InfoTopic(openMSXInfoCommand, "callback_stats")
+	, reactor(reactor_)
+{
+}
+
+void CallbackStatsInfo::execute(std::span<const TclObject> /*tokens*/,
+                                TclObject& result) const
+{
+	auto add = [&](std::string_view name, const CallbackStats& stats) {
+		if (stats.getCount() == 0) return;
+		result.addDictKeyValue(name, makeTclDict(
+			"count", tmpStrCat(stats.getCount()),
+			"time", stats.getTotalTime()));
+	};
+	// Several callbacks can belong to the same setting (e.g. 'umr_callback'
+	// is shared by all CheckedRam objects), report their sum.
+	std::vector<std::pair<std::string_view, CallbackStats>> perSetting;
+	for (const auto* callback : TclCallback::getAll()) {
+		auto name = callback->getSetting().getFullName();
+		auto it = ranges::find(perSetting, name, [](const auto& p) { return p.first; });
+		if (it == perSetting.end()) {
+			perSetting.emplace_back(name, CallbackStats{});
+			it = std::prev(perSetting.end());
+		}
+		it->second += callback->getStats();
+	}
+	for (const auto& [name, stats] : perSetting) {
+		add(name, stats);
+	}
+	for (const auto& bp : MSXCPUInterface::getBreakPoints()) {
+		add(tmpStrCat("bp#", bp.getId()), bp.getStats());
+	}
+	for (const auto& cond : MSXCPUInterface::getConditions()) {
+		add(tmpStrCat("cond#", cond.getId()), cond.getStats());
+	}
+	if (auto* motherBoard = reactor.getMotherBoard()) {
+		for (const auto& wp : motherBoard->getCPUInterface().getWatchPoints()) {
+			add(tmpStrCat("wp#", wp->getId()), wp->getStats());
+		}
+	}
+}
+
+string CallbackStatsInfo::help(std::span<const TclObject> /*tokens*/) const
+{
+	return "Returns how often the Tcl callbacks were invoked and how much time "
+	       "(in seconds) that took in total. This is a dictionary that maps "
+	       "the name of a callback setting (summed over all its callbacks) or "
+	       "the id of a breakpoint, watchpoint or condition to a dictionary "
+	       "with keys 'count' and 'time'. For breakpoints this includes evaluating the condition. "
+	       "Callbacks that were never invoked are omitted.";
+}
+
+
 // SoftwareInfoTopic
 
 SoftwareInfoTopic::SoftwareInfoTopic(InfoCommand& openMSXInfoCommand, Reactor& reactor_)
@@ -8,6 +8,7 @@
 #include "view.hh"
 
 #include <cassert>
+#include <future>
 #include <memory>
 #include <mutex>
 #include <string>
@@ -18,18 +19,22 @@ namespace openmsx {
 
 class ActivateMachineCommand;
 class AfterCommand;
+class AsyncFileWriter;
 class AviRecorder;
 class CliComm;
 class CommandController;
 class CommandLineParser;
+class CallbackStatsInfo;
 class ConfigInfo;
 class CreateMachineCommand;
+class DeferredCliComm;
 class DeleteMachineCommand;
 class DiskChanger;
 class DiskFactory;
 class DiskManipulator;
 class Display;
 class EventDistributor;
+class EventLatencyInfo;
 class ExitCommand;
 class FilePool;
 class GetClipboardCommand;
@@ -96,6 +101,7 @@ public:
 	[[nodiscard]] DiskManipulator& getDiskManipulator() { return *diskManipulator; }
 	[[nodiscard]] EnumSetting<int>& getMachineSetting() { return *machineSetting; }
 	[[nodiscard]] FilePool& getFilePool() { return *filePool; }
+	[[nodiscard]] AsyncFileWriter& getAsyncFileWriter() { return *asyncFileWriter; }
 	[[nodiscard]] ImGuiManager& getImGuiManager() { return *imGuiManager; }
 	[[nodiscard]] const HotKey& getHotKey() const;
 	[[nodiscard]] SymbolManager& getSymbolManager() const { return *symbolManager; }
@@ -155,6 +161,7 @@ private:
 	std::unique_ptr<RTScheduler> rtScheduler;
 	std::unique_ptr<EventDistributor> eventDistributor;
 	std::unique_ptr<GlobalCliComm> globalCliComm;
+	std::unique_ptr<AsyncFileWriter> asyncFileWriter; // after globalCliComm, before boards
 	std::unique_ptr<GlobalCommandController> globalCommandController;
 	std::unique_ptr<GlobalSettings> globalSettings;
 	std::unique_ptr<InputEventGenerator> inputEventGenerator;
@@ -169,7 +176,9 @@ private:
 
 	std::unique_ptr<EnumSetting<int>> machineSetting;
 	std::unique_ptr<UserSettings> userSettings;
-	std::unique_ptr<RomDatabase> softwareDatabase; // lazy initialized
+	std::unique_ptr<RomDatabase> softwareDatabase; // loaded in background
+	std::unique_ptr<DeferredCliComm> softwareDatabaseMessages;
+	std::future<std::unique_ptr<RomDatabase>> softwareDatabaseLoader;
 
 	std::unique_ptr<AfterCommand> afterCommand;
 	std::unique_ptr<ExitCommand> exitCommand;
@@ -188,6 +197,8 @@ private:
 	std::unique_ptr<ConfigInfo> extensionInfo;
 	std::unique_ptr<ConfigInfo> machineInfo;
 	std::unique_ptr<RealTimeInfo> realTimeInfo;
+	std::unique_ptr<EventLatencyInfo> eventLatencyInfo;
+	std::unique_ptr<CallbackStatsInfo> callbackStatsInfo;
 	std::unique_ptr<SoftwareInfoTopic> softwareInfoTopic;
 	std::unique_ptr<TclCallbackMessages> tclCallbackMessages;
 
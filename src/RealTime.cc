@@ -7,10 +7,14 @@
 #include "GlobalSettings.hh"
 #include "MSXMotherBoard.hh"
 #include "Reactor.hh"
+#include "TclObject.hh"
 #include "ThrottleManager.hh"
 #include "Timer.hh"
 
+#include "enumerate.hh"
 #include "narrow.hh"
+#include "outer.hh"
+#include "strCat.hh"
 #include "unreachable.hh"
 
 namespace openmsx {
@@ -30,6 +34,7 @@ RealTime::RealTime(
 	, throttleManager(globalSettings.getThrottleManager())
 	, pauseSetting   (globalSettings.getPauseSetting())
 	, powerSetting   (globalSettings.getPowerSetting())
+	, pacingInfo(motherBoard.getMachineInfoCommand())
 {
 	speedManager.attach(*this);
 	throttleManager.attach(*this);
@@ -91,20 +96,13 @@ void RealTime::internalSync(EmuTime::param time, bool allowSleep)
 		        getRealDuration(emuTime, time) * 1000000ULL);
 		idealRealTime += realDuration;
 		auto currentRealTime = Timer::getTime();
-		auto sleep = narrow_cast<int64_t>(idealRealTime - currentRealTime);
+		auto lag = narrow_cast<int64_t>(currentRealTime - idealRealTime);
 		if (allowSleep) {
-			// want to sleep for 'sleep' us
-			sleep += narrow_cast<int64_t>(sleepAdjust);
-			int64_t delta = 0;
-			if (sleep > 0) {
-				Timer::sleep(sleep); // request to sleep for 'sleep+sleepAdjust'
-				auto slept = narrow<int64_t>(Timer::getTime() - currentRealTime);
-				delta = sleep - slept; // actually slept for 'slept' us
-			}
-			const double ALPHA = 0.2;
-			sleepAdjust = sleepAdjust * (1 - ALPHA) + narrow_cast<double>(delta) * ALPHA;
+			// Wait for an absolute deadline, so errors in one sleep
+			// don't accumulate.
+			pacer.waitUntil(idealRealTime);
 		}
-		if (-sleep > MAX_LAG) {
+		if (lag > MAX_LAG) {
 			idealRealTime = currentRealTime - MAX_LAG / 2;
 		}
 	}
@@ -166,7 +164,6 @@ void RealTime::resync()
 	if (!enabled) return;
 
 	idealRealTime = Timer::getTime();
-	sleepAdjust = 0.0;
 	removeSyncPoint();
 	emuTime = getCurrentTime();
 	setSyncPoint(emuTime + getEmuDuration(SYNC_INTERVAL));
@@ -184,4 +181,46 @@ void RealTime::disable()
 	removeSyncPoint();
 }
 
+
+// class RealTime::PacingInfo
+
+RealTime::PacingInfo::PacingInfo(InfoCommand& machineInfoCommand)
+	: InfoTopic(machineInfoCommand, "frame_pacing")
+{
+}
+
+void RealTime::PacingInfo::execute(
+	std::span<const TclObject> /*tokens*/, TclObject& result) const
+{
+	const auto& pacer = OUTER(RealTime, pacingInfo).pacer;
+	TclObject histogram;
+	for (auto [i, n] : enumerate(pacer.getHistogram())) {
+		if (i < FramePacer::BUCKET_BOUNDS.size()) {
+			histogram.addListElement(tmpStrCat(FramePacer::BUCKET_BOUNDS[i]));
+		} else {
+			histogram.addListElement("inf");
+		}
+		histogram.addListElement(tmpStrCat(n));
+	}
+	result.addDictKeyValues("deadlines", tmpStrCat(pacer.getCount()),
+	                        "missed", tmpStrCat(pacer.getMissed()),
+	                        "late", tmpStrCat(pacer.getLate()),
+	                        "max_jitter", tmpStrCat(pacer.getMaxJitter()),
+	                        "spin", tmpStrCat(pacer.getSpin()),
+	                        "histogram", histogram);
+}
+
+std::string RealTime::PacingInfo::help(std::span<const TclObject> /*tokens*/) const
+{
+	return "Returns statistics about synchronizing emulation with real time. "
+	       "'deadlines' is the number of times emulation waited for real "
+	       "time (typically once per frame), 'missed' how many times that "
+	       "continued more than 1ms too late, and 'late' how many times "
+	       "emulation was already behind before waiting. 'max_jitter' is "
+	       "the maximum delay (in us) and 'histogram' lists the number of "
+	       "waits per delay range (the upper bound of the range in us, "
+	       "followed by the count). 'spin' is the time (in us) before a "
+	       "deadline that is spent busy waiting instead of sleeping.\n";
+}
+
 } // namespace openmsx
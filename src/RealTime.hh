@@ -3,6 +3,8 @@
 
 #include "EmuTime.hh"
 #include "EventListener.hh"
+#include "FramePacer.hh"
+#include "InfoTopic.hh"
 #include "Observer.hh"
 #include "Schedulable.hh"
 
@@ -81,9 +83,16 @@ private:
 	BooleanSetting& pauseSetting;
 	BooleanSetting& powerSetting;
 
+	struct PacingInfo final : InfoTopic {
+		explicit PacingInfo(InfoCommand& machineInfoCommand);
+		void execute(std::span<const TclObject> tokens,
+		             TclObject& result) const override;
+		[[nodiscard]] std::string help(std::span<const TclObject> tokens) const override;
+	} pacingInfo;
+
+	FramePacer pacer;
 	uint64_t idealRealTime;
 	EmuTime emuTime = EmuTime::zero();
-	double sleepAdjust;
 	bool enabled = true;
 };
 
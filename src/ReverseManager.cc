@@ -88,7 +88,7 @@ struct Replay
 		} else {
 			assert(Archive::IS_LOADER);
 			assert(!events->empty());
-			currentTime = events->back()->getTime();
+			currentTime = events->back().getTime();
 		}
 
 		if (ar.versionAtLeast(version, 4)) {
@@ -191,7 +191,7 @@ EmuTime::param ReverseManager::getEndTime(const ReverseHistory& hist) const
 {
 	if (!hist.events.empty()) {
 		if (const auto* ev = dynamic_cast<const EndLogEvent*>(
-				hist.events.back().get())) {
+				&hist.events.back())) {
 			// last log element is EndLogEvent, use that
 			return ev->getTime();
 		}
@@ -237,11 +237,11 @@ void ReverseManager::status(TclObject& result) const
 	}));
 	result.addDictKeyValue("snapshots", snapshots);
 
-	auto lastEvent = rbegin(history.events);
-	if (lastEvent != rend(history.events) && dynamic_cast<const EndLogEvent*>(lastEvent->get())) {
-		++lastEvent;
+	auto numEvents = history.events.size();
+	if (numEvents && dynamic_cast<const EndLogEvent*>(&history.events.back())) {
+		--numEvents;
 	}
-	EmuTime le(isCollecting() && (lastEvent != rend(history.events)) ? (*lastEvent)->getTime() : EmuTime::zero());
+	EmuTime le(isCollecting() && numEvents ? history.events[numEvents - 1].getTime() : EmuTime::zero());
 	result.addDictKeyValue("last_event", (le - EmuTime::zero()).toDouble());
 }
 
@@ -259,7 +259,9 @@ void ReverseManager::debugInfo(TclObject& result) const
 		          " (next event index: ", chunk.eventCount, ")\n");
 		totalSize += chunk.savestate.size();
 	}
-	strAppend(res, "total size: ", totalSize, '\n');
+	strAppend(res, "total size: ", totalSize, '\n',
+	          "events: ", history.events.size(),
+	          " (", history.events.getMemoryUsage(), " bytes)\n");
 	result = res;
 }
 
@@ -417,9 +419,8 @@ void ReverseManager::goTo(
 
 			// terminate replay log with EndLogEvent (if not there already)
 			if (hist.events.empty() ||
-			    !dynamic_cast<const EndLogEvent*>(hist.events.back().get())) {
-				hist.events.push_back(
-					std::make_unique<EndLogEvent>(currentTime));
+			    !dynamic_cast<const EndLogEvent*>(&hist.events.back())) {
+				hist.events.emplace_back<EndLogEvent>(currentTime);
 			}
 
 			// Transfer history to the new ReverseManager.
@@ -616,11 +617,10 @@ void ReverseManager::saveReplay(
 
 	// add sentinel when there isn't one yet
 	bool addSentinel = history.events.empty() ||
-		!dynamic_cast<EndLogEvent*>(history.events.back().get());
+		!dynamic_cast<EndLogEvent*>(&history.events.back());
 	if (addSentinel) {
 		/// make sure the replay log ends with a EndLogEvent
-		history.events.push_back(std::make_unique<EndLogEvent>(
-			getCurrentTime()));
+		history.events.emplace_back<EndLogEvent>(getCurrentTime());
 	}
 	try {
 		XmlOutputArchive out(filename);
@@ -738,7 +738,7 @@ void ReverseManager::loadReplay(
 		// update replayIdx
 		// TODO: should we use <= instead??
 		while (replayIdx < newEvents.size() &&
-		       (newEvents[replayIdx]->getTime() < newChunk.time)) {
+		       (newEvents[replayIdx].getTime() < newChunk.time)) {
 			replayIdx++;
 		}
 		newChunk.eventCount = replayIdx;
@@ -814,7 +814,7 @@ void ReverseManager::execNewSnapshot()
 
 void ReverseManager::execInputEvent()
 {
-	const auto& event = *history.events[replayIndex];
+	const auto& event = history.events[replayIndex];
 	try {
 		// deliver current event at current time
 		motherBoard.getStateChangeDistributor().distributeReplay(event);
@@ -884,7 +884,7 @@ void ReverseManager::replayNextEvent()
 {
 	// schedule next event at its own time
 	assert(replayIndex < history.events.size());
-	syncInputEvent.setSyncPoint(history.events[replayIndex]->getTime());
+	syncInputEvent.setSyncPoint(history.events[replayIndex].getTime());
 }
 
 void ReverseManager::signalStopReplay(EmuTime::param time)
@@ -900,8 +900,7 @@ void ReverseManager::stopReplay(EmuTime::param time) noexcept
 	if (isReplaying()) {
 		// if we're replaying, stop it and erase remainder of event log
 		syncInputEvent.removeSyncPoint();
-		Events& events = history.events;
-		events.erase(begin(events) + replayIndex, end(events));
+		history.events.truncate(replayIndex);
 		// search snapshots that are newer than 'time' and erase them
 		auto it = ranges::find_if(history.chunks, [&](auto& p) {
 			return p.second.time > time;
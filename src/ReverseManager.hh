@@ -7,12 +7,12 @@
 #include "EmuTime.hh"
 
 #include "MemBuffer.hh"
+#include "PolymorphicLog.hh"
 #include "DeltaBlock.hh"
 #include "outer.hh"
 #include "view.hh"
 
 #include <cstdint>
-#include <deque>
 #include <span>
 #include <map>
 #include <memory>
@@ -58,8 +58,7 @@ public:
 	StateChange& record(EmuTime::param time, Args&& ...args) {
 		assert(!isReplaying());
 		++replayIndex;
-		history.events.push_back(std::make_unique<T>(time, std::forward<Args>(args)...));
-		return *history.events.back();
+		return history.events.emplace_back<T>(time, std::forward<Args>(args)...);
 	}
 
 	[[nodiscard]] bool isCollecting() const { return collecting; }
@@ -85,7 +84,9 @@ private:
 		unsigned eventCount;
 	};
 	using Chunks = std::map<unsigned, ReverseChunk>;
-	using Events = std::deque<std::unique_ptr<StateChange>>;
+	// Events are allocated in large blocks (instead of one heap allocation
+	// per event), this matters for long recordings with many input events.
+	using Events = PolymorphicLog<StateChange>;
 
 	struct ReverseHistory {
 		void swap(ReverseHistory& other) noexcept;
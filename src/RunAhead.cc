@@ -0,0 +1,243 @@
+#include "RunAhead.hh"
+
+#include "DeltaBlock.hh"
+#include "Display.hh"
+#include "Event.hh"
+#include "EventDistributor.hh"
+#include "InputLatency.hh"
+#include "MSXCliComm.hh"
+#include "MSXCommandController.hh"
+#include "MSXEventDistributor.hh"
+#include "MSXException.hh"
+#include "MSXMixer.hh"
+#include "MSXMotherBoard.hh"
+#include "Reactor.hh"
+#include "TclObject.hh"
+#include "Timer.hh"
+#include "VDP.hh"
+#include "serialize.hh"
+
+#include "one_of.hh"
+#include "outer.hh"
+
+#include <algorithm>
+
+namespace openmsx {
+
+// The step is done this many VDP ticks (2 lines) before the start of a frame.
+// Also the shadow machine switches between fast-forward and normal speed this
+// much before the start of a frame, so that frame gets rendered completely.
+static constexpr int MARGIN_TICKS = 2 * VDP::TICKS_PER_LINE;
+
+// When on average a step takes more than this fraction of a frame period, for
+// this many steps in a row, the number of run-ahead frames is reduced.
+static constexpr double MAX_FRAME_FRACTION = 0.8;
+static constexpr unsigned MAX_OVER_BUDGET = 50;
+
+RunAhead::RunAhead(MSXMotherBoard& motherBoard_)
+	: Schedulable(motherBoard_.getScheduler())
+	, motherBoard(motherBoard_)
+	, framesSetting(motherBoard.getCommandController(), "run_ahead",
+		"number of frames to run ahead to reduce input latency "
+		"(0 = disabled), this needs a lot of extra CPU time: each "
+		"frame a complete copy of the machine is rebuilt (this also "
+		"re-reads its ROMs and configuration files)",
+		0, 0, MAX_FRAMES)
+	, info(motherBoard.getMachineInfoCommand())
+{
+	framesSetting.attach(*this);
+	motherBoard.getMSXEventDistributor().registerEventListener(*this);
+}
+
+RunAhead::~RunAhead()
+{
+	motherBoard.getMSXEventDistributor().unregisterEventListener(*this);
+	framesSetting.detach(*this);
+}
+
+VDP* RunAhead::findVDP() const
+{
+	return dynamic_cast<VDP*>(motherBoard.findDevice("VDP"));
+}
+
+void RunAhead::updateState()
+{
+	// The shadow machine itself never runs ahead.
+	if (motherBoard.isShadow()) return;
+
+	// Note: the video output is (un)hidden independent of whether this
+	// machine is active, so that (de)activating doesn't change it.
+	bool enabled = getFrames() > 0;
+	motherBoard.setVideoHidden(enabled);
+	if (enabled && motherBoard.isActive()) {
+		if (!pendingSyncPoint()) schedule();
+	} else {
+		removeSyncPoint();
+		stepPending = false;
+		shadow.reset();
+		overBudget = 0;
+	}
+}
+
+void RunAhead::schedule()
+{
+	auto* vdp = findVDP();
+	if (!vdp) return; // nothing to show
+	auto frame = VDP::VDPClock::duration(vdp->getTicksPerFrame());
+	auto margin = VDP::VDPClock::duration(MARGIN_TICKS);
+	auto now = getCurrentTime();
+	auto next = vdp->getFrameStartTime() + frame - margin;
+	while (next <= now) next += frame;
+	setSyncPoint(next);
+}
+
+void RunAhead::executeUntil(EmuTime::param /*time*/)
+{
+	if (motherBoard.isFastForwarding()) {
+		// nothing is shown anyway
+		schedule();
+		return;
+	}
+	// Creating and running another machine can't be done from within the
+	// CPU loop.
+	stepPending = true;
+	motherBoard.exitCPULoopSync();
+}
+
+void RunAhead::execute()
+{
+	if (!stepPending) return;
+	stepPending = false;
+
+	auto* vdp = findVDP();
+	if (!vdp) return;
+	try {
+		step(*vdp);
+	} catch (MSXException& e) {
+		motherBoard.getMSXCliComm().printWarning(
+			"Run-ahead failed, disabling it: ", e.getMessage());
+		framesSetting.setInt(0);
+		return;
+	}
+	if (getFrames() > 0 && !pendingSyncPoint()) schedule();
+}
+
+void RunAhead::step(VDP& vdp)
+{
+	auto start = Timer::getTime();
+
+	auto frame = VDP::VDPClock::duration(vdp.getTicksPerFrame());
+	auto margin = VDP::VDPClock::duration(MARGIN_TICKS);
+	auto now = getCurrentTime();
+	// start of the frame that's about to begin
+	auto frameStart = vdp.getFrameStartTime() + frame;
+	while (frameStart < now) frameStart += frame;
+
+	// Without run-ahead, at this point the previous frame would be shown.
+	// So with N frames run-ahead we must show the frame N-1 frames after
+	// the one that's about to begin. In deinterlace mode a frame is only
+	// painted when its predecessor was rendered too, so then render (at
+	// least) two frames.
+	auto ahead = unsigned(getFrames() - 1);
+	bool interlaced = vdp.isInterlaced();
+	if (interlaced) ahead = std::max(ahead, 1u);
+	auto renderStart = frameStart + frame * ahead;
+	auto renderFrom = interlaced ? renderStart - frame : renderStart;
+
+	// Copy the state of this machine into a new shadow machine. The delta
+	// blocks are only used during this step, so they're never diffs.
+	LastDeltaBlocks lastDeltaBlocks;
+	std::vector<std::shared_ptr<DeltaBlock>> deltaBlocks;
+	MemOutputArchive out(lastDeltaBlocks, deltaBlocks, false);
+	out.serialize("machine", motherBoard);
+	auto savestate = std::move(out).releaseBuffer();
+
+	auto newShadow = std::make_shared<MSXMotherBoard>(motherBoard.getReactor(), true);
+	MemInputArchive in(savestate, deltaBlocks);
+	in.serialize("machine", *newShadow);
+	newShadow->getMSXCommandController().transferSettings(
+		motherBoard.getMSXCommandController());
+	// sound only comes from the real machine
+	newShadow->getMSXMixer().mute();
+
+	newShadow->fastForward(renderFrom - margin, true);
+	newShadow->fastForward(renderStart + frame + margin, false);
+
+	// This also removes the video layer of the previous shadow machine.
+	shadow = std::move(newShadow);
+	// The shown frame reflects all input this machine has read so far.
+	auto& inputLatency = motherBoard.getInputLatency();
+	inputLatency.frameRendered(now);
+	auto& reactor = motherBoard.getReactor();
+	reactor.getDisplay().repaint();
+	inputLatency.framePainted();
+	reactor.getEventDistributor().distributeEvent(FrameDrawnEvent());
+
+	// statistics
+	++steps;
+	lastCost = double(Timer::getTime() - start);
+	maxCost = std::max(maxCost, lastCost);
+	const double ALPHA = 0.1;
+	avgCost = (steps == 1) ? lastCost
+	                       : (avgCost * (1.0 - ALPHA) + lastCost * ALPHA);
+
+	if (avgCost > MAX_FRAME_FRACTION * frame.toDouble() * 1e6) {
+		if (++overBudget == MAX_OVER_BUDGET) {
+			overBudget = 0;
+			++reductions;
+			int frames = getFrames() - 1;
+			motherBoard.getMSXCliComm().printWarning(
+				"Run-ahead takes too much time, reducing it to ",
+				frames, " frame(s).");
+			framesSetting.setInt(frames);
+		}
+	} else {
+		overBudget = 0;
+	}
+}
+
+void RunAhead::update(const Setting& /*setting*/) noexcept
+{
+	updateState();
+}
+
+void RunAhead::signalMSXEvent(const Event& event,
+                              EmuTime::param /*time*/) noexcept
+{
+	if (getType(event) == one_of(EventType::MACHINE_ACTIVATED,
+	                             EventType::MACHINE_DEACTIVATED)) {
+		updateState();
+	}
+}
+
+
+// class RunAhead::Info
+
+RunAhead::Info::Info(InfoCommand& machineInfoCommand)
+	: InfoTopic(machineInfoCommand, "run_ahead")
+{
+}
+
+void RunAhead::Info::execute(
+	std::span<const TclObject> /*tokens*/, TclObject& result) const
+{
+	const auto& ra = OUTER(RunAhead, info);
+	result.addDictKeyValues("frames", ra.getFrames(),
+	                        "steps", ra.steps,
+	                        "last_cost", ra.lastCost,
+	                        "avg_cost", ra.avgCost,
+	                        "max_cost", ra.maxCost,
+	                        "reductions", ra.reductions);
+}
+
+std::string RunAhead::Info::help(std::span<const TclObject> /*tokens*/) const
+{
+	return "Returns statistics about run-ahead: the current number of "
+	       "frames ('frames'), the number of run-ahead steps ('steps'), "
+	       "the time (in microseconds) the last step took, the average "
+	       "and the maximum ('last_cost', 'avg_cost', 'max_cost') and how "
+	       "many times the number of frames was automatically reduced "
+	       "because it took too much time ('reductions').\n";
+}
+
+} // namespace openmsx
@@ -0,0 +1,86 @@
+#ifndef RUNAHEAD_HH
+#define RUNAHEAD_HH
+
+#include "IntegerSetting.hh"
+#include "InfoTopic.hh"
+#include "MSXEventListener.hh"
+#include "Observer.hh"
+#include "Schedulable.hh"
+
+#include <memory>
+
+namespace openmsx {
+
+class MSXMotherBoard;
+class VDP;
+
+/** Run-ahead: reduce the latency between input and the displayed picture.
+  *
+  * Many MSX programs only react to input one or more frames after it was
+  * read. When run-ahead is enabled (setting 'run_ahead' is the number of
+  * frames), the picture of the real machine is hidden. Instead, once per
+  * frame, the state of the real machine is copied into a 'shadow' machine,
+  * that machine is run N frames ahead (the first N-1 frames in fast-forward
+  * mode), and its last frame is shown. Sound and all other side effects
+  * only come from the real machine.
+  *
+  * openMSX can't load a state into an existing machine, so the shadow
+  * machine is rebuilt every frame. The cost per frame is measured; when it
+  * doesn't fit in a frame period, the number of frames is reduced.
+  */
+class RunAhead final : private Schedulable, private Observer<Setting>
+                     , private MSXEventListener
+{
+public:
+	static constexpr int MAX_FRAMES = 8;
+
+	explicit RunAhead(MSXMotherBoard& motherBoard);
+	~RunAhead();
+
+	/** Called by MSXMotherBoard::execute() after the CPU loop was exited,
+	  * does the actual run-ahead step (if one is pending). */
+	void execute();
+
+	[[nodiscard]] int getFrames() const { return framesSetting.getInt(); }
+
+private:
+	void updateState();
+	void schedule();
+	void step(VDP& vdp);
+	[[nodiscard]] VDP* findVDP() const;
+
+	// Schedulable
+	void executeUntil(EmuTime::param time) override;
+	// Observer<Setting>
+	void update(const Setting& setting) noexcept override;
+	// MSXEventListener
+	void signalMSXEvent(const Event& event,
+	                    EmuTime::param time) noexcept override;
+
+private:
+	MSXMotherBoard& motherBoard;
+	IntegerSetting framesSetting;
+
+	struct Info final : InfoTopic {
+		explicit Info(InfoCommand& machineInfoCommand);
+		void execute(std::span<const TclObject> tokens,
+		             TclObject& result) const override;
+		[[nodiscard]] std::string help(std::span<const TclObject> tokens) const override;
+	} info;
+
+	std::shared_ptr<MSXMotherBoard> shadow;
+
+	// statistics, all costs are in microseconds
+	unsigned steps = 0;
+	double lastCost = 0.0;
+	double avgCost = 0.0;
+	double maxCost = 0.0;
+	unsigned overBudget = 0; // number of consecutive steps that were too slow
+	unsigned reductions = 0;
+
+	bool stepPending = false;
+};
+
+} // namespace openmsx
+
+#endif
@@ -35,16 +35,21 @@ void Scheduler::setSyncPoint(EmuTime::param time, Schedulable& device)
 	assert(time >= scheduleTime);
 
 	// Push sync point into queue.
+	EmuTime oldNext = getNext();
 	queue.insert(SynchronizationPoint(time, &device),
 	             [](SynchronizationPoint& sp) { sp.setTime(EmuTime::infinity()); },
 	             [](const SynchronizationPoint& x, const SynchronizationPoint& y) {
 	                     return x.getTime() < y.getTime(); });
 
-	if (!scheduleInProgress && cpu) {
+	// The CPU limit is never later than the (old) first sync point, so it
+	// only needs to be updated when the new sync point comes before that.
+	// Many devices (re)schedule sync points far in the future, this avoids
+	// recalculating the limit for those.
+	if (!scheduleInProgress && cpu && (time < oldNext)) {
 		// only when scheduleHelper() is not being executed
 		// otherwise getNext() doesn't return the correct time and
 		// scheduleHelper() anyway calls setNextSyncPoint() at the end
-		cpu->setNextSyncPoint(getNext());
+		cpu->setNextSyncPoint(time);
 	}
 }
 
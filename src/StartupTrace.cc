@@ -0,0 +1,147 @@
+#include "StartupTrace.hh"
+
+#include "FileOperations.hh"
+#include "Timer.hh"
+
+#include "one_of.hh"
+#include "ranges.hh"
+#include "strCat.hh"
+#include "xrange.hh"
+
+#include <atomic>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace openmsx::StartupTrace {
+
+namespace {
+
+struct TraceEvent {
+	std::string name;
+	uint64_t start; // us, relative to 'reference'
+	uint64_t duration; // only used for phases
+	unsigned tid;
+	bool instant;
+};
+
+struct State {
+	std::mutex mutex;
+	std::vector<TraceEvent> events;
+	std::vector<std::thread::id> threads; // index (+1) is the 'tid' in the trace
+	std::string filename;
+	uint64_t reference = 0;
+	std::atomic<bool> enabled = false;
+};
+
+} // namespace
+
+[[nodiscard]] static State& getState()
+{
+	static State state;
+	return state;
+}
+
+void init()
+{
+	auto& state = getState();
+	state.reference = Timer::getTime();
+	if (const char* value = getenv("OPENMSX_STARTUP_TRACE"); value && *value) {
+		state.filename = value;
+		state.enabled = true;
+	}
+}
+
+bool isEnabled()
+{
+	return getState().enabled.load(std::memory_order_relaxed);
+}
+
+// Must be called with the mutex locked.
+[[nodiscard]] static unsigned getThreadId(State& state)
+{
+	auto id = std::this_thread::get_id();
+	auto it = ranges::find(state.threads, id);
+	if (it == end(state.threads)) {
+		state.threads.push_back(id);
+		return unsigned(state.threads.size());
+	}
+	return unsigned(std::distance(begin(state.threads), it) + 1);
+}
+
+static void record(std::string_view name, uint64_t start, uint64_t duration, bool instant)
+{
+	auto& state = getState();
+	std::scoped_lock lock(state.mutex);
+	if (!state.enabled) return; // already written
+	state.events.push_back(TraceEvent{
+		std::string(name), start - state.reference, duration,
+		getThreadId(state), instant});
+}
+
+static void appendJsonString(std::string& out, std::string_view str)
+{
+	out += '"';
+	for (char c : str) {
+		if (c == one_of('"', '\\')) out += '\\';
+		if (static_cast<unsigned char>(c) < 0x20) c = ' ';
+		out += c;
+	}
+	out += '"';
+}
+
+void finish(std::string_view milestone)
+{
+	if (!isEnabled()) return;
+	record(milestone, Timer::getTime(), 0, true);
+
+	auto& state = getState();
+	std::scoped_lock lock(state.mutex);
+	if (!state.enabled) return; // another thread was first
+	state.enabled = false;
+
+	std::string json = "{\"traceEvents\":[\n";
+	for (const auto& e : state.events) {
+		json += "{\"name\":";
+		appendJsonString(json, e.name);
+		strAppend(json, ",\"cat\":\"startup\",\"pid\":1,\"tid\":", e.tid,
+		          ",\"ts\":", e.start);
+		if (e.instant) {
+			json += ",\"ph\":\"i\",\"s\":\"g\"},\n";
+		} else {
+			strAppend(json, ",\"ph\":\"X\",\"dur\":", e.duration, "},\n");
+		}
+	}
+	for (auto tid : xrange(state.threads.size())) {
+		strAppend(json, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":", tid + 1,
+		          ",\"args\":{\"name\":\"", (tid == 0 ? "main" : "worker"), "\"}},\n");
+	}
+	json += "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"openMSX\"}}\n]}\n";
+
+	std::ofstream file;
+	FileOperations::openOfStream(file, state.filename);
+	file << json;
+	if (!file) {
+		std::cerr << "Couldn't write startup trace: " << state.filename << '\n';
+	}
+	state.events.clear();
+}
+
+Phase::Phase(std::string_view name_)
+{
+	if (!isEnabled()) return;
+	name = name_;
+	start = Timer::getTime();
+}
+
+Phase::~Phase()
+{
+	if (name.empty()) return;
+	auto stop = Timer::getTime();
+	record(name, start, stop - start, false);
+}
+
+} // namespace openmsx::StartupTrace
@@ -0,0 +1,55 @@
+#ifndef STARTUPTRACE_HH
+#define STARTUPTRACE_HH
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+/** Measure the duration of the different phases of the openMSX startup.
+  *
+  * Tracing is enabled by setting the environment variable
+  * OPENMSX_STARTUP_TRACE to the name of an output file. When the first
+  * emulated frame is displayed, the collected phases are written to that
+  * file in the Chrome trace-event JSON format (load it in e.g.
+  * chrome://tracing or https://ui.perfetto.dev). Phases that run in
+  * background threads are shown on separate tracks.
+  *
+  * When tracing is disabled, all of this has (almost) no overhead.
+  */
+namespace openmsx::StartupTrace {
+
+	/** Should be called once, as early as possible in main(). All
+	  * timestamps are relative to this moment.
+	  */
+	void init();
+
+	[[nodiscard]] bool isEnabled();
+
+	/** Record a milestone (a 'instant' event in the trace), mark the end
+	  * of the startup and write the trace file. Only the first call has
+	  * any effect.
+	  */
+	void finish(std::string_view milestone);
+
+	/** Record the duration of a startup phase (RAII style). This may be
+	  * used from any thread.
+	  */
+	class Phase
+	{
+	public:
+		explicit Phase(std::string_view name);
+		~Phase();
+
+		Phase(const Phase&) = delete;
+		Phase(Phase&&) = delete;
+		Phase& operator=(const Phase&) = delete;
+		Phase& operator=(Phase&&) = delete;
+
+	private:
+		std::string name; // empty when tracing is disabled
+		uint64_t start = 0;
+	};
+
+} // namespace openmsx::StartupTrace
+
+#endif
@@ -0,0 +1,58 @@
+#ifndef CALLBACKSTATS_HH
+#define CALLBACKSTATS_HH
+
+#include <chrono>
+#include <cstdint>
+
+namespace openmsx {
+
+/** Counts how often a Tcl callback (e.g. of a callback setting or of a
+  * breakpoint) was invoked and how much (real) time those invocations took
+  * in total.
+  */
+class CallbackStats
+{
+	using clock = std::chrono::steady_clock;
+
+public:
+	/** Measures one invocation: from construction till destruction. */
+	class Measure
+	{
+	public:
+		explicit Measure(CallbackStats& stats_)
+			: stats(stats_), start(clock::now()) {}
+		~Measure() {
+			++stats.count;
+			stats.totalTime += clock::now() - start;
+		}
+		Measure(const Measure&) = delete;
+		Measure(Measure&&) = delete;
+		Measure& operator=(const Measure&) = delete;
+		Measure& operator=(Measure&&) = delete;
+
+	private:
+		CallbackStats& stats;
+		clock::time_point start;
+	};
+
+	/** Accumulate, e.g. the stats of several callbacks of the same setting. */
+	CallbackStats& operator+=(const CallbackStats& other) {
+		count += other.count;
+		totalTime += other.totalTime;
+		return *this;
+	}
+
+	[[nodiscard]] uint64_t getCount() const { return count; }
+	/** Total time in seconds. */
+	[[nodiscard]] double getTotalTime() const {
+		return std::chrono::duration<double>(totalTime).count();
+	}
+
+private:
+	uint64_t count = 0;
+	clock::duration totalTime{};
+};
+
+} // namespace openmsx
+
+#endif
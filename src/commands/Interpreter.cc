@@ -225,6 +225,15 @@ TclObject Interpreter::execute(zstring_view command)
 	return TclObject(Tcl_GetObjResult(interp));
 }
 
+TclObject Interpreter::execute(std::span<const TclObject> words)
+{
+	if (Tcl_EvalObjv(interp, narrow<int>(words.size()),
+	                 std::bit_cast<Tcl_Obj* const*>(words.data()), 0) != TCL_OK) {
+		throw CommandException(Tcl_GetStringResult(interp));
+	}
+	return TclObject(Tcl_GetObjResult(interp));
+}
+
 TclObject Interpreter::executeFile(zstring_view filename)
 {
 	if (Tcl_EvalFile(interp, filename.c_str()) != TCL_OK) {
@@ -34,6 +34,11 @@ public:
 	[[nodiscard]] TclObject getCommandNames();
 	[[nodiscard]] bool isComplete(zstring_view command) const;
 	TclObject execute(zstring_view command);
+	/** Execute a command that is already split in words. This avoids
+	  * building (and parsing) a string or list. When the first word is a
+	  * long-lived object, Tcl caches the command lookup in it.
+	  */
+	TclObject execute(std::span<const TclObject> words);
 	TclObject executeFile(zstring_view filename);
 
 	void setVariable(const TclObject& name, const TclObject& value);
@@ -3,8 +3,11 @@
 #include "CliComm.hh"
 #include "CommandException.hh"
 #include "GlobalCommandController.hh"
+#include "Interpreter.hh"
 #include "Reactor.hh"
 #include "checked_cast.hh"
+#include "stl.hh"
+#include <array>
 #include <iostream>
 #include <memory>
 
@@ -23,12 +26,19 @@ TclCallback::TclCallback(
 	, callbackSetting(*callbackSetting2)
 	, isMessageCallback(isMessageCallback_)
 {
+	allCallbacks.push_back(this);
 }
 
 TclCallback::TclCallback(StringSetting& setting)
 	: callbackSetting(setting)
 	, isMessageCallback(false)
 {
+	allCallbacks.push_back(this);
+}
+
+TclCallback::~TclCallback()
+{
+	move_pop_back(allCallbacks, rfind_unguarded(allCallbacks, this));
 }
 
 TclObject TclCallback::getValue() const
@@ -36,13 +46,17 @@ TclObject TclCallback::getValue() const
 	return getSetting().getValue();
 }
 
+// Note: the words are passed directly to the interpreter (no list is built).
+// The first word is the value of the setting, so Tcl can cache the command
+// lookup in that object for as long as the setting doesn't change.
+
 TclObject TclCallback::execute() const
 {
 	const auto& callback = getValue();
 	if (callback.empty()) return {};
 
-	auto command = makeTclList(callback);
-	return executeCommon(command);
+	std::array words = {callback};
+	return executeCommon(words);
 }
 
 TclObject TclCallback::execute(int arg1) const
@@ -50,8 +64,8 @@ TclObject TclCallback::execute(int arg1) const
 	const auto& callback = getValue();
 	if (callback.empty()) return {};
 
-	auto command = makeTclList(callback, arg1);
-	return executeCommon(command);
+	std::array words = {callback, TclObject(arg1)};
+	return executeCommon(words);
 }
 
 TclObject TclCallback::execute(int arg1, int arg2) const
@@ -59,8 +73,8 @@ TclObject TclCallback::execute(int arg1, int arg2) const
 	const auto& callback = getValue();
 	if (callback.empty()) return {};
 
-	auto command = makeTclList(callback, arg1, arg2);
-	return executeCommon(command);
+	std::array words = {callback, TclObject(arg1), TclObject(arg2)};
+	return executeCommon(words);
 }
 
 TclObject TclCallback::execute(int arg1, std::string_view arg2) const
@@ -68,8 +82,8 @@ TclObject TclCallback::execute(int arg1, std::string_view arg2) const
 	const auto& callback = getValue();
 	if (callback.empty()) return {};
 
-	auto command = makeTclList(callback, arg1, arg2);
-	return executeCommon(command);
+	std::array words = {callback, TclObject(arg1), TclObject(arg2)};
+	return executeCommon(words);
 }
 
 TclObject TclCallback::execute(std::string_view arg1, std::string_view arg2) const
@@ -77,14 +91,15 @@ TclObject TclCallback::execute(std::string_view arg1, std::string_view arg2) con
 	const auto& callback = getValue();
 	if (callback.empty()) return {};
 
-	auto command = makeTclList(callback, arg1, arg2);
-	return executeCommon(command);
+	std::array words = {callback, TclObject(arg1), TclObject(arg2)};
+	return executeCommon(words);
 }
 
-TclObject TclCallback::executeCommon(TclObject& command) const
+TclObject TclCallback::executeCommon(std::span<const TclObject> words) const
 {
 	try {
-		return command.executeCommand(callbackSetting.getInterpreter());
+		CallbackStats::Measure measure(stats);
+		return callbackSetting.getInterpreter().execute(words);
 	} catch (CommandException& e) {
 		auto message = strCat(
 			"Error executing callback function \"",
@@ -99,6 +114,8 @@ TclObject TclCallback::executeCommon(TclObject& command) const
 				// This is a message callback that cannot be
 				// executed yet.
 				// Let the caller deal with this.
+				TclObject command;
+				command.addListElements(words);
 				throw command;
 			}
 		}
@@ -1,11 +1,14 @@
 #ifndef TCLCALLBACK_HH
 #define TCLCALLBACK_HH
 
+#include "CallbackStats.hh"
 #include "static_string_view.hh"
 #include "StringSetting.hh"
 #include "TclObject.hh"
 #include <optional>
+#include <span>
 #include <string_view>
+#include <vector>
 
 namespace openmsx {
 
@@ -23,6 +26,11 @@ public:
 	            Setting::Save saveSetting,
 	            bool isMessageCallback = false);
 	explicit TclCallback(StringSetting& setting);
+	TclCallback(const TclCallback&) = delete;
+	TclCallback(TclCallback&&) = delete;
+	TclCallback& operator=(const TclCallback&) = delete;
+	TclCallback& operator=(TclCallback&&) = delete;
+	~TclCallback();
 
 	TclObject execute() const;
 	TclObject execute(int arg1) const;
@@ -32,13 +40,20 @@ public:
 
 	[[nodiscard]] TclObject getValue() const;
 	[[nodiscard]] StringSetting& getSetting() const { return callbackSetting; }
+	[[nodiscard]] const CallbackStats& getStats() const { return stats; }
+
+	/** All currently existing callbacks (e.g. to query their statistics). */
+	[[nodiscard]] static std::span<const TclCallback* const> getAll() { return allCallbacks; }
 
 private:
-	TclObject executeCommon(TclObject& command) const;
+	TclObject executeCommon(std::span<const TclObject> words) const;
 
 	std::optional<StringSetting> callbackSetting2;
 	StringSetting& callbackSetting;
 	const bool isMessageCallback;
+	mutable CallbackStats stats;
+
+	static inline std::vector<const TclCallback*> allCallbacks;
 };
 
 } // namespace openmsx
@@ -7,13 +7,17 @@
 #include "FileOperations.hh"
 #include "MSXCPUInterface.hh"
 #include "MSXMotherBoard.hh"
+#include "StartupTrace.hh"
 #include "TclArgParser.hh"
 #include "XMLException.hh"
 #include "serialize.hh"
 #include "serialize_stl.hh"
 
+#include "hash_map.hh"
+#include "narrow.hh"
 #include "unreachable.hh"
 #include "xrange.hh"
+#include "xxhash.hh"
 
 #include <array>
 #include <cassert>
@@ -237,15 +241,64 @@ const XMLElement& HardwareConfig::getDevicesElem() const
 	return getConfig().getChild("devices");
 }
 
+namespace {
+struct ConfigCache {
+	struct Entry {
+		time_t modificationTime;
+		size_t fileSize;
+		std::shared_ptr<const XMLDocument> doc;
+	};
+	hash_map<std::string, Entry, XXHasher> entries;
+	HardwareConfig::ConfigCacheStats stats;
+};
+}
+
+[[nodiscard]] static ConfigCache& getConfigCache()
+{
+	static ConfigCache cache;
+	return cache;
+}
+
+HardwareConfig::ConfigCacheStats HardwareConfig::getConfigCacheStats()
+{
+	const auto& cache = getConfigCache();
+	auto result = cache.stats;
+	result.entries = narrow<unsigned>(cache.entries.size());
+	return result;
+}
+
 static void loadHelper(XMLDocument& doc, const std::string& filename)
 {
+	StartupTrace::Phase phase(tmpStrCat("load config ", filename));
+
+	// The cache is keyed on filename, but a cached document is only used
+	// when the file wasn't modified since it was parsed.
+	auto& cache = getConfigCache();
+	auto st = FileOperations::getStat(filename);
+	if (st) {
+		if (auto* entry = lookup(cache.entries, filename);
+		    entry && (entry->modificationTime == FileOperations::getModificationDate(*st)) &&
+		    (entry->fileSize == size_t(st->st_size))) {
+			++cache.stats.hits;
+			doc.load(entry->doc);
+			return;
+		}
+	}
+
+	auto parsed = std::make_shared<XMLDocument>(8192); // tweak: initial allocator buffer size
 	try {
-		doc.load(filename, "msxconfig2.dtd");
+		parsed->load(filename, "msxconfig2.dtd");
 	} catch (XMLException& e) {
 		throw MSXException(
 			"Loading of hardware configuration failed: ",
 			e.getMessage());
 	}
+	++cache.stats.misses;
+	if (st) {
+		cache.entries.insert_or_assign(filename, ConfigCache::Entry{
+			FileOperations::getModificationDate(*st), size_t(st->st_size), parsed});
+	}
+	doc.load(std::move(parsed));
 }
 
 static std::string getFilename(std::string_view type, std::string_view name)
@@ -31,6 +31,17 @@ public:
 
 	static void loadConfig(XMLDocument& doc, std::string_view type, std::string_view name);
 
+	/** Parsed machine and extension configuration files are cached (for
+	  * the whole process), so that e.g. repeatedly creating the same
+	  * machine doesn't need to re-read and re-parse the XML files.
+	  */
+	struct ConfigCacheStats {
+		unsigned hits = 0;
+		unsigned misses = 0;
+		unsigned entries = 0;
+	};
+	[[nodiscard]] static ConfigCacheStats getConfigCacheStats();
+
 	[[nodiscard]] static std::unique_ptr<HardwareConfig> createMachineConfig(
 		MSXMotherBoard& motherBoard, std::string machineName);
 	[[nodiscard]] static std::unique_ptr<HardwareConfig> createExtensionConfig(
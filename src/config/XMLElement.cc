@@ -352,6 +352,35 @@ void XMLDocument::load(const std::string& filename, std::string_view systemID)
 	}
 }
 
+XMLElement* XMLDocument::cloneSharedStrings(const XMLElement& inElem)
+{
+	auto* outElem = allocateElement(inElem.name, inElem.data);
+
+	auto** attrPtr = &outElem->firstAttribute;
+	for (const auto* inAttr = inElem.firstAttribute; inAttr; inAttr = inAttr->nextAttribute) {
+		auto* outAttr = allocateAttribute(inAttr->name, inAttr->value);
+		*attrPtr = outAttr;
+		attrPtr = &outAttr->nextAttribute;
+	}
+
+	auto** childPtr = &outElem->firstChild;
+	for (const auto* inChild = inElem.firstChild; inChild; inChild = inChild->nextSibling) {
+		auto* outChild = cloneSharedStrings(*inChild);
+		*childPtr = outChild;
+		childPtr = &outChild->nextSibling;
+	}
+
+	return outElem;
+}
+
+void XMLDocument::load(std::shared_ptr<const XMLDocument> source)
+{
+	assert(!root);
+	assert(source && source->root);
+	root = cloneSharedStrings(*source->root);
+	sharedStrings = std::move(source);
+}
+
 XMLElement* XMLDocument::loadElement(MemInputArchive& ar)
 {
 	auto name = ar.loadStr();
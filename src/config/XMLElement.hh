@@ -9,6 +9,7 @@
 #include <concepts>
 #include <cstddef>
 #include <iterator>
+#include <memory>
 //#include <memory_resource>
 #include <string>
 #include <string_view>
@@ -287,6 +288,13 @@ public:
 	// Load/parse an xml file. Requires that the document is still empty.
 	void load(const std::string& filename, std::string_view systemID);
 
+	// Make this (still empty) document a copy of 'source'. Only the tree
+	// structure (the XMLElement and XMLAttribute objects) gets copied, the
+	// strings are shared with 'source' (this document keeps 'source' alive).
+	// This is possible because strings are never modified in-place.
+	// Modifying this copy does not influence 'source'.
+	void load(std::shared_ptr<const XMLDocument> source);
+
 	[[nodiscard]] const XMLElement* getRoot() const { return root; }
 	void setRoot(XMLElement* root_) { assert(!root); root = root_; }
 
@@ -321,6 +329,7 @@ public:
 private:
 	XMLElement* loadElement(MemInputArchive& ar);
 	XMLElement* clone(const XMLElement& inElem);
+	XMLElement* cloneSharedStrings(const XMLElement& inElem);
 	XMLElement* clone(const OldXMLElement& elem);
 
 private:
@@ -329,6 +338,7 @@ private:
 	// part of c++17, but not yet implemented in libc++
 	//    std::pmr::monotonic_buffer_resource allocator;
 	monotonic_allocator allocator;
+	std::shared_ptr<const XMLDocument> sharedStrings; // see load(shared_ptr)
 
 	friend class XMLDocumentHandler;
 };
@@ -0,0 +1,116 @@
+#include "GlyphAtlas.hh"
+
+#include "SDLSurfacePtr.hh"
+#include "TTFFont.hh"
+
+#include "narrow.hh"
+#include "xrange.hh"
+
+#include <SDL.h>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+
+using namespace gl;
+
+namespace openmsx {
+
+GlyphAtlas::GlyphAtlas(const std::string& filename_, int ptSize_)
+	: filename(filename_)
+	, ptSize(ptSize_)
+{
+}
+
+std::optional<GlyphAtlas::Glyph> GlyphAtlas::getGlyph(const TTFFont& font, uint16_t ch)
+{
+	if (const auto* glyph = lookup(glyphs, ch)) return *glyph;
+
+	auto metrics = font.getGlyphMetrics(ch);
+	if (!metrics) return {};
+
+	// A single rendered glyph has its origin at the left border, unless it
+	// extends to the left of the origin (same as the first character of a
+	// rendered line).
+	Glyph glyph{.texPos = {}, .size = {},
+	            .offsetX = std::min(0, metrics->minX),
+	            .advance = metrics->advance};
+	if (SDLSurfacePtr surface = font.renderGlyph(ch, 255, 255, 255)) {
+		ivec2 size(surface->w, surface->h);
+		auto pos = allocate(size);
+		if (!pos) return {};
+
+		// only the alpha channel is needed, the color is white
+		assert(surface->format->BytesPerPixel == 4);
+		for (auto y : xrange(size.y)) {
+			const auto* src = reinterpret_cast<const uint32_t*>(
+				static_cast<const uint8_t*>(surface->pixels) + y * surface->pitch);
+			auto* dst = &coverage[(pos->y + y) * WIDTH + pos->x];
+			for (auto x : xrange(size.x)) {
+				uint8_t r, g, b, a;
+				SDL_GetRGBA(src[x], surface->format, &r, &g, &b, &a);
+				dst[x] = a;
+			}
+		}
+		upload(*pos, size);
+		glyph.texPos = *pos;
+		glyph.size = size;
+	}
+	glyphs.emplace(ch, glyph);
+	return glyph;
+}
+
+std::optional<ivec2> GlyphAtlas::allocate(ivec2 size)
+{
+	// leave one transparent pixel between glyphs
+	auto [w, h] = size + ivec2(1, 1);
+	if (w > WIDTH) return {};
+
+	if (cursor.x + w > WIDTH) {
+		// start a new shelf
+		cursor = ivec2(0, cursor.y + shelfHeight);
+		shelfHeight = 0;
+	}
+	if ((cursor.y + h > height) && !grow(cursor.y + h)) {
+		return {};
+	}
+	auto result = cursor;
+	cursor.x += w;
+	shelfHeight = std::max(shelfHeight, h);
+	return result;
+}
+
+bool GlyphAtlas::grow(int minHeight)
+{
+	int newHeight = std::max(height, INITIAL_HEIGHT);
+	while (newHeight < minHeight) newHeight *= 2;
+	if (newHeight > MAX_HEIGHT) return false;
+
+	// rows are appended, so existing glyphs keep their (pixel) position
+	coverage.resize(size_t(WIDTH) * newHeight, 0);
+	height = newHeight;
+
+	texture.bind();
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, WIDTH, height, 0,
+	             GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+	upload(ivec2(0, 0), ivec2(WIDTH, cursor.y + shelfHeight));
+	return true;
+}
+
+void GlyphAtlas::upload(ivec2 pos, ivec2 size) const
+{
+	if (size.x == 0 || size.y == 0) return;
+	std::vector<std::array<uint8_t, 4>> rgba(size_t(size.x) * size.y);
+	for (auto y : xrange(size.y)) {
+		const auto* src = &coverage[(pos.y + y) * WIDTH + pos.x];
+		auto* dst = &rgba[y * size.x];
+		for (auto x : xrange(size.x)) {
+			dst[x] = {255, 255, 255, src[x]};
+		}
+	}
+	texture.bind();
+	glTexSubImage2D(GL_TEXTURE_2D, 0, pos.x, pos.y, size.x, size.y,
+	                GL_RGBA, GL_UNSIGNED_BYTE, rgba.data());
+}
+
+} // namespace openmsx
@@ -0,0 +1,80 @@
+#ifndef GLYPHATLAS_HH
+#define GLYPHATLAS_HH
+
+#include "GLUtil.hh"
+#include "gl_vec.hh"
+#include "hash_map.hh"
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace openmsx {
+
+class TTFFont;
+
+/** A texture that contains the glyphs of one font (at one size).
+  *
+  * Glyphs are rendered (in white) on first use and then stay in the
+  * texture. Text can then be drawn as a batch of textured quads, so changing
+  * the text only requires new vertex data instead of rendering and uploading
+  * a whole new image. The text color is applied while drawing.
+  *
+  * The texture height grows when more glyphs are added. Glyphs don't move
+  * when this happens, but their normalized texture coordinates do change
+  * (see getTextureSize()).
+  */
+class GlyphAtlas
+{
+public:
+	struct Glyph {
+		gl::ivec2 texPos; // position (in pixels) in the texture
+		gl::ivec2 size;   // can be zero, e.g. for a space
+		int offsetX;      // position relative to the pen
+		int advance;      // distance to the next pen position
+	};
+
+	GlyphAtlas(const std::string& filename, int ptSize);
+
+	[[nodiscard]] const std::string& getFilename() const { return filename; }
+	[[nodiscard]] int getPtSize() const { return ptSize; }
+
+	/** Get the glyph for the given code point, if needed it's first
+	  * rendered (with the given font) and added to the texture.
+	  * The font must be the caller's already opened font for this atlas'
+	  * filename and size, so the atlas doesn't open its own copy.
+	  * Returns nullopt if the glyph is not in the font or if the texture
+	  * is full, the caller should fall back to rendering via TTFFont.
+	  */
+	[[nodiscard]] std::optional<Glyph> getGlyph(const TTFFont& font, uint16_t ch);
+
+	[[nodiscard]] gl::ivec2 getTextureSize() const { return {WIDTH, height}; }
+	void bindTexture() const { texture.bind(); }
+
+private:
+	[[nodiscard]] std::optional<gl::ivec2> allocate(gl::ivec2 size);
+	[[nodiscard]] bool grow(int minHeight);
+	void upload(gl::ivec2 pos, gl::ivec2 size) const;
+
+private:
+	static constexpr int WIDTH = 512;
+	static constexpr int INITIAL_HEIGHT = 64;
+	static constexpr int MAX_HEIGHT = 2048;
+
+	std::string filename;
+	int ptSize;
+	hash_map<uint16_t, Glyph> glyphs;
+
+	std::vector<uint8_t> coverage; // alpha channel, WIDTH x height
+	gl::Texture texture;
+	int height = 0;
+
+	// shelf packing: glyphs are put left to right in rows
+	gl::ivec2 cursor;
+	int shelfHeight = 0;
+};
+
+} // namespace openmsx
+
+#endif
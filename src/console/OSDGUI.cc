@@ -2,6 +2,7 @@
 
 #include "CommandException.hh"
 #include "Display.hh"
+#include "GlyphAtlas.hh"
 #include "OSDRectangle.hh"
 #include "OSDText.hh"
 #include "OSDWidget.hh"
@@ -12,6 +13,7 @@
 #include "outer.hh"
 
 #include <array>
+#include <cassert>
 #include <memory>
 #include <utility>
 
@@ -26,6 +28,22 @@ OSDGUI::OSDGUI(CommandController& commandController, Display& display_)
 {
 }
 
+std::shared_ptr<GlyphAtlas> OSDGUI::getGlyphAtlas(
+	const std::string& filename, int ptSize)
+{
+	std::erase_if(glyphAtlases, [](const auto& w) { return w.expired(); });
+	for (const auto& w : glyphAtlases) {
+		auto atlas = w.lock();
+		assert(atlas);
+		if ((atlas->getFilename() == filename) && (atlas->getPtSize() == ptSize)) {
+			return atlas;
+		}
+	}
+	auto result = std::make_shared<GlyphAtlas>(filename, ptSize);
+	glyphAtlases.push_back(result);
+	return result;
+}
+
 void OSDGUI::refresh() const
 {
 	getDisplay().repaintDelayed(40000); // 25 fps
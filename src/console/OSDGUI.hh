@@ -5,11 +5,14 @@
 #include "Command.hh"
 
 #include <memory>
+#include <string>
+#include <vector>
 
 namespace openmsx {
 
 class Display;
 class CommandController;
+class GlyphAtlas;
 
 class OSDGUI
 {
@@ -21,8 +24,16 @@ public:
 	[[nodiscard]]       OSDTopWidget& getTopWidget()       { return topWidget; }
 	void refresh() const;
 
+	/** Get the glyph atlas for the given font. Atlases are shared between
+	  * all widgets that use the same font (and size). It's destroyed when
+	  * the last user releases it.
+	  */
+	[[nodiscard]] std::shared_ptr<GlyphAtlas> getGlyphAtlas(
+		const std::string& filename, int ptSize);
+
 private:
 	Display& display;
+	std::vector<std::weak_ptr<GlyphAtlas>> glyphAtlases;
 
 	class OSDCommand final : public Command {
 	public:
@@ -329,6 +329,11 @@ vec2 OSDImageBasedWidget::getRenderedSize() const
 	return imageSize / float(getScaleFactor(*output));
 }
 
+void OSDImageBasedWidget::drawImage(ivec2 drawPos, uint8_t alpha)
+{
+	image->draw(drawPos, alpha);
+}
+
 void OSDImageBasedWidget::paint(OutputSurface& output)
 {
 	// Note: Even when alpha == 0 we still create the image:
@@ -339,7 +344,7 @@ void OSDImageBasedWidget::paint(OutputSurface& output)
 	if (auto fadedAlpha = getFadedAlpha();
 	    (fadedAlpha != 0) && image) {
 		ivec2 drawPos = round(getTransformedPos(output));
-		image->draw(drawPos, fadedAlpha);
+		drawImage(drawPos, fadedAlpha);
 	}
 	if (isRecursiveFading() || isAnimating()) {
 		getDisplay().getOSDGUI().refresh();
@@ -56,6 +56,7 @@ protected:
 	void invalidateLocal() override;
 	void paint(OutputSurface& output) override;
 	[[nodiscard]] virtual std::unique_ptr<GLImage> create(OutputSurface& output) = 0;
+	virtual void drawImage(gl::ivec2 drawPos, uint8_t alpha);
 	[[nodiscard]] gl::vec2 getRenderedSize() const;
 
 	void setError(std::string message);
@@ -4,16 +4,22 @@
 #include "Display.hh"
 #include "FileContext.hh"
 #include "FileOperations.hh"
+#include "GLContext.hh"
 #include "GLImage.hh"
+#include "GlyphAtlas.hh"
+#include "OSDGUI.hh"
 #include "TTFFont.hh"
 #include "TclObject.hh"
 
 #include "StringOp.hh"
+#include "gl_transform.hh"
 #include "join.hh"
 #include "narrow.hh"
 #include "stl.hh"
 #include "unreachable.hh"
 #include "utf8_core.hh"
+#include "utf8_unchecked.hh"
+#include "view.hh"
 
 #include <cassert>
 #include <cmath>
@@ -123,6 +129,10 @@ void OSDText::getProperty(string_view propName, TclObject& result) const
 void OSDText::invalidateLocal()
 {
 	font = TTFFont(); // clear font
+	atlas.reset();
+	glyphVertices.clear();
+	glyphBuffer.reset();
+	useGlyphAtlas = false;
 	OSDImageBasedWidget::invalidateLocal();
 }
 
@@ -150,14 +160,17 @@ uint8_t OSDText::getFadedAlpha() const
 
 std::unique_ptr<GLImage> OSDText::create(OutputSurface& output)
 {
+	useGlyphAtlas = false;
 	if (text.empty()) {
 		return std::make_unique<GLImage>(ivec2(), 0);
 	}
 	int scale = getScaleFactor(output);
 	if (font.empty()) {
 		try {
-			font = TTFFont(systemFileContext().resolve(fontFile),
-			               size * scale);
+			auto filename = systemFileContext().resolve(fontFile);
+			font = TTFFont(filename, size * scale);
+			atlas = getDisplay().getOSDGUI().getGlyphAtlas(
+				filename, size * scale);
 		} catch (MSXException& e) {
 			throw MSXException("Couldn't open font: ", e.getMessage());
 		}
@@ -181,6 +194,16 @@ std::unique_ptr<GLImage> OSDText::create(OutputSurface& output)
 		} else {
 			UNREACHABLE;
 		}
+		// Changing the text typically only requires new vertex data.
+		if (auto textSize = layoutGlyphs(wrappedText)) {
+			useGlyphAtlas = true;
+			uploadedAtlasSize = ivec2(); // force upload
+			// only used to hold the size
+			return std::make_unique<GLImage>(*textSize, 0);
+		}
+
+		// Fallback, e.g. for characters outside the Basic Multilingual
+		// Plane or when the atlas is full.
 		// An alternative is to pass vector<string> to TTFFont::render().
 		// That way we can avoid join() (in the wrap functions)
 		// followed by // StringOp::split() (in TTFFont::render()).
@@ -198,6 +221,111 @@ std::unique_ptr<GLImage> OSDText::create(OutputSurface& output)
 	}
 }
 
+// Lay out the (already wrapped) text as quads that refer to the glyph atlas.
+// This gives the same result as TTFFont::render() (up to possible sub-pixel
+// differences in the glyph positions). Returns the size of the text or
+// nullopt when the atlas can't handle this text.
+std::optional<ivec2> OSDText::layoutGlyphs(string_view txt)
+{
+	glyphVertices.clear();
+	if (!atlas || !utf8::is_valid(txt.begin(), txt.end())) return {};
+
+	StringOp::trimRight(txt, " \n"); // same as TTFFont::render()
+	ivec2 textSize;
+	int lineSkip = font.getHeight();
+	int y = -lineSkip;
+	for (auto line : StringOp::split_view(txt, '\n')) {
+		y += lineSkip;
+		if (line.empty()) continue;
+		auto [w, h] = font.getSize(string(line));
+		textSize = ivec2(std::max(textSize.x, w), y + h);
+
+		int penX = 0;
+		uint16_t prev = 0;
+		auto it = line.begin();
+		while (it != line.end()) {
+			auto cp = utf8::unchecked::next(it);
+			if (cp > 0xffff) return {};
+			auto ch = narrow_cast<uint16_t>(cp);
+			if (prev) penX += font.getKerning(prev, ch);
+			auto glyph = atlas->getGlyph(font, ch);
+			if (!glyph) return {};
+			if (glyph->size != ivec2()) {
+				vec2 p0(narrow<float>(penX + glyph->offsetX), narrow<float>(y));
+				vec2 p1 = p0 + vec2(glyph->size);
+				vec2 t0(glyph->texPos);
+				vec2 t1 = t0 + vec2(glyph->size);
+				append(glyphVertices, std::array{
+					GlyphVertex{p0, t0},
+					GlyphVertex{vec2(p1.x, p0.y), vec2(t1.x, t0.y)},
+					GlyphVertex{p1, t1},
+					GlyphVertex{p0, t0},
+					GlyphVertex{p1, t1},
+					GlyphVertex{vec2(p0.x, p1.y), vec2(t0.x, t1.y)}});
+			}
+			penX += glyph->advance;
+			prev = ch;
+		}
+	}
+	return textSize;
+}
+
+void OSDText::uploadGlyphVertices()
+{
+	// Texture coordinates must be normalized, and the atlas texture can
+	// grow when other text is added to it.
+	uploadedAtlasSize = atlas->getTextureSize();
+	vec2 texScale = vec2(1.0f) / vec2(uploadedAtlasSize);
+	auto vertices = to_vector(view::transform(glyphVertices, [&](const auto& v) {
+		return GlyphVertex{v.pos, v.tex * texScale};
+	}));
+
+	if (!glyphBuffer) glyphBuffer.emplace();
+	glBindBuffer(GL_ARRAY_BUFFER, glyphBuffer->get());
+	glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(GlyphVertex),
+	             vertices.data(), GL_STATIC_DRAW);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+void OSDText::drawImage(ivec2 drawPos, uint8_t alpha)
+{
+	if (!useGlyphAtlas) {
+		OSDImageBasedWidget::drawImage(drawPos, alpha);
+		return;
+	}
+	if (glyphVertices.empty()) return;
+	if (uploadedAtlasSize != atlas->getTextureSize()) {
+		uploadGlyphVertices();
+	}
+
+	glEnable(GL_BLEND);
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+	auto& glContext = *gl::context;
+	unsigned textRgba = getRGBA(0);
+	glContext.progTex.activate();
+	glUniform4f(glContext.unifTexColor,
+	            narrow<float>((textRgba >> 24) & 0xff) * (1.0f / 255.0f),
+	            narrow<float>((textRgba >> 16) & 0xff) * (1.0f / 255.0f),
+	            narrow<float>((textRgba >>  8) & 0xff) * (1.0f / 255.0f),
+	            narrow<float>(alpha)                   * (1.0f / 255.0f));
+	mat4 mvp = translate(glContext.pixelMvp, vec3(vec2(drawPos), 0.0f));
+	glUniformMatrix4fv(glContext.unifTexMvp, 1, GL_FALSE, mvp.data());
+
+	glBindBuffer(GL_ARRAY_BUFFER, glyphBuffer->get());
+	const vec2* offset = nullptr;
+	glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(GlyphVertex), offset + 0); // pos
+	glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(GlyphVertex), offset + 1); // tex
+	glEnableVertexAttribArray(0);
+	glEnableVertexAttribArray(1);
+	atlas->bindTexture();
+	glDrawArrays(GL_TRIANGLES, 0, narrow<GLsizei>(glyphVertices.size()));
+	glDisableVertexAttribArray(1);
+	glDisableVertexAttribArray(0);
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	glDisable(GL_BLEND);
+}
+
 
 // Search for a position strictly between min and max which also points to the
 // start of a (possibly multi-byte) utf8-character. If no such position exits,
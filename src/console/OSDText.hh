@@ -4,13 +4,20 @@
 #include "OSDImageBasedWidget.hh"
 #include "TTFFont.hh"
 
+#include "GLUtil.hh"
+#include "gl_vec.hh"
 #include "stl.hh"
 
 #include <array>
 #include <memory>
+#include <optional>
+#include <string_view>
+#include <vector>
 
 namespace openmsx {
 
+class GlyphAtlas;
+
 class OSDText final : public OSDImageBasedWidget
 {
 private:
@@ -40,6 +47,10 @@ private:
 	[[nodiscard]] gl::vec2 getSize(const OutputSurface& output) const override;
 	[[nodiscard]] uint8_t getFadedAlpha() const override;
 	[[nodiscard]] std::unique_ptr<GLImage> create(OutputSurface& output) override;
+	void drawImage(gl::ivec2 drawPos, uint8_t alpha) override;
+
+	[[nodiscard]] std::optional<gl::ivec2> layoutGlyphs(std::string_view txt);
+	void uploadGlyphVertices();
 
 	template<typename FindSplitPointFunc, typename CantSplitFunc>
 	[[nodiscard]] size_t split(const std::string& line, unsigned maxWidth,
@@ -60,6 +71,19 @@ private:
 	WrapMode wrapMode = NONE;
 	float wrapw = 0.0f, wraprelw = 1.0f;
 
+	// When possible the text is drawn as quads from a glyph atlas (shared
+	// with other widgets that use the same font). Then 'image' is only a
+	// placeholder that holds the size.
+	struct GlyphVertex {
+		gl::vec2 pos; // in pixels, relative to the widget
+		gl::vec2 tex; // in pixels, normalized when uploaded
+	};
+	std::shared_ptr<GlyphAtlas> atlas;
+	std::vector<GlyphVertex> glyphVertices;
+	std::optional<gl::BufferObject> glyphBuffer;
+	gl::ivec2 uploadedAtlasSize; // atlas size at the time of the upload
+	bool useGlyphAtlas = false;
+
 	friend struct SplitAtChar;
 };
 
@@ -267,4 +267,29 @@ gl::ivec2 TTFFont::getSize(zstring_view text) const
 	return {width, height};
 }
 
+std::optional<TTFFont::GlyphMetrics> TTFFont::getGlyphMetrics(uint16_t ch) const
+{
+	auto* f = static_cast<TTF_Font*>(font);
+	if (!TTF_GlyphIsProvided(f, ch)) return {};
+	GlyphMetrics m;
+	if (TTF_GlyphMetrics(f, ch, &m.minX, &m.maxX, &m.minY, &m.maxY, &m.advance)) {
+		return {};
+	}
+	return m;
+}
+
+SDLSurfacePtr TTFFont::renderGlyph(uint16_t ch, uint8_t r, uint8_t g, uint8_t b) const
+{
+	SDL_Color color = { r, g, b, 0 };
+	// Note: SDL_ttf fails for glyphs that have zero width, that's not an
+	// error for us.
+	return SDLSurfacePtr(TTF_RenderGlyph_Blended(
+		static_cast<TTF_Font*>(font), ch, color));
+}
+
+int TTFFont::getKerning(uint16_t prev, uint16_t ch) const
+{
+	return TTF_GetFontKerningSizeGlyphs(static_cast<TTF_Font*>(font), prev, ch);
+}
+
 } // namespace openmsx
@@ -5,6 +5,7 @@
 #include "gl_vec.hh"
 #include "zstring_view.hh"
 #include <cstdint>
+#include <optional>
 #include <string>
 #include <utility>
 
@@ -74,6 +75,28 @@ public:
 	 */
 	[[nodiscard]] gl::ivec2 getSize(zstring_view text) const;
 
+	struct GlyphMetrics {
+		int minX, maxX, minY, maxY;
+		int advance;
+	};
+	/** Return the metrics of a single glyph (Unicode BMP code point).
+	  * Returns nullopt if the font doesn't contain this glyph.
+	  */
+	[[nodiscard]] std::optional<GlyphMetrics> getGlyphMetrics(uint16_t ch) const;
+
+	/** Render a single glyph. Like render(), but for one character. The
+	  * surface has the same height as a rendered line of text, and the
+	  * glyph is positioned as if it were the first character of that line.
+	  * Returns an empty surface for glyphs without visible pixels (e.g. a
+	  * zero-width character).
+	  */
+	[[nodiscard]] SDLSurfacePtr renderGlyph(uint16_t ch, uint8_t r, uint8_t g, uint8_t b) const;
+
+	/** Return the kerning (extra horizontal offset in pixels) between two
+	  * successive glyphs.
+	  */
+	[[nodiscard]] int getKerning(uint16_t prev, uint16_t ch) const;
+
 private:
 	void* font = nullptr;  // TTF_Font*
 };
@@ -26,6 +26,7 @@ bool BreakPointBase::checkAndExecute(GlobalCliComm& cliComm, Interpreter& interp
 		return false;
 	}
 	ScopedAssign sa(executing, true);
+	CallbackStats::Measure measure(*stats);
 	if (isTrue(cliComm, interp)) {
 		try {
 			command.executeCommand(interp, true); // compile command
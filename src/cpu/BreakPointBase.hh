@@ -1,7 +1,9 @@
 #ifndef BREAKPOINTBASE_HH
 #define BREAKPOINTBASE_HH
 
+#include "CallbackStats.hh"
 #include "TclObject.hh"
+#include <memory>
 #include <string_view>
 
 namespace openmsx {
@@ -17,6 +19,9 @@ public:
 	[[nodiscard]] TclObject getCondition() const { return condition; }
 	[[nodiscard]] TclObject getCommand()   const { return command; }
 	[[nodiscard]] bool onlyOnce() const { return once; }
+	/** Statistics of checkAndExecute(), so of evaluating the condition
+	  * plus executing the command. */
+	[[nodiscard]] const CallbackStats& getStats() const { return *stats; }
 
 	bool checkAndExecute(GlobalCliComm& cliComm, Interpreter& interp);
 
@@ -35,6 +40,8 @@ private:
 private:
 	TclObject command;
 	TclObject condition;
+	// Shared because break points get copied before they're checked.
+	std::shared_ptr<CallbackStats> stats = std::make_shared<CallbackStats>();
 	bool once;
 	bool executing = false;
 };
@@ -113,6 +113,15 @@ protected:
 	[[nodiscard]] inline bool limitReached() const {
 		return remaining < 0;
 	}
+	/** How many times can 'ticks' be added (on top of 'reserved' ticks)
+	  * before limitReached() becomes true? Used to execute multiple
+	  * iterations of a block instruction (e.g. LDIR) or of an idle loop in
+	  * one go.
+	  */
+	[[nodiscard]] inline unsigned numAddsTillLimit(unsigned ticks, unsigned reserved = 0) const {
+		int left = remaining - narrow_cast<int>(reserved);
+		return (left < 0) ? 0 : unsigned(left) / ticks;
+	}
 
 	template<typename Archive>
 	void serialize(Archive& ar, unsigned version);
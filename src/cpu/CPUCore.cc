@@ -176,9 +176,11 @@
 #include "unreachable.hh"
 #include "xrange.hh"
 
+#include <algorithm>
 #include <array>
 #include <bit>
 #include <cassert>
+#include <cstring>
 #include <iostream>
 #include <type_traits>
 
@@ -366,6 +368,8 @@ template<typename T> void CPUCore<T>::doReset(EmuTime::param time)
 	setR(0x00);
 	T::setMemPtr(0xFFFF);
 	clearPrevious();
+	idleStats = {};
+	loopExits = {};
 
 	// We expect this assert to be valid
 	//   assert(T::getTimeFast() <= time); // time shouldn't go backwards
@@ -432,6 +436,17 @@ template<typename T> inline bool CPUCore<T>::needExitCPULoop()
 	//return exitLoop.exchange(false);
 }
 
+template<typename T> inline void CPUCore<T>::countLoopExit()
+{
+	auto cause = [&] {
+		if (exitLoop) return LoopExit::EXIT_LOOP;
+		if (slowInstructions == 0) return LoopExit::SYNC_POINT;
+		if ((IRQStatus != 0) || nmiEdge) return LoopExit::IRQ;
+		return LoopExit::SLOW_INSTRUCTIONS; // e.g. after EI
+	}();
+	++loopExits[size_t(cause)];
+}
+
 template<typename T> void CPUCore<T>::setSlowInstructions()
 {
 	slowInstructions = 2;
@@ -565,6 +580,7 @@ NEVER_INLINE byte CPUCore<T>::RDMEMslow(unsigned address, unsigned cc)
 		auto addrBase = narrow_cast<word>(address & CacheLine::HIGH);
 		if (const byte* line = interface->getReadCacheLine(addrBase)) {
 			// cached ok
+			interface->tick(CacheLineCounters::SlowRefillRead);
 			T::template PRE_MEM<PRE_PB, POST_PB>(address);
 			T::template POST_MEM<       POST_PB>(address);
 			readCacheLine[high] = line - addrBase;
@@ -669,6 +685,7 @@ NEVER_INLINE void CPUCore<T>::WRMEMslow(unsigned address, byte value, unsigned c
 		auto addrBase = narrow_cast<word>(address & CacheLine::HIGH);
 		if (byte* line = interface->getWriteCacheLine(addrBase)) {
 			// cached ok
+			interface->tick(CacheLineCounters::SlowRefillWrite);
 			T::template PRE_MEM<PRE_PB, POST_PB>(address);
 			T::template POST_MEM<       POST_PB>(address);
 			writeCacheLine[high] = line - addrBase;
@@ -2510,7 +2527,9 @@ template<typename T> void CPUCore<T>::executeSlow(ExecIRQ execIRQ)
 		}
 	} else if (getHALT()) [[unlikely]] {
 		// in halt mode
-		incR(narrow_cast<byte>(T::advanceHalt(T::HALT_STATES, scheduler.getNext())));
+		auto halts = T::advanceHalt(T::HALT_STATES, scheduler.getNext());
+		incR(narrow_cast<byte>(halts));
+		idleStats.haltCycles += uint64_t(halts) * T::HALT_STATES;
 		setSlowInstructions();
 	} else {
 		cpuTracePre();
@@ -2578,6 +2597,7 @@ template<typename T> void CPUCore<T>::execute2(bool fastForward)
 						// note: pipeline only shifted one
 						// step for multiple instructions
 						endInstruction();
+						countLoopExit();
 					}
 					scheduler.schedule(T::getTimeFast());
 					if (needExitCPULoop()) return;
@@ -3972,12 +3992,102 @@ template<typename T> template<typename COND> II CPUCore<T>::jr(COND cond) {
 		}
 		setPC(narrow_cast<word>(getPC() + 2 + ofst));
 		T::setMemPtr(getPC());
+		if constexpr (!T::IS_R800) {
+			if ((-7 <= ofst) && (ofst <= -2)) [[unlikely]] {
+				skipPollLoop(-ofst - 2);
+			}
+		}
 		return {0/*2*/, T::CC_JR_A};
 	} else {
 		return {2, T::CC_JR_B};
 	}
 }
 
+// Idle-loop detection. Software often waits for an interrupt (handler) to
+// change some variable in RAM (e.g. JIFFY), like in:
+//     loop: ld   a,(nn)   ; or ld a,(hl), ld a,(bc), ld a,(de)
+//           cp   n        ; optional: cp n, and n, or n, cp r, and a, or a
+//           jr   z,loop   ; any condition, or 'jr $' without a loop body
+// Such a loop only reads (cached) memory and only changes registers in a
+// way that's identical for each iteration. So as long as nothing else
+// happens (next sync point, IRQ, breakpoint, ...) executing another
+// iteration has no effect apart from advancing time and the R register.
+// Called from jr() when the jump is taken, PC points to the start of the
+// loop, the loop body (without the jr instruction) is 'bodyLen' bytes.
+template<typename T> NEVER_INLINE void CPUCore<T>::skipPollLoop(unsigned bodyLen)
+{
+	assert(!T::IS_R800);
+	unsigned start = getPC();
+	std::array<byte, 5> code;
+	for (auto i : xrange(bodyLen)) {
+		auto addr = narrow_cast<word>(start + i);
+		const byte* line = readCacheLine[addr >> CacheLine::BITS];
+		if (uintptr_t(line) <= 1) return;
+		code[i] = line[addr];
+	}
+
+	unsigned cycles = T::CC_JR_A;
+	unsigned instructions = 1;
+	if (bodyLen != 0) {
+		unsigned address;
+		unsigned pos = 1;
+		switch (code[0]) {
+			case 0x3A: // ld a,(nn)
+				if (bodyLen < 3) return;
+				address = code[1] + (code[2] << 8);
+				pos = 3;
+				cycles += T::CC_LD_A_NN;
+				break;
+			case 0x7E: // ld a,(hl)
+				address = getHL();
+				cycles += T::CC_LD_R_HL;
+				break;
+			case 0x0A: // ld a,(bc)
+				address = getBC();
+				cycles += T::CC_LD_A_SS;
+				break;
+			case 0x1A: // ld a,(de)
+				address = getDE();
+				cycles += T::CC_LD_A_SS;
+				break;
+			default:
+				return;
+		}
+		// must be plain memory, not e.g. a memory mapped I/O register
+		if (uintptr_t(readCacheLine[address >> CacheLine::BITS]) <= 1) return;
+		++instructions;
+
+		if (pos < bodyLen) {
+			switch (code[pos]) {
+				case 0xFE: // cp n
+				case 0xE6: // and n
+				case 0xF6: // or n
+					pos += 2;
+					cycles += T::CC_CP_N;
+					break;
+				case 0xA7: // and a
+				case 0xB7: // or a
+				case 0xB8: case 0xB9: case 0xBA: // cp b, cp c, cp d
+				case 0xBB: case 0xBC: case 0xBD: // cp e, cp h, cp l
+					pos += 1;
+					cycles += T::CC_CP_R;
+					break;
+				default:
+					return;
+			}
+			++instructions;
+		}
+		if (pos != bodyLen) return;
+	}
+
+	// The cycles of the current jr instruction still need to be added.
+	auto n = T::numAddsTillLimit(cycles, T::CC_JR_A);
+	if (n == 0) return;
+	T::add(n * cycles);
+	incR(narrow_cast<byte>(n * instructions));
+	idleStats.pollCycles += uint64_t(n) * cycles;
+}
+
 // DJNZ e
 template<typename T> II CPUCore<T>::djnz() {
 	byte b = getB() - 1;
@@ -4093,13 +4203,107 @@ template<typename T> II CPUCore<T>::cpdr() { return BLOCK_CP(-1, true ); }
 template<typename T> II CPUCore<T>::cpir() { return BLOCK_CP( 1, true ); }
 
 
+// Batched execution of the repeating block instructions (Z80 only).
+//
+// Normally each iteration of e.g. LDIR or OTIR returns to the main loop,
+// which checks the limit, re-fetches and decodes the instruction before
+// executing the next iteration. The BLOCK_xx_batch() methods below instead
+// execute the following iterations directly, for as long as that gives the
+// exact same result:
+//  - The limit (next sync point, pending IRQ, breakpoints, tracing, ...) is
+//    not reached before the start of the next iteration.
+//  - The instruction itself is located in cached memory and is unchanged. So
+//    skipping the opcode fetches has no (observable) effect.
+// The cycle count and the R register are updated as if each iteration was
+// fetched separately. Memory and I/O accesses still happen at the same
+// emulated time as in the per-iteration path.
+//
+// This is not done for the R800, there the timing also depends on memory
+// page-breaks and refresh.
+template<typename T> inline bool CPUCore<T>::canBatchBlock(byte opcode) const
+{
+	// at this point PC points to the 2nd byte of the instruction
+	unsigned pc = getPC();
+	auto ed = narrow_cast<word>(pc - 1);
+	const byte* line0 = readCacheLine[ed >> CacheLine::BITS];
+	const byte* line1 = readCacheLine[pc >> CacheLine::BITS];
+	return (uintptr_t(line0) > 1) && (uintptr_t(line1) > 1) &&
+	       (line0[ed] == 0xED) && (line1[pc] == opcode);
+}
+
+
 // block LD
+template<typename T> inline byte CPUCore<T>::BLOCK_LD_batch(int increase, byte val)
+{
+	assert(!T::IS_R800);
+	if (!canBatchBlock(increase > 0 ? 0xB0 : 0xB8)) return val;
+	unsigned pc = getPC();
+	auto ed = narrow_cast<word>(pc - 1);
+	const byte* op0 = &readCacheLine[ed >> CacheLine::BITS][ed];
+	const byte* op1 = &readCacheLine[pc >> CacheLine::BITS][pc];
+	auto lineLeft = [&](word addr) {
+		return (increase > 0) ? CacheLine::SIZE - (addr & CacheLine::LOW)
+		                      : (addr & CacheLine::LOW) + 1;
+	};
+	bool batched = false;
+	while (getBC()) {
+		// Copy a chunk of bytes that doesn't cross a cache line boundary.
+		word hl = getHL();
+		word de = getDE();
+		const byte* srcLine = readCacheLine[hl >> CacheLine::BITS];
+		byte* dstLine = writeCacheLine[de >> CacheLine::BITS];
+		if ((uintptr_t(srcLine) <= 1) || (uintptr_t(dstLine) <= 1)) break;
+		unsigned n = std::min({unsigned(getBC()),
+		                       T::numAddsTillLimit(T::CC_LDIR),
+		                       lineLeft(hl), lineLeft(de)});
+		if (n == 0) break;
+		const byte* src = &srcLine[hl];
+		byte* dst = &dstLine[de];
+		// lowest address of both regions
+		const byte* srcBegin = (increase > 0) ? src : src - (n - 1);
+		byte* dstBegin = (increase > 0) ? dst : dst - (n - 1);
+		if ((dstBegin <= op0 && op0 < dstBegin + n) ||
+		    (dstBegin <= op1 && op1 < dstBegin + n)) {
+			// would overwrite the instruction itself
+			break;
+		}
+		// When the regions overlap, copying byte per byte (in the direction
+		// of the instruction) gives a different result than memmove() (e.g.
+		// LDIR with DE=HL+1 fills memory with a single value).
+		bool overlap = (increase > 0) ? (src < dst && dst < src + n)
+		                              : (dst < src && src - n < dst);
+		if (overlap) [[unlikely]] {
+			for (auto i : xrange(n)) {
+				auto offset = narrow<int>(i) * increase;
+				dst[offset] = src[offset];
+			}
+		} else {
+			memmove(dstBegin, srcBegin, n);
+		}
+		val = dst[narrow<int>(n - 1) * increase];
+		setHL(narrow_cast<word>(hl + narrow<int>(n) * increase));
+		setDE(narrow_cast<word>(de + narrow<int>(n) * increase));
+		setBC(narrow_cast<word>(getBC() - n));
+		// each iteration is preceded by a (repeating) iteration of CC_LDIR
+		// cycles and the fetch of two opcode bytes
+		T::add(n * T::CC_LDIR);
+		incR(narrow_cast<byte>(2 * n));
+		batched = true;
+	}
+	if (batched) T::setMemPtr(getPC() + 1);
+	return val;
+}
 template<typename T> inline II CPUCore<T>::BLOCK_LD(int increase, bool repeat) {
 	byte val = RDMEM(getHL(), T::CC_LDI_1);
 	WRMEM(getDE(), val, T::CC_LDI_2);
 	setHL(narrow_cast<word>(getHL() + increase));
 	setDE(narrow_cast<word>(getDE() + increase));
 	setBC(getBC() - 1);
+	if constexpr (!T::IS_R800) {
+		if (repeat && getBC()) {
+			val = BLOCK_LD_batch(increase, val);
+		}
+	}
 	byte f = getBC() ? V_FLAG : 0;
 	if constexpr (T::IS_R800) {
 		f |= byte(getF() & (S_FLAG | Z_FLAG | C_FLAG | X_FLAG | Y_FLAG));
@@ -4124,6 +4328,23 @@ template<typename T> II CPUCore<T>::ldir() { return BLOCK_LD( 1, true ); }
 
 
 // block IN
+template<typename T> inline byte CPUCore<T>::BLOCK_IN_batch(int increase, byte val)
+{
+	assert(!T::IS_R800);
+	byte opcode = increase > 0 ? 0xB2 : 0xBA;
+	// Re-check everything before each iteration: an I/O access can e.g.
+	// raise an IRQ (disables the limit) or switch memory banks.
+	while (getB() && (T::numAddsTillLimit(T::CC_INIR) != 0) && canBatchBlock(opcode)) {
+		T::add(T::CC_INIR);
+		incR(2);
+		T::setMemPtr(getBC() + increase);
+		setBC(getBC() - 0x100); // decr before use
+		val = READ_PORT(getBC(), T::CC_INI_1);
+		WRMEM(getHL(), val, T::CC_INI_2);
+		setHL(narrow_cast<word>(getHL() + increase));
+	}
+	return val;
+}
 template<typename T> inline II CPUCore<T>::BLOCK_IN(int increase, bool repeat) {
 	if constexpr (T::IS_R800) T::waitForEvenCycle(T::CC_INI_1);
 	T::setMemPtr(getBC() + increase);
@@ -4131,6 +4352,11 @@ template<typename T> inline II CPUCore<T>::BLOCK_IN(int increase, bool repeat) {
 	byte val = READ_PORT(getBC(), T::CC_INI_1);
 	WRMEM(getHL(), val, T::CC_INI_2);
 	setHL(narrow_cast<word>(getHL() + increase));
+	if constexpr (!T::IS_R800) {
+		if (repeat && getB()) {
+			val = BLOCK_IN_batch(increase, val);
+		}
+	}
 	unsigned k = val + ((getC() + increase) & 0xFF);
 	byte b = getB();
 	if constexpr (T::IS_R800) {
@@ -4155,12 +4381,34 @@ template<typename T> II CPUCore<T>::inir() { return BLOCK_IN( 1, true ); }
 
 
 // block OUT
+template<typename T> inline byte CPUCore<T>::BLOCK_OUT_batch(int increase, byte val)
+{
+	assert(!T::IS_R800);
+	byte opcode = increase > 0 ? 0xB3 : 0xBB;
+	// Typically used to send a block of data to the VDP. Each port write
+	// goes directly to the (devirtualized) handler of the I/O port, but
+	// still at its own emulated time. See also BLOCK_IN_batch().
+	while (getB() && (T::numAddsTillLimit(T::CC_OTIR) != 0) && canBatchBlock(opcode)) {
+		T::add(T::CC_OTIR);
+		incR(2);
+		val = RDMEM(getHL(), T::CC_OUTI_1);
+		setHL(narrow_cast<word>(getHL() + increase));
+		WRITE_PORT(getBC(), val, T::CC_OUTI_2);
+		setBC(getBC() - 0x100); // decr after use
+	}
+	return val;
+}
 template<typename T> inline II CPUCore<T>::BLOCK_OUT(int increase, bool repeat) {
 	byte val = RDMEM(getHL(), T::CC_OUTI_1);
 	setHL(narrow_cast<word>(getHL() + increase));
 	if constexpr (T::IS_R800) T::waitForEvenCycle(T::CC_OUTI_2);
 	WRITE_PORT(getBC(), val, T::CC_OUTI_2);
 	setBC(getBC() - 0x100); // decr after use
+	if constexpr (!T::IS_R800) {
+		if (repeat && getB()) {
+			val = BLOCK_OUT_batch(increase, val);
+		}
+	}
 	T::setMemPtr(getBC() + increase);
 	unsigned k = val + getL();
 	byte b = getB();
@@ -12,6 +12,7 @@
 
 #include <array>
 #include <atomic>
+#include <cstdint>
 #include <span>
 #include <string>
 
@@ -118,6 +119,26 @@ public:
 	 */
 	void setFreq(unsigned freq);
 
+	/** Statistics about idle time: the number of CPU cycles that were
+	  * skipped (not emulated instruction by instruction) while the CPU was
+	  * in HALT state or was executing a memory polling loop. Reset on
+	  * CPU reset.
+	  */
+	struct IdleStats {
+		uint64_t haltCycles = 0;
+		uint64_t pollCycles = 0;
+	};
+	[[nodiscard]] const IdleStats& getIdleStats() const { return idleStats; }
+
+	/** Number of times the main emulation loop (the part that executes
+	  * multiple instructions in one go) was exited, per cause. Only
+	  * counted when there are no breakpoints and tracing is off (otherwise
+	  * the loop is exited after each instruction). Reset on CPU reset.
+	  */
+	enum class LoopExit { SYNC_POINT, IRQ, SLOW_INSTRUCTIONS, EXIT_LOOP, NUM };
+	using LoopExitCounts = std::array<uint64_t, size_t(LoopExit::NUM)>;
+	[[nodiscard]] const LoopExitCounts& getLoopExitCounts() const { return loopExits; }
+
 	[[nodiscard]] BooleanSetting& getFreqLockedSetting() { return freqLocked; }
 	[[nodiscard]] IntegerSetting& getFreqValueSetting()  { return freqValue; }
 
@@ -129,6 +150,7 @@ private:
 	[[nodiscard]] bool needExitCPULoop();
 	void setSlowInstructions();
 	void doSetFreq();
+	inline void countLoopExit();
 
 	// Observer<Setting>  !! non-virtual !!
 	void update(const Setting& setting) noexcept;
@@ -166,6 +188,9 @@ private:
 
 	std::atomic<bool> exitLoop = false;
 
+	IdleStats idleStats;
+	LoopExitCounts loopExits = {};
+
 	/** In sync with traceSetting.getBoolean(). */
 	bool tracingEnabled;
 
@@ -423,6 +448,7 @@ private:
 	template<Reg16 REG, int EE> inline II jp_SS();
 	template<typename COND> inline II jp(COND cond);
 	template<typename COND> inline II jr(COND cond);
+	void skipPollLoop(unsigned bodyLen);
 	inline II djnz();
 
 	template<Reg16 REG, int EE> inline II ex_xsp_SS();
@@ -439,19 +465,23 @@ private:
 	inline II cpdr();
 	inline II cpir();
 
+	inline bool canBatchBlock(byte opcode) const;
 	inline II BLOCK_LD(int increase, bool repeat);
+	inline byte BLOCK_LD_batch(int increase, byte val);
 	inline II ldd();
 	inline II ldi();
 	inline II lddr();
 	inline II ldir();
 
 	inline II BLOCK_IN(int increase, bool repeat);
+	inline byte BLOCK_IN_batch(int increase, byte val);
 	inline II ind();
 	inline II ini();
 	inline II indr();
 	inline II inir();
 
 	inline II BLOCK_OUT(int increase, bool repeat);
+	inline byte BLOCK_OUT_batch(int increase, byte val);
 	inline II outd();
 	inline II outi();
 	inline II otdr();
@@ -14,11 +14,15 @@
 
 #include "outer.hh"
 #include "ranges.hh"
+#include "strCat.hh"
 #include "unreachable.hh"
+#include "view.hh"
 #include "xrange.hh"
 
+#include <array>
 #include <cassert>
 #include <memory>
+#include <string_view>
 
 namespace openmsx {
 
@@ -41,6 +45,8 @@ MSXCPU::MSXCPU(MSXMotherBoard& motherboard_)
 			diHaltCallback, EmuTime::zero())
 		: nullptr)
 	, timeInfo(motherboard.getMachineInfoCommand())
+	, idleInfo(motherboard.getMachineInfoCommand())
+	, loopExitInfo(motherboard.getMachineInfoCommand())
 	, z80FreqInfo(motherboard.getMachineInfoCommand(), "z80_freq", *z80)
 	, r800FreqInfo(r800
 		? std::make_unique<CPUFreqInfoTopic>(
@@ -389,6 +395,85 @@ std::string MSXCPU::TimeInfoTopic::help(std::span<const TclObject> /*tokens*/) c
 }
 
 
+// class IdleInfoTopic
+
+MSXCPU::IdleInfoTopic::IdleInfoTopic(InfoCommand& machineInfoCommand)
+	: InfoTopic(machineInfoCommand, "idle_skip")
+{
+}
+
+void MSXCPU::IdleInfoTopic::execute(
+	std::span<const TclObject> /*tokens*/, TclObject& result) const
+{
+	const auto& cpu = OUTER(MSXCPU, idleInfo);
+	double halt = 0.0;
+	double poll = 0.0;
+	auto add = [&](const auto& core) {
+		const auto& stats = core.getIdleStats();
+		auto freq = double(core.getFreq());
+		halt += double(stats.haltCycles) / freq;
+		poll += double(stats.pollCycles) / freq;
+	};
+	add(*cpu.z80);
+	if (cpu.r800) add(*cpu.r800);
+	double total = (cpu.getCurrentTime() - cpu.reference).toDouble();
+	double fraction = (total > 0.0) ? ((halt + poll) / total) : 0.0;
+	result.addDictKeyValues("halt", halt,
+	                        "poll", poll,
+	                        "fraction", fraction);
+}
+
+std::string MSXCPU::IdleInfoTopic::help(std::span<const TclObject> /*tokens*/) const
+{
+	return "Returns how much emulated time (in seconds, since the last reset) "
+	       "the CPU spent in HALT state ('halt') or in a polling loop that "
+	       "was skipped instead of emulated instruction by instruction "
+	       "('poll'), and which fraction of the total time that is "
+	       "('fraction').\n";
+}
+
+
+// class LoopExitInfoTopic
+
+MSXCPU::LoopExitInfoTopic::LoopExitInfoTopic(InfoCommand& machineInfoCommand)
+	: InfoTopic(machineInfoCommand, "cpu_loop_exits")
+{
+}
+
+void MSXCPU::LoopExitInfoTopic::execute(
+	std::span<const TclObject> /*tokens*/, TclObject& result) const
+{
+	const auto& cpu = OUTER(MSXCPU, loopExitInfo);
+	auto counts = cpu.z80->getLoopExitCounts();
+	if (cpu.r800) {
+		const auto& r800Counts = cpu.r800->getLoopExitCounts();
+		for (auto i : xrange(counts.size())) counts[i] += r800Counts[i];
+	}
+	double seconds = (cpu.getCurrentTime() - cpu.reference).toDouble();
+	static constexpr std::array<std::string_view, 4> names = {
+		"sync_point", "irq", "slow_instructions", "exit_loop"
+	};
+	static_assert(names.size() == counts.size());
+	for (auto [name, count] : view::zip_equal(names, counts)) {
+		TclObject entry;
+		// TclObject has no 64-bit integer support, but a string works as well
+		entry.addDictKeyValues("count", tmpStrCat(count),
+		                       "per_second", (seconds > 0.0) ? (double(count) / seconds) : 0.0);
+		result.addDictKeyValue(name, entry);
+	}
+}
+
+std::string MSXCPU::LoopExitInfoTopic::help(std::span<const TclObject> /*tokens*/) const
+{
+	return "Returns how often (since the last reset) the CPU emulation "
+	       "loop had to stop executing instructions, per cause: "
+	       "'sync_point' (a device needs to be emulated), 'irq' (an IRQ or "
+	       "NMI got raised), 'slow_instructions' (e.g. after EI) and "
+	       "'exit_loop' (e.g. to handle events). For each cause both the "
+	       "total count and the number per emulated second are given.\n";
+}
+
+
 // class CPUFreqInfoTopic
 
 MSXCPU::CPUFreqInfoTopic::CPUFreqInfoTopic(
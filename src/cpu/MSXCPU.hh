@@ -193,6 +193,20 @@ private:
 		[[nodiscard]] std::string help(std::span<const TclObject> tokens) const override;
 	} timeInfo;
 
+	struct IdleInfoTopic final : InfoTopic {
+		explicit IdleInfoTopic(InfoCommand& machineInfoCommand);
+		void execute(std::span<const TclObject> tokens,
+			     TclObject& result) const override;
+		[[nodiscard]] std::string help(std::span<const TclObject> tokens) const override;
+	} idleInfo;
+
+	struct LoopExitInfoTopic final : InfoTopic {
+		explicit LoopExitInfoTopic(InfoCommand& machineInfoCommand);
+		void execute(std::span<const TclObject> tokens,
+			     TclObject& result) const override;
+		[[nodiscard]] std::string help(std::span<const TclObject> tokens) const override;
+	} loopExitInfo;
+
 	class CPUFreqInfoTopic final : public InfoTopic {
 	public:
 		CPUFreqInfoTopic(InfoCommand& machineInfoCommand,
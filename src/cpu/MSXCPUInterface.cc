@@ -1,6 +1,7 @@
 #include "MSXCPUInterface.hh"
 
 #include "BooleanSetting.hh"
+#include "CPURegs.hh"
 #include "CartridgeSlotManager.hh"
 #include "CommandException.hh"
 #include "DeviceFactory.hh"
@@ -73,6 +74,8 @@ std::ostream& operator<<(std::ostream& os, EnumValueName<CacheLineCounters> evn)
 		"FillReadWrite",
 		"FillRead",
 		"FillWrite",
+		"SlowRefillRead",
+		"SlowRefillWrite",
 	};
 	return os << names[size_t(evn.e)];
 }
@@ -99,6 +102,7 @@ MSXCPUInterface::MSXCPUInterface(MSXMotherBoard& motherBoard_)
 	ranges::fill(subSlotRegister, 0);
 	ranges::fill(IO_In,  dummyDevice.get());
 	ranges::fill(IO_Out, dummyDevice.get());
+	for (auto port : xrange(256)) updateIODispatch(narrow_cast<byte>(port));
 	ranges::fill(visibleDevices, dummyDevice.get());
 	for (auto& sub1 : slotLayout) {
 		for (auto& sub2 : sub1) {
@@ -124,6 +128,7 @@ MSXCPUInterface::MSXCPUInterface(MSXMotherBoard& motherBoard_)
 			assert(IO_Out[port] == dummyDevice.get());
 			IO_In [port] = delayDevice.get();
 			IO_Out[port] = delayDevice.get();
+			updateIODispatch(narrow_cast<byte>(port));
 		}
 	}
 
@@ -152,6 +157,7 @@ MSXCPUInterface::~MSXCPUInterface()
 			assert(IO_Out[port] == delayDevice.get());
 			IO_In [port] = dummyDevice.get();
 			IO_Out[port] = dummyDevice.get();
+			updateIODispatch(narrow_cast<byte>(port));
 		}
 	}
 
@@ -204,7 +210,7 @@ byte MSXCPUInterface::readMemSlow(word address, EmuTime::param time)
 		// execute read watches before actual read
 		if (readWatchSet[address >> CacheLine::BITS]
 		                [address &  CacheLine::LOW]) {
-			executeMemWatch(WatchPoint::Type::READ_MEM, address);
+			executeMemWatch(WatchPoint::Type::READ_MEM, time, address);
 		}
 	}
 	if ((address == 0xFFFF) && isExpanded(primarySlotState[3])) [[unlikely]] {
@@ -244,7 +250,7 @@ void MSXCPUInterface::writeMemSlow(word address, byte value, EmuTime::param time
 		motherBoard.getScheduler().schedule(time + EmuDuration::epsilon());
 		if (writeWatchSet[address >> CacheLine::BITS]
 		                 [address &  CacheLine::LOW]) {
-			executeMemWatch(WatchPoint::Type::WRITE_MEM, address, value);
+			executeMemWatch(WatchPoint::Type::WRITE_MEM, time, address, value);
 		}
 	}
 }
@@ -347,28 +353,40 @@ MSXDevice*& MSXCPUInterface::getDevicePtr(byte port, bool isIn)
 	return *devicePtr;
 }
 
+void MSXCPUInterface::updateIODispatch(byte port)
+{
+	auto* in = IO_In[port];
+	ioInDispatch[port] = {in->getIOReadFunc(), in};
+	auto* out = IO_Out[port];
+	ioOutDispatch[port] = {out->getIOWriteFunc(), out};
+}
+
 void MSXCPUInterface::register_IO_In(byte port, MSXDevice* device)
 {
 	MSXDevice*& devicePtr = getDevicePtr(port, true); // in
 	register_IO(port, true, devicePtr, device); // in
+	updateIODispatch(port);
 }
 
 void MSXCPUInterface::unregister_IO_In(byte port, MSXDevice* device)
 {
 	MSXDevice*& devicePtr = getDevicePtr(port, true); // in
 	unregister_IO(devicePtr, device);
+	updateIODispatch(port);
 }
 
 void MSXCPUInterface::register_IO_Out(byte port, MSXDevice* device)
 {
 	MSXDevice*& devicePtr = getDevicePtr(port, false); // out
 	register_IO(port, false, devicePtr, device); // out
+	updateIODispatch(port);
 }
 
 void MSXCPUInterface::unregister_IO_Out(byte port, MSXDevice* device)
 {
 	MSXDevice*& devicePtr = getDevicePtr(port, false); // out
 	unregister_IO(devicePtr, device);
+	updateIODispatch(port);
 }
 
 void MSXCPUInterface::register_IO_InOut(byte port, MSXDevice* device)
@@ -463,6 +481,7 @@ bool MSXCPUInterface::replace_IO_In(
 		return false;
 	}
 	devicePtr = newDevice;
+	updateIODispatch(port);
 	return true;
 }
 bool MSXCPUInterface::replace_IO_Out(
@@ -474,6 +493,7 @@ bool MSXCPUInterface::replace_IO_Out(
 		return false;
 	}
 	devicePtr = newDevice;
+	updateIODispatch(port);
 	return true;
 }
 
@@ -889,6 +909,13 @@ static void registerIOWatch(WatchPoint& watchPoint, std::span<MSXDevice*, 256> d
 	}
 }
 
+void MSXCPUInterface::updateIODispatch(const WatchPoint& watchPoint)
+{
+	for (auto port : xrange(watchPoint.getBeginAddress(), watchPoint.getEndAddress() + 1)) {
+		updateIODispatch(narrow<byte>(port));
+	}
+}
+
 void MSXCPUInterface::setWatchPoint(const std::shared_ptr<WatchPoint>& watchPoint)
 {
 	cliComm.update(CliComm::UpdateType::DEBUG_UPDT, tmpStrCat("wp#", watchPoint->getId()), "add");
@@ -898,9 +925,11 @@ void MSXCPUInterface::setWatchPoint(const std::shared_ptr<WatchPoint>& watchPoin
 	using enum WatchPoint::Type;
 	case READ_IO:
 		registerIOWatch(*watchPoint, IO_In);
+		updateIODispatch(*watchPoint);
 		break;
 	case WRITE_IO:
 		registerIOWatch(*watchPoint, IO_Out);
+		updateIODispatch(*watchPoint);
 		break;
 	case READ_MEM:
 	case WRITE_MEM:
@@ -945,9 +974,11 @@ void MSXCPUInterface::removeWatchPoint(std::shared_ptr<WatchPoint> watchPoint)
 		using enum WatchPoint::Type;
 		case READ_IO:
 			unregisterIOWatch(*watchPoint, IO_In);
+			updateIODispatch(*watchPoint);
 			break;
 		case WRITE_IO:
 			unregisterIOWatch(*watchPoint, IO_Out);
+			updateIODispatch(*watchPoint);
 			break;
 		case READ_MEM:
 		case WRITE_MEM:
@@ -1024,12 +1055,40 @@ void MSXCPUInterface::updateMemWatch(WatchPoint::Type type)
 	msxcpu.invalidateAllSlotsRWCache(0x0000, 0x10000);
 }
 
-void MSXCPUInterface::executeMemWatch(WatchPoint::Type type,
+void MSXCPUInterface::executeMemWatch(WatchPoint::Type type, EmuTime::param time,
                                       unsigned address, unsigned value)
 {
 	assert(!watchPoints.empty());
 	if (isFastForward()) return;
 
+	auto matches = [&](const WatchPoint& w) {
+		return (w.getBeginAddress() <= address) &&
+		       (w.getEndAddress()   >= address) &&
+		       (w.getType()         == type);
+	};
+
+	// First execute the native actions, these don't need the Tcl
+	// interpreter (so also no need to set the 'wp_last_*' variables).
+	bool needTcl = false;
+	bool removeOnce = false;
+	for (const auto& w : watchPoints) {
+		if (!matches(*w)) continue;
+		if (const auto& action = w->getAction()) {
+			action->execute(time, address, value, msxcpu.getRegisters().getPC());
+			removeOnce |= w->onlyOnce();
+		} else {
+			needTcl = true;
+		}
+	}
+	if (removeOnce) {
+		for (auto wpCopy = watchPoints; auto& w : wpCopy) {
+			if (matches(*w) && w->getAction() && w->onlyOnce()) {
+				removeWatchPoint(w);
+			}
+		}
+	}
+	if (!needTcl) return;
+
 	auto& globalCliComm = motherBoard.getReactor().getGlobalCliComm();
 	auto& interp        = motherBoard.getReactor().getInterpreter();
 	interp.setVariable(TclObject("wp_last_address"),
@@ -1040,10 +1099,8 @@ void MSXCPUInterface::executeMemWatch(WatchPoint::Type type,
 	}
 
 	auto scopedBlock = motherBoard.getStateChangeDistributor().tempBlockNewEventsDuringReplay();
-	for( auto wpCopy = watchPoints; auto& w : wpCopy) {
-		if ((w->getBeginAddress() <= address) &&
-		    (w->getEndAddress()   >= address) &&
-		    (w->getType()         == type)) {
+	for (auto wpCopy = watchPoints; auto& w : wpCopy) {
+		if (matches(*w) && !w->getAction()) {
 			bool remove = w->checkAndExecute(globalCliComm, interp);
 			if (remove) {
 				removeWatchPoint(w);
@@ -48,6 +48,8 @@ enum class CacheLineCounters {
 	FillReadWrite,
 	FillRead,
 	FillWrite,
+	SlowRefillRead,  // a not-yet-filled line got filled via the CPU slow path
+	SlowRefillWrite, // idem for writes
 	NUM // must be last
 };
 std::ostream& operator<<(std::ostream& os, EnumTypeName<CacheLineCounters>);
@@ -165,7 +167,8 @@ public:
 	 * @see MSXDevice::readIO()
 	 */
 	byte readIO(word port, EmuTime::param time) {
-		return IO_In[port & 0xFF]->readIO(port, time);
+		const auto& h = ioInDispatch[port & 0xFF];
+		return h.func(*h.device, port, time);
 	}
 
 	/**
@@ -173,7 +176,8 @@ public:
 	 * @see MSXDevice::writeIO()
 	 */
 	void writeIO(word port, byte value, EmuTime::param time) {
-		IO_Out[port & 0xFF]->writeIO(port, value, time);
+		const auto& h = ioOutDispatch[port & 0xFF];
+		h.func(*h.device, port, value, time);
 	}
 
 	/**
@@ -320,6 +324,8 @@ private:
 	void writeMemSlow(word address, byte value, EmuTime::param time);
 
 	MSXDevice*& getDevicePtr(byte port, bool isIn);
+	void updateIODispatch(byte port);
+	void updateIODispatch(const WatchPoint& watchPoint);
 
 	void register_IO  (int port, bool isIn,
 	                   MSXDevice*& devicePtr, MSXDevice* device);
@@ -337,8 +343,8 @@ private:
 
 	void removeAllWatchPoints();
 	void updateMemWatch(WatchPoint::Type type);
-	void executeMemWatch(WatchPoint::Type type, unsigned address,
-	                     unsigned value = ~0u);
+	void executeMemWatch(WatchPoint::Type type, EmuTime::param time,
+	                     unsigned address, unsigned value = ~0u);
 
 	struct MemoryDebug final : SimpleDebuggable {
 		explicit MemoryDebug(MSXMotherBoard& motherBoard);
@@ -433,6 +439,23 @@ private:
 
 	std::array<MSXDevice*, 256> IO_In;
 	std::array<MSXDevice*, 256> IO_Out;
+	// First level of the I/O dispatch: a copy of the (non-virtual) I/O
+	// handler of the devices in IO_In/IO_Out. This avoids a virtual call
+	// (and loading the vtable pointer from the device) for each I/O access.
+	// The second level are the devices that combine multiple devices
+	// (MSXMultiIODevice, VDPIODelay), they call the handlers of the
+	// combined devices directly. Must be updated (updateIODispatch())
+	// whenever IO_In or IO_Out (or anything reachable from it) changes.
+	struct IOInHandler {
+		MSXDevice::IOReadFunc func;
+		MSXDevice* device;
+	};
+	struct IOOutHandler {
+		MSXDevice::IOWriteFunc func;
+		MSXDevice* device;
+	};
+	std::array<IOInHandler,  256> ioInDispatch;
+	std::array<IOOutHandler, 256> ioOutDispatch;
 	std::array<std::array<std::array<MSXDevice*, 4>, 4>, 4> slotLayout;
 	std::array<MSXDevice*, 4> visibleDevices;
 	std::array<byte, 4> subSlotRegister;
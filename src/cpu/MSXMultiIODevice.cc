@@ -9,6 +9,7 @@ namespace openmsx {
 MSXMultiIODevice::MSXMultiIODevice(const HardwareConfig& hwConf)
 	: MSXMultiDevice(hwConf)
 {
+	setFastIOHandlers<MSXMultiIODevice>();
 }
 
 MSXMultiIODevice::~MSXMultiIODevice()
@@ -54,8 +55,8 @@ byte MSXMultiIODevice::readIO(word port, EmuTime::param time)
 	//           so a logical AND over the read values most accurately
 	//           resembles what real hardware does.
 	byte result = 0xFF;
-	for (auto& dev : devices) {
-		result &= dev->readIO(port, time);
+	for (auto* dev : devices) {
+		result &= dev->getIOReadFunc()(*dev, port, time);
 	}
 	return result;
 }
@@ -72,8 +73,8 @@ byte MSXMultiIODevice::peekIO(word port, EmuTime::param time) const
 
 void MSXMultiIODevice::writeIO(word port, byte value, EmuTime::param time)
 {
-	for (auto& dev : devices) {
-		dev->writeIO(port, value, time);
+	for (auto* dev : devices) {
+		dev->getIOWriteFunc()(*dev, port, value, time);
 	}
 }
 
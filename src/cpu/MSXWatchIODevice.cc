@@ -1,6 +1,8 @@
 #include "MSXWatchIODevice.hh"
 
+#include "CPURegs.hh"
 #include "Interpreter.hh"
+#include "MSXCPU.hh"
 #include "MSXCPUInterface.hh"
 #include "MSXMotherBoard.hh"
 #include "Reactor.hh"
@@ -20,8 +22,10 @@ WatchIO::WatchIO(MSXMotherBoard& motherboard_,
                  WatchPoint::Type type_,
                  unsigned beginAddr_, unsigned endAddr_,
                  TclObject command_, TclObject condition_,
-                 bool once_, unsigned newId /*= -1*/)
-	: WatchPoint(std::move(command_), std::move(condition_), type_, beginAddr_, endAddr_, once_, newId)
+                 bool once_, std::shared_ptr<WatchAction> action_,
+                 unsigned newId /*= -1*/)
+	: WatchPoint(std::move(command_), std::move(condition_), type_, beginAddr_, endAddr_,
+	             once_, std::move(action_), newId)
 	, motherboard(motherboard_)
 {
 	for (unsigned i = narrow_cast<byte>(beginAddr_); i <= narrow_cast<byte>(endAddr_); ++i) {
@@ -36,11 +40,16 @@ MSXWatchIODevice& WatchIO::getDevice(byte port)
 	return *ios[port - begin];
 }
 
-void WatchIO::doReadCallback(unsigned port)
+void WatchIO::doReadCallback(unsigned port, EmuTime::param time)
 {
 	auto& cpuInterface = motherboard.getCPUInterface();
 	if (cpuInterface.isFastForward()) return;
 
+	if (getAction()) {
+		executeAction(port, ~0u, time);
+		return;
+	}
+
 	auto& cliComm = motherboard.getReactor().getGlobalCliComm();
 	auto& interp  = motherboard.getReactor().getInterpreter();
 	interp.setVariable(TclObject("wp_last_address"), TclObject(int(port)));
@@ -56,11 +65,16 @@ void WatchIO::doReadCallback(unsigned port)
 	interp.unsetVariable("wp_last_address");
 }
 
-void WatchIO::doWriteCallback(unsigned port, unsigned value)
+void WatchIO::doWriteCallback(unsigned port, unsigned value, EmuTime::param time)
 {
 	auto& cpuInterface = motherboard.getCPUInterface();
 	if (cpuInterface.isFastForward()) return;
 
+	if (getAction()) {
+		executeAction(port, value, time);
+		return;
+	}
+
 	auto& cliComm = motherboard.getReactor().getGlobalCliComm();
 	auto& interp  = motherboard.getReactor().getInterpreter();
 	interp.setVariable(TclObject("wp_last_address"), TclObject(int(port)));
@@ -77,6 +91,17 @@ void WatchIO::doWriteCallback(unsigned port, unsigned value)
 	interp.unsetVariable("wp_last_value");
 }
 
+void WatchIO::executeAction(unsigned port, unsigned value, EmuTime::param time)
+{
+	// native action: no need to go through the Tcl interpreter
+	// the high byte of 'port' is the content of register A or B
+	auto pc = motherboard.getCPU().getRegisters().getPC();
+	getAction()->execute(time, port & 0xFF, value, pc);
+	if (onlyOnce()) {
+		motherboard.getCPUInterface().removeWatchPoint(shared_from_this());
+	}
+}
+
 
 // class MSXWatchIODevice
 
@@ -104,7 +129,7 @@ byte MSXWatchIODevice::readIO(word port, EmuTime::param time)
 	assert(device);
 
 	// first trigger watchpoint, then read from device
-	watchIO.doReadCallback(port);
+	watchIO.doReadCallback(port, time);
 	return device->readIO(port, time);
 }
 
@@ -114,7 +139,7 @@ void MSXWatchIODevice::writeIO(word port, byte value, EmuTime::param time)
 
 	// first write to device, then trigger watchpoint
 	device->writeIO(port, value, time);
-	watchIO.doWriteCallback(port, value);
+	watchIO.doWriteCallback(port, value, time);
 }
 
 } // namespace openmsx
@@ -17,13 +17,15 @@ public:
 	        WatchPoint::Type type,
 	        unsigned beginAddr, unsigned endAddr,
 	        TclObject command, TclObject condition,
-	        bool once, unsigned newId = -1);
+	        bool once, std::shared_ptr<WatchAction> action = {},
+	        unsigned newId = -1);
 
 	MSXWatchIODevice& getDevice(byte port);
 
 private:
-	void doReadCallback(unsigned port);
-	void doWriteCallback(unsigned port, unsigned value);
+	void doReadCallback(unsigned port, EmuTime::param time);
+	void doWriteCallback(unsigned port, unsigned value, EmuTime::param time);
+	void executeAction(unsigned port, unsigned value, EmuTime::param time);
 
 private:
 	MSXMotherBoard& motherboard;
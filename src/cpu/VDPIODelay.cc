@@ -12,6 +12,7 @@ VDPIODelay::VDPIODelay(const DeviceConfig& config, MSXCPUInterface& cpuInterface
 	: MSXDevice(config)
 	, cpu(getCPU()) // used frequently, so cache it
 {
+	setFastIOHandlers<VDPIODelay>();
 	for (auto port : xrange(byte(0x98), byte(0x9c))) {
 		getInDevicePtr (port) = &cpuInterface.getDummyDevice();
 		getOutDevicePtr(port) = &cpuInterface.getDummyDevice();
@@ -39,7 +40,8 @@ MSXDevice*& VDPIODelay::getOutDevicePtr(byte port)
 byte VDPIODelay::readIO(word port, EmuTime::param time)
 {
 	delay(time);
-	return getInDevicePtr(byte(port))->readIO(byte(port), lastTime.getTime());
+	auto* dev = getInDevicePtr(byte(port));
+	return dev->getIOReadFunc()(*dev, byte(port), lastTime.getTime());
 }
 
 byte VDPIODelay::peekIO(word port, EmuTime::param time) const
@@ -50,7 +52,8 @@ byte VDPIODelay::peekIO(word port, EmuTime::param time) const
 void VDPIODelay::writeIO(word port, byte value, EmuTime::param time)
 {
 	delay(time);
-	getOutDevicePtr(byte(port))->writeIO(byte(port), value, lastTime.getTime());
+	auto* dev = getOutDevicePtr(byte(port));
+	dev->getIOWriteFunc()(*dev, byte(port), value, lastTime.getTime());
 }
 
 void VDPIODelay::delay(EmuTime::param time)
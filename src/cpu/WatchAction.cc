@@ -0,0 +1,129 @@
+#include "WatchAction.hh"
+
+#include "CommandException.hh"
+#include "Interpreter.hh"
+
+#include "narrow.hh"
+#include "strCat.hh"
+#include "xrange.hh"
+
+#include <bit>
+#include <cstdio>
+#include <span>
+
+namespace openmsx {
+
+WatchAction::WatchAction(Interpreter& interp, const TclObject& spec_,
+                         unsigned beginAddr_, unsigned endAddr, bool isRead)
+	: spec(spec_), beginAddr(beginAddr_)
+{
+	auto len = spec.getListLength(interp);
+	if (len == 0) {
+		throw CommandException("Missing watchpoint action");
+	}
+	auto name = spec.getListIndex(interp, 0).getString();
+	if (name == "count") {
+		if (len != 1) throw SyntaxError();
+		kind = Kind::COUNT;
+	} else if (name == "histogram") {
+		if (len > 2) throw SyntaxError();
+		auto key = (len == 2) ? spec.getListIndex(interp, 1).getString()
+		                      : zstring_view(isRead ? "address" : "value");
+		if (key == "value") {
+			if (isRead) {
+				throw CommandException(
+					"Can't make a histogram of values for a read "
+					"watchpoint, the value isn't known before the read");
+			}
+			kind = Kind::HISTOGRAM_VALUE;
+			histogram.resize(256);
+		} else if (key == "address") {
+			kind = Kind::HISTOGRAM_ADDRESS;
+			histogram.resize(endAddr - beginAddr + 1);
+		} else {
+			throw CommandException(
+				"Unknown histogram key '", key,
+				"', should be 'value' or 'address'");
+		}
+	} else if (name == "log") {
+		if (len > 2) throw SyntaxError();
+		kind = Kind::LOG;
+		if (len == 1) {
+			log.set_capacity(MAX_LOG_RECORDS);
+		} else {
+			auto filename = FileOperations::expandTilde(
+				std::string(spec.getListIndex(interp, 1).getString()));
+			file = FileOperations::openFile(filename, "wb");
+			if (!file) {
+				throw CommandException("Couldn't open log file: ", filename);
+			}
+		}
+	} else {
+		throw CommandException(
+			"Unknown watchpoint action '", name,
+			"', should be one of 'count', 'histogram' or 'log'");
+	}
+}
+
+void WatchAction::execute(EmuTime::param time, unsigned address, unsigned value, unsigned pc)
+{
+	++count;
+	switch (kind) {
+	case Kind::COUNT:
+		break;
+	case Kind::HISTOGRAM_VALUE:
+		++histogram[value & 0xFF];
+		break;
+	case Kind::HISTOGRAM_ADDRESS:
+		if ((beginAddr <= address) && (address - beginAddr) < histogram.size()) {
+			++histogram[address - beginAddr];
+		}
+		break;
+	case Kind::LOG: {
+		LogRecord record;
+		record.time = (time - EmuTime::zero()).length();
+		record.address = narrow_cast<uint16_t>(address);
+		record.value = (value == ~0u) ? NO_VALUE : narrow_cast<uint16_t>(value);
+		record.pc = narrow_cast<uint16_t>(pc);
+		record.reserved = 0;
+		if (file) {
+			// stdio buffering keeps this cheap
+			(void)fwrite(&record, sizeof(record), 1, file.get());
+		} else {
+			if (log.full()) log.pop_front();
+			log.push_back(record);
+		}
+		break;
+	}
+	}
+}
+
+TclObject WatchAction::getData()
+{
+	switch (kind) {
+	case Kind::HISTOGRAM_VALUE:
+	case Kind::HISTOGRAM_ADDRESS: {
+		auto offset = (kind == Kind::HISTOGRAM_ADDRESS) ? beginAddr : 0;
+		auto result = makeTclDict();
+		for (auto i : xrange(histogram.size())) {
+			if (auto n = histogram[i]) {
+				result.addDictKeyValue(int(i + offset), tmpStrCat(n));
+			}
+		}
+		return result;
+	}
+	case Kind::LOG:
+		if (!file) {
+			std::vector<LogRecord> records(log.begin(), log.end());
+			return TclObject(std::span{std::bit_cast<const uint8_t*>(records.data()),
+			                           records.size() * sizeof(LogRecord)});
+		}
+		fflush(file.get());
+		[[fallthrough]];
+	case Kind::COUNT:
+	default:
+		return TclObject(tmpStrCat(count));
+	}
+}
+
+} // namespace openmsx
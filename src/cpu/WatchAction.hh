@@ -0,0 +1,80 @@
+#ifndef WATCHACTION_HH
+#define WATCHACTION_HH
+
+#include "EmuTime.hh"
+#include "FileOperations.hh"
+#include "TclObject.hh"
+
+#include "circular_buffer.hh"
+#include "endian.hh"
+
+#include <cstdint>
+#include <vector>
+
+namespace openmsx {
+
+class Interpreter;
+
+/** A built-in action for a watchpoint. Unlike the Tcl command of a watchpoint
+  * this is executed without entering the Tcl interpreter, so it's cheap
+  * enough to e.g. log every write to a sound chip.
+  *
+  * Possible actions (the specification is a Tcl list):
+  *   count                     count the number of accesses
+  *   histogram ?value|address? count the accesses per value (the default for
+  *                             write watchpoints) or per address (the default
+  *                             for read watchpoints, the value is not known
+  *                             before a read)
+  *   log ?<filename>?          append a LogRecord per access, either to a
+  *                             (binary) file or, when no filename is given,
+  *                             to an in-memory log (that only keeps the most
+  *                             recent MAX_LOG_RECORDS records)
+  */
+class WatchAction
+{
+public:
+	/** The format of one entry in the binary log. */
+	struct LogRecord {
+		Endian::L64 time;    // EmuTime, in units of 1/MAIN_FREQ seconds
+		Endian::L16 address;
+		Endian::L16 value;   // NO_VALUE for reads
+		Endian::L16 pc;
+		Endian::L16 reserved;
+	};
+	static_assert(sizeof(LogRecord) == 16);
+	static constexpr uint16_t NO_VALUE = 0xFFFF;
+	static constexpr size_t MAX_LOG_RECORDS = 1 << 20; // 16MB
+
+	/** Parse the given specification, throws CommandException on error.
+	  * The address range and the read/write type of the watchpoint are
+	  * needed to validate and size the histogram.
+	  */
+	WatchAction(Interpreter& interp, const TclObject& spec,
+	            unsigned beginAddr, unsigned endAddr, bool isRead);
+
+	/** Execute the action for one access. For reads 'value' is ~0u. */
+	void execute(EmuTime::param time, unsigned address, unsigned value, unsigned pc);
+
+	[[nodiscard]] const TclObject& getSpec() const { return spec; }
+
+	/** The collected data: the count (for 'count' and for 'log' to a file),
+	  * a dictionary with the non-zero histogram bins, or the in-memory log
+	  * as a byte array of LogRecords.
+	  */
+	[[nodiscard]] TclObject getData();
+
+private:
+	enum class Kind : uint8_t { COUNT, HISTOGRAM_VALUE, HISTOGRAM_ADDRESS, LOG };
+
+	TclObject spec;
+	Kind kind;
+	unsigned beginAddr;
+	uint64_t count = 0;
+	std::vector<uint64_t> histogram;
+	circular_buffer<LogRecord> log;
+	FileOperations::FILE_t file; // only for 'log <filename>'
+};
+
+} // namespace openmsx
+
+#endif
@@ -2,7 +2,9 @@
 #define WATCHPOINT_HH
 
 #include "BreakPointBase.hh"
+#include "WatchAction.hh"
 #include <cassert>
+#include <memory>
 
 namespace openmsx {
 
@@ -16,11 +18,15 @@ public:
 	enum class Type { READ_IO, WRITE_IO, READ_MEM, WRITE_MEM };
 
 	/** Begin and end address are inclusive (IOW range = [begin, end])
+	 * A watchpoint with a (native) action executes that action instead of
+	 * a Tcl command, it then has no condition or command.
 	 */
 	WatchPoint(TclObject command_, TclObject condition_,
 	           Type type_, unsigned beginAddr_, unsigned endAddr_,
-	           bool once_, unsigned newId = -1)
+	           bool once_, std::shared_ptr<WatchAction> action_ = {},
+	           unsigned newId = -1)
 		: BreakPointBase(std::move(command_), std::move(condition_), once_)
+		, action(std::move(action_))
 		, id((newId == unsigned(-1)) ? ++lastId : newId)
 		, beginAddr(beginAddr_), endAddr(endAddr_), type(type_)
 	{
@@ -33,8 +39,11 @@ public:
 	[[nodiscard]] Type     getType()         const { return type; }
 	[[nodiscard]] unsigned getBeginAddress() const { return beginAddr; }
 	[[nodiscard]] unsigned getEndAddress()   const { return endAddr; }
+	/** Shared, so that the collected data survives a machine switch. */
+	[[nodiscard]] const std::shared_ptr<WatchAction>& getAction() const { return action; }
 
 private:
+	std::shared_ptr<WatchAction> action; // can be nullptr
 	unsigned id;
 	unsigned beginAddr;
 	unsigned endAddr;
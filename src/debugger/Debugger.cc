@@ -16,6 +16,7 @@
 #include "SymbolManager.hh"
 #include "TclArgParser.hh"
 #include "TclObject.hh"
+#include "WatchAction.hh"
 
 #include "MemBuffer.hh"
 #include "StringOp.hh"
@@ -30,6 +31,7 @@
 #include <array>
 #include <cassert>
 #include <memory>
+#include <optional>
 
 using std::string;
 using std::string_view;
@@ -157,16 +159,19 @@ void Debugger::removeProbeBreakPoint(ProbeBreakPoint& bp)
 unsigned Debugger::setWatchPoint(TclObject command, TclObject condition,
                                  WatchPoint::Type type,
                                  unsigned beginAddr, unsigned endAddr,
-                                 bool once, unsigned newId /*= -1*/)
+                                 bool once, std::shared_ptr<WatchAction> action,
+                                 unsigned newId /*= -1*/)
 {
 	std::shared_ptr<WatchPoint> wp;
 	if (type == one_of(WatchPoint::Type::READ_IO, WatchPoint::Type::WRITE_IO)) {
 		wp = std::make_shared<WatchIO>(
 			motherBoard, type, beginAddr, endAddr,
-			std::move(command), std::move(condition), once, newId);
+			std::move(command), std::move(condition), once,
+			std::move(action), newId);
 	} else {
 		wp = std::make_shared<WatchPoint>(
-			std::move(command), std::move(condition), type, beginAddr, endAddr, once, newId);
+			std::move(command), std::move(condition), type, beginAddr, endAddr,
+			once, std::move(action), newId);
 	}
 	motherBoard.getCPUInterface().setWatchPoint(wp);
 	return wp->getId();
@@ -180,7 +185,7 @@ void Debugger::transfer(Debugger& other)
 		setWatchPoint(wp->getCommand(),    wp->getCondition(),
 		              wp->getType(),       wp->getBeginAddress(),
 		              wp->getEndAddress(), wp->onlyOnce(),
-		              wp->getId());
+		              wp->getAction(),     wp->getId());
 	}
 
 	// Copy probes to new machine.
@@ -252,6 +257,7 @@ void Debugger::Cmd::execute(
 		"set_watchpoint",    [&]{ setWatchPoint(tokens, result); },
 		"remove_watchpoint", [&]{ removeWatchPoint(tokens, result); },
 		"list_watchpoints",  [&]{ listWatchPoints(tokens, result); },
+		"watchpoint_data",   [&]{ watchPointData(tokens, result); },
 		"set_condition",     [&]{ setCondition(tokens, result); },
 		"remove_condition",  [&]{ removeCondition(tokens, result); },
 		"list_conditions",   [&]{ listConditions(tokens, result); },
@@ -481,18 +487,23 @@ void Debugger::Cmd::listBreakPoints(std::span<const TclObject> /*tokens*/, TclOb
 
 void Debugger::Cmd::setWatchPoint(std::span<const TclObject> tokens, TclObject& result)
 {
-	checkNumArgs(tokens, AtLeast{4}, Prefix{2}, "type address ?-once? ?condition? ?command?");
+	checkNumArgs(tokens, AtLeast{4}, Prefix{2}, "type address ?-once? ?-action spec? ?condition? ?command?");
 	TclObject command("debug break");
 	TclObject condition;
 	unsigned beginAddr, endAddr;
 	WatchPoint::Type type;
 	bool once = false;
+	std::optional<TclObject> actionSpec;
 
-	std::array info = {flagArg("-once", once)};
+	std::array info = {flagArg("-once", once), valueArg("-action", actionSpec)};
 	auto arguments = parseTclArgs(getInterpreter(), tokens.subspan(2), info);
 	if ((arguments.size() < 2) || (arguments.size() > 4)) {
 		throw SyntaxError();
 	}
+	if (actionSpec && (arguments.size() > 2)) {
+		throw CommandException(
+			"A watchpoint with an -action can't have a condition or command");
+	}
 
 	switch (arguments.size()) {
 	case 4: // command
@@ -541,8 +552,16 @@ void Debugger::Cmd::setWatchPoint(std::span<const TclObject> tokens, TclObject&
 	default:
 		UNREACHABLE;
 	}
+	std::shared_ptr<WatchAction> action;
+	if (actionSpec) {
+		using enum WatchPoint::Type;
+		bool isRead = type == one_of(READ_IO, READ_MEM);
+		action = std::make_shared<WatchAction>(
+			getInterpreter(), *actionSpec, beginAddr, endAddr, isRead);
+		command = TclObject();
+	}
 	unsigned id = debugger().setWatchPoint(
-		command, condition, type, beginAddr, endAddr, once);
+		command, condition, type, beginAddr, endAddr, once, std::move(action));
 	result = tmpStrCat("wp#", id);
 }
 
@@ -603,11 +622,37 @@ void Debugger::Cmd::listWatchPoints(
 		}
 		line.addListElement(wp->getCondition(),
 		                    wp->getCommand());
+		if (const auto& action = wp->getAction()) {
+			line.addListElement(action->getSpec());
+		}
 		strAppend(res, line.getString(), '\n');
 	}
 	result = res;
 }
 
+void Debugger::Cmd::watchPointData(
+	std::span<const TclObject> tokens, TclObject& result)
+{
+	checkNumArgs(tokens, 3, "id");
+	string_view tmp = tokens[2].getString();
+	if (tmp.starts_with("wp#")) {
+		if (auto id = StringOp::stringToBase<10, unsigned>(tmp.substr(3))) {
+			const auto& interface = debugger().motherBoard.getCPUInterface();
+			for (const auto& wp : interface.getWatchPoints()) {
+				if (wp->getId() != *id) continue;
+				const auto& action = wp->getAction();
+				if (!action) {
+					throw CommandException(
+						"Watchpoint ", tmp, " has no -action");
+				}
+				result = action->getData();
+				return;
+			}
+		}
+	}
+	throw CommandException("No such watchpoint: ", tmp);
+}
+
 
 void Debugger::Cmd::setCondition(std::span<const TclObject> tokens, TclObject& result)
 {
@@ -849,6 +894,7 @@ string Debugger::Cmd::help(std::span<const TclObject> tokens) const
 		"    set_watchpoint    insert a new watchpoint\n"
 		"    remove_watchpoint remove a certain watchpoint\n"
 		"    list_watchpoints  list the active watchpoints\n"
+		"    watchpoint_data   query the data collected by a watchpoint action\n"
 		"    set_condition     insert a new condition\n"
 		"    remove_condition  remove a certain condition\n"
 		"    list_conditions   list the active conditions\n"
@@ -936,7 +982,7 @@ string Debugger::Cmd::help(std::span<const TclObject> tokens) const
 		"(default condition is empty). And the last column contains "
 		"the command that will be executed (default is 'debug break').\n";
 	auto setWatchPointHelp =
-		"debug set_watchpoint [-once] <type> <region> [<cond>] [<cmd>]\n"
+		"debug set_watchpoint [-once] [-action <action>] <type> <region> [<cond>] [<cmd>]\n"
 		"  Insert a new watchpoint of given type on the given region, "
 		"there can be an optional -once flag, a condition and alternative "
 		"command. See the 'set_bp' subcommand for details about these.\n"
@@ -955,9 +1001,23 @@ string Debugger::Cmd::help(std::span<const TclObject> tokens) const
 		"read/write that triggered the watchpoint\n"
 		"  ::wp_last_value     this is the actual value that was written "
 		"by the mem/io write that triggered the watchpoint\n"
+		"Instead of a condition and command there can be an -action. "
+		"Such an action is executed without going through Tcl, so it "
+		"has much less overhead. Use the 'watchpoint_data' subcommand "
+		"to query the collected data. Possible actions are:\n"
+		"  count                     count the number of accesses\n"
+		"  histogram [value|address] count the accesses per written value "
+		"(default for write watchpoints) or per address (default for read "
+		"watchpoints)\n"
+		"  log [<filename>]          log each access as a 16-byte record: "
+		"the EmuTime in ticks (64-bit), the address, the value (0xffff for "
+		"reads), the CPU program counter and 2 reserved bytes (all 16-bit), "
+		"little endian. Either to the given file, or to memory (then only "
+		"the most recent 1048576 records are kept)\n"
 		"Examples:\n"
 		"  debug set_watchpoint write_io 0x99 {[reg A] == 0x81}\n"
-		"  debug set_watchpoint read_mem {0xfbe5 0xfbef}\n";
+		"  debug set_watchpoint read_mem {0xfbe5 0xfbef}\n"
+		"  debug set_watchpoint -action {log psg.log} write_io {0xa0 0xa1}\n";
 	auto removeWatchPointHelp =
 		"debug remove_watchpoint <id>\n"
 		"  Remove the watchpoint with given ID again. You can use the "
@@ -966,7 +1026,15 @@ string Debugger::Cmd::help(std::span<const TclObject> tokens) const
 		"debug list_watchpoints\n"
 		"  Lists all active watchpoints. The result is similar to the "
 		"'list_bp' subcommand, but there is an extra column (2nd column) "
-		"that contains the type of the watchpoint.\n";
+		"that contains the type of the watchpoint. Watchpoints with an "
+		"-action have an additional last column with that action.\n";
+	auto watchPointDataHelp =
+		"debug watchpoint_data <id>\n"
+		"  Returns the data collected by the -action of the watchpoint "
+		"with given ID. For 'count' and for 'log' to a file this is the "
+		"number of accesses, for 'histogram' a dictionary with the "
+		"(non-zero) count per value or address and for 'log' to memory "
+		"a binary string with the (at most 1048576) most recent records.\n";
 	auto setCondHelp =
 		"debug set_condition [-once] <cond> [<cmd>]\n"
 		"  Insert a new condition. These are much like breakpoints, "
@@ -1074,6 +1142,8 @@ string Debugger::Cmd::help(std::span<const TclObject> tokens) const
 		return removeWatchPointHelp;
 	} else if (tokens[1] == "list_watchpoints") {
 		return listWatchPointsHelp;
+	} else if (tokens[1] == "watchpoint_data") {
+		return watchPointDataHelp;
 	} else if (tokens[1] == "set_condition") {
 		return setCondHelp;
 	} else if (tokens[1] == "remove_condition") {
@@ -1133,7 +1203,7 @@ void Debugger::Cmd::tabCompletion(std::vector<string>& tokens) const
 	};
 	static constexpr std::array otherCmds = {
 		"disasm"sv, "disasm_blob"sv, "set_bp"sv, "remove_bp"sv, "set_watchpoint"sv,
-		"remove_watchpoint"sv, "set_condition"sv, "remove_condition"sv,
+		"remove_watchpoint"sv, "watchpoint_data"sv, "set_condition"sv, "remove_condition"sv,
 		"probe"sv, "symbols"sv,
 	};
 	switch (tokens.size()) {
@@ -1150,7 +1220,7 @@ void Debugger::Cmd::tabCompletion(std::vector<string>& tokens) const
 			} else if (tokens[1] == "remove_bp") {
 				// this one takes a bp id
 				completeString(tokens, getBreakPointIds());
-			} else if (tokens[1] == "remove_watchpoint") {
+			} else if (tokens[1] == one_of("remove_watchpoint", "watchpoint_data")) {
 				// this one takes a wp id
 				completeString(tokens, getWatchPointIds());
 			} else if (tokens[1] == "remove_condition") {
@@ -44,7 +44,8 @@ public:
 	unsigned setWatchPoint(TclObject command, TclObject condition,
 	                       WatchPoint::Type type,
 	                       unsigned beginAddr, unsigned endAddr,
-	                       bool once, unsigned newId = -1);
+	                       bool once, std::shared_ptr<WatchAction> action = {},
+	                       unsigned newId = -1);
 
 	void removeProbeBreakPoint(ProbeBreakPoint& bp);
 	void setCPU(MSXCPU* cpu_) { cpu = cpu_; }
@@ -97,6 +98,7 @@ private:
 		void setWatchPoint(std::span<const TclObject> tokens, TclObject& result);
 		void removeWatchPoint(std::span<const TclObject> tokens, TclObject& result);
 		void listWatchPoints(std::span<const TclObject> tokens, TclObject& result);
+		void watchPointData(std::span<const TclObject> tokens, TclObject& result);
 		void setCondition(std::span<const TclObject> tokens, TclObject& result);
 		void removeCondition(std::span<const TclObject> tokens, TclObject& result);
 		void listConditions(std::span<const TclObject> tokens, TclObject& result) const;
@@ -118,6 +118,40 @@ using AllAfterCmds = std::variant<AfterTimeCmd,
                                   AfterRealTimeCmd>;
 static ObjectPool<AllAfterCmds> afterCmdPool;
 
+[[nodiscard]] static unsigned getId(AfterCommand::Index idx)
+{
+	return std::visit([](const AfterCmd& cmd) { return cmd.getId(); },
+	                  afterCmdPool[idx]);
+}
+
+// Pending commands sorted by id, so in the order they were created.
+[[nodiscard]] static auto getSortedCmds(const hash_map<unsigned, AfterCommand::Index>& afterCmds)
+{
+	auto result = to_vector<std::pair<unsigned, AfterCommand::Index>>(afterCmds);
+	ranges::sort(result, {}, [](const auto& p) { return p.first; });
+	return result;
+}
+
+[[nodiscard]] static size_t simpleEventSlot(EventType type)
+{
+	switch (type) {
+		using enum EventType;
+		case FINISH_FRAME:   return 0;
+		case BREAK:          return 1;
+		case QUIT:           return 2;
+		case BOOT:           return 3;
+		case MACHINE_LOADED: return 4;
+		default: UNREACHABLE;
+	}
+}
+
+static void eraseIdx(std::vector<AfterCommand::Index>& cmds, AfterCommand::Index idx)
+{
+	if (auto it = ranges::find(cmds, idx); it != end(cmds)) {
+		cmds.erase(it);
+	}
+}
+
 
 AfterCommand::AfterCommand(Reactor& reactor_,
                            EventDistributor& eventDistributor_,
@@ -139,7 +173,7 @@ AfterCommand::AfterCommand(Reactor& reactor_,
 
 AfterCommand::~AfterCommand()
 {
-	for (auto idx : afterCmds) {
+	for (const auto& [id, idx] : afterCmds) {
 		afterCmdPool.remove(idx);
 	}
 
@@ -215,7 +249,7 @@ void AfterCommand::afterTime(std::span<const TclObject> tokens, TclObject& resul
 		std::in_place_type_t<AfterTimeCmd>{},
 		motherBoard->getScheduler(), *this, tokens[3], time);
 	result = std::get<AfterTimeCmd>(*ptr).getIdStr();
-	afterCmds.push_back(idx);
+	add(idx);
 }
 
 void AfterCommand::afterRealTime(std::span<const TclObject> tokens, TclObject& result)
@@ -226,7 +260,7 @@ void AfterCommand::afterRealTime(std::span<const TclObject> tokens, TclObject& r
 		std::in_place_type_t<AfterRealTimeCmd>{},
 		reactor.getRTScheduler(), *this, tokens[3], time);
 	result = std::get<AfterRealTimeCmd>(*ptr).getIdStr();
-	afterCmds.push_back(idx);
+	add(idx);
 }
 
 void AfterCommand::afterTclTime(
@@ -238,7 +272,7 @@ void AfterCommand::afterTclTime(
 		std::in_place_type_t<AfterRealTimeCmd>{},
 		reactor.getRTScheduler(), *this, command, ms * (1.0 / 1000.0));
 	result = std::get<AfterRealTimeCmd>(*ptr).getIdStr();
-	afterCmds.push_back(idx);
+	add(idx);
 }
 
 void AfterCommand::afterSimpleEvent(std::span<const TclObject> tokens, TclObject& result, EventType type)
@@ -248,7 +282,7 @@ void AfterCommand::afterSimpleEvent(std::span<const TclObject> tokens, TclObject
 		std::in_place_type_t<AfterSimpleEventCmd>{},
 		*this, tokens[2], type);
 	result = std::get<AfterSimpleEventCmd>(*ptr).getIdStr();
-	afterCmds.push_back(idx);
+	add(idx);
 }
 
 void AfterCommand::afterInputEvent(
@@ -259,7 +293,7 @@ void AfterCommand::afterInputEvent(
 		std::in_place_type_t<AfterInputEventCmd>{},
 		*this, std::move(event), tokens[2]);
 	result = std::get<AfterInputEventCmd>(*ptr).getIdStr();
-	afterCmds.push_back(idx);
+	add(idx);
 }
 
 void AfterCommand::afterIdle(std::span<const TclObject> tokens, TclObject& result)
@@ -272,7 +306,7 @@ void AfterCommand::afterIdle(std::span<const TclObject> tokens, TclObject& resul
 		std::in_place_type_t<AfterIdleCmd>{},
 		motherBoard->getScheduler(), *this, tokens[3], time);
 	result = std::get<AfterIdleCmd>(*ptr).getIdStr();
-	afterCmds.push_back(idx);
+	add(idx);
 }
 
 void AfterCommand::afterInfo(std::span<const TclObject> /*tokens*/, TclObject& result) const
@@ -283,7 +317,7 @@ void AfterCommand::afterInfo(std::span<const TclObject> /*tokens*/, TclObject& r
 	};
 
 	std::ostringstream str;
-	for (auto idx : afterCmds) {
+	for (const auto& [id, idx] : getSortedCmds(afterCmds)) {
 		const auto& var = afterCmdPool[idx];
 		std::visit([&](const AfterCmd& cmd) { str << cmd.getIdStr() << ": "; }, var);
 		std::visit(overloaded {
@@ -303,35 +337,24 @@ void AfterCommand::afterCancel(std::span<const TclObject> tokens, TclObject& /*r
 	checkNumArgs(tokens, AtLeast{3}, "id|command");
 	if (tokens.size() == 3) {
 		if (auto idStr = tokens[2].getString(); idStr.starts_with("after#")) {
-			if (auto id = StringOp::stringTo<unsigned>(idStr.substr(6))) {
-				auto equalId = [id = *id](Index idx) {
-					return std::visit([&](const AfterCmd& cmd) {
-						 return cmd.getId() == id;
-					}, afterCmdPool[idx]);
-				};
-				if (auto it = ranges::find_if(afterCmds, equalId);
-				    it != end(afterCmds)) {
-					auto idx = *it;
-					afterCmds.erase(it);
-					afterCmdPool.remove(idx);
-					return;
-				}
+			if (auto id = StringOp::stringTo<unsigned>(idStr.substr(6));
+			    id && afterCmds.contains(*id)) {
+				afterCmdPool.remove(unlink(*id));
+				return;
 			}
 		}
 	}
 	TclObject command;
 	command.addListElements(view::drop(tokens, 2));
 	std::string_view cmdStr = command.getString();
-	auto equalCmd = [&](Index idx) {
+	auto equalCmd = [&](const auto& p) {
 		return std::visit([&](const AfterCmd& cmd) {
 			return cmd.getCommand() == cmdStr;
-		}, afterCmdPool[idx]);
+		}, afterCmdPool[p.second]);
 	};
-	if (auto it = ranges::find_if(afterCmds, equalCmd);
-	    it != end(afterCmds)) {
-		auto idx = *it;
-		afterCmds.erase(it);
-		afterCmdPool.remove(idx);
+	auto cmds = getSortedCmds(afterCmds);
+	if (auto it = ranges::find_if(cmds, equalCmd); it != end(cmds)) {
+		afterCmdPool.remove(unlink(it->first));
 		// Tcl manual is not clear about this, but it seems
 		// there's only occurrences of this command canceled.
 		// It's also not clear which of the (possibly) several
@@ -367,16 +390,64 @@ void AfterCommand::tabCompletion(std::vector<std::string>& tokens) const
 	// TODO : make more complete
 }
 
-// Execute the cmds for which the predicate returns true, and erase those from afterCmds.
-void AfterCommand::executeMatches(std::predicate<Index> auto pred)
+// Register a newly created command (stored at 'idx' in the pool).
+void AfterCommand::add(Index idx)
+{
+	std::visit(overloaded {
+		[&](const AfterSimpleEventCmd& cmd) {
+			simpleEventCmds[simpleEventSlot(cmd.getTypeEnum())].push_back(idx);
+		},
+		[&](const AfterInputEventCmd& /*cmd*/) { inputEventCmds.push_back(idx); },
+		[&](const AfterIdleCmd&       /*cmd*/) { idleCmds.push_back(idx); },
+		[&](const AfterCmd&           /*cmd*/) { /*nothing*/ }
+	}, afterCmdPool[idx]);
+	afterCmds.emplace(getId(idx), idx);
+}
+
+// Remove the command with the given id from all administration (but not yet
+// from the pool), returns its index in the pool.
+AfterCommand::Index AfterCommand::unlink(unsigned id)
+{
+	auto* p = lookup(afterCmds, id);
+	assert(p);
+	auto idx = *p;
+	afterCmds.erase(id);
+	std::visit(overloaded {
+		[&](const AfterSimpleEventCmd& cmd) {
+			eraseIdx(simpleEventCmds[simpleEventSlot(cmd.getTypeEnum())], idx);
+		},
+		[&](const AfterInputEventCmd& /*cmd*/) { eraseIdx(inputEventCmds, idx); },
+		[&](const AfterTimedCmd&      /*cmd*/) {
+			eraseIdx(idleCmds, idx);
+			eraseIdx(expiredCmds, idx);
+		},
+		[&](const AfterRealTimeCmd&   /*cmd*/) { /*nothing*/ }
+	}, afterCmdPool[idx]);
+	return idx;
+}
+
+void AfterCommand::timedCmdExpired(unsigned id)
+{
+	auto* idx = lookup(afterCmds, id);
+	assert(idx);
+	eraseIdx(idleCmds, *idx); // no need to reschedule anymore
+	expiredCmds.push_back(*idx);
+}
+
+// Execute the cmds (from the given list) for which the predicate returns true,
+// and erase those from that list and from afterCmds.
+void AfterCommand::executeMatches(std::vector<Index>& cmds, std::predicate<Index> auto pred)
 {
 	static std::vector<Index> matches; // static to keep capacity for next call
 	assert(matches.empty());
 
-	// Usually there are very few matches (typically even 0 or 1), so no
-	// need to reserve() space.
-	auto p = partition_copy_remove(afterCmds, std::back_inserter(matches), pred);
-	afterCmds.erase(p.second, end(afterCmds));
+	auto p = partition_copy_remove(cmds, std::back_inserter(matches), pred);
+	cmds.erase(p.second, end(cmds));
+	// First remove all matches, so that executing one command can't
+	// cancel another matching command.
+	for (auto idx : matches) {
+		afterCmds.erase(getId(idx));
+	}
 	for (auto idx : matches) {
 		std::visit([](AfterCmd& cmd) { cmd.execute(); },
 		           afterCmdPool[idx]);
@@ -385,37 +456,19 @@ void AfterCommand::executeMatches(std::predicate<Index> auto pred)
 	matches.clear(); // for next call (but keep capacity)
 }
 
-struct AfterSimpleEventPred {
-	bool operator()(AfterCommand::Index idx) const {
-		return std::visit(overloaded {
-			[&](const AfterSimpleEventCmd& cmd) { return cmd.getTypeEnum() == type; },
-			[&](const AfterCmd& /*cmd*/) { return false; }
-		}, afterCmdPool[idx]);
-	}
-	const EventType type;
+struct AfterAllPred {
+	bool operator()(AfterCommand::Index /*idx*/) const { return true; }
 };
 void AfterCommand::executeSimpleEvents(EventType type)
 {
-	executeMatches(AfterSimpleEventPred{type});
+	executeMatches(simpleEventCmds[simpleEventSlot(type)], AfterAllPred{});
 }
 
-struct AfterEmuTimePred {
-	bool operator()(AfterCommand::Index idx) const {
-		return std::visit(overloaded {
-			[&](const AfterTimedCmd& cmd) { return cmd.getTime() == 0.0; },
-			[&](const AfterCmd& /*cmd*/) { return false; }
-		}, afterCmdPool[idx]);
-	}
-};
-
 struct AfterInputEventPred {
 	explicit AfterInputEventPred(const Event& event_)
 		: event(event_) {}
 	bool operator()(AfterCommand::Index idx) const {
-		return std::visit(overloaded {
-			[&](const AfterInputEventCmd& cmd) { return matches(cmd.getEvent(), event); },
-			[&](const AfterCmd& /*cmd*/) { return false; }
-		}, afterCmdPool[idx]);
+		return matches(std::get<AfterInputEventCmd>(afterCmdPool[idx]).getEvent(), event);
 	}
 	const Event& event;
 };
@@ -433,15 +486,12 @@ bool AfterCommand::signalEvent(const Event& event)
 			executeSimpleEvents(EventType::QUIT);
 		},
 		[&](const AfterTimedEvent&) {
-			executeMatches(AfterEmuTimePred());
+			executeMatches(expiredCmds, AfterAllPred{});
 		},
 		[&](const EventBase&) {
-			executeMatches(AfterInputEventPred(event));
-			for (auto idx : afterCmds) {
-				std::visit(overloaded {
-					[](AfterIdleCmd& cmd) { cmd.reschedule(); },
-					[](const AfterCmd& /*cmd*/) { /*nothing*/ }
-				}, afterCmdPool[idx]);
+			executeMatches(inputEventCmds, AfterInputEventPred(event));
+			for (auto idx : idleCmds) {
+				std::get<AfterIdleCmd>(afterCmdPool[idx]).reschedule();
 			}
 		}
 	}, event);
@@ -468,14 +518,7 @@ void AfterCmd::execute()
 
 AfterCommand::Index AfterCmd::removeSelf()
 {
-	auto equalThis = [&](AfterCommand::Index idx) {
-		return std::visit([&](const AfterCmd& cmd) { return &cmd == this; },
-			          afterCmdPool[idx]);
-	};
-	auto it = rfind_if_unguarded(afterCommand.afterCmds, equalThis);
-	auto idx = *it;
-	afterCommand.afterCmds.erase(it); // move_pop_back ?
-	return idx;
+	return afterCommand.unlink(id);
 }
 
 
@@ -506,6 +549,7 @@ void AfterTimedCmd::reschedule()
 void AfterTimedCmd::executeUntil(EmuTime::param /*time*/)
 {
 	time = 0.0; // execute on next event
+	afterCommand.timedCmdExpired(getId());
 	afterCommand.eventDistributor.distributeEvent(AfterTimedEvent());
 }
 
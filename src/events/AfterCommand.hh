@@ -5,6 +5,9 @@
 #include "EventListener.hh"
 #include "Event.hh"
 
+#include "hash_map.hh"
+
+#include <array>
 #include <concepts>
 #include <vector>
 
@@ -30,7 +33,10 @@ public:
 	void tabCompletion(std::vector<std::string>& tokens) const override;
 
 private:
-	void executeMatches(std::predicate<Index> auto pred);
+	void add(Index idx);
+	Index unlink(unsigned id);
+	void timedCmdExpired(unsigned id);
+	void executeMatches(std::vector<Index>& cmds, std::predicate<Index> auto pred);
 	void executeSimpleEvents(EventType type);
 	void afterSimpleEvent(std::span<const TclObject> tokens, TclObject& result, EventType type);
 	void afterInputEvent(Event event,
@@ -47,7 +53,16 @@ private:
 	bool signalEvent(const Event& event) override;
 
 private:
-	std::vector<Index> afterCmds;
+	// All pending commands, indexed by their id.
+	hash_map<unsigned, Index> afterCmds;
+	// The pending commands per kind of trigger (in the order they were
+	// created). So handling an event only needs to look at the commands
+	// that can be triggered by that event, not at all pending commands.
+	std::array<std::vector<Index>, 5> simpleEventCmds; // frame, break, quit, boot, machine_switch
+	std::vector<Index> inputEventCmds;
+	std::vector<Index> idleCmds; // rescheduled on each input event
+	std::vector<Index> expiredCmds; // 'after time/idle' whose time has passed
+
 	Reactor& reactor;
 	EventDistributor& eventDistributor;
 
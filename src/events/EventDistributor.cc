@@ -5,8 +5,11 @@
 #include "Interpreter.hh"
 #include "InputEventGenerator.hh"
 #include "Thread.hh"
+#include "Timer.hh"
 #include "ranges.hh"
 #include "stl.hh"
+#include <algorithm>
+#include <bit>
 #include <cassert>
 #include <chrono>
 
@@ -27,6 +30,7 @@ void EventDistributor::registerEventListener(
 	// insert at highest position that keeps listeners sorted on priority
 	auto it = ranges::upper_bound(priorityMap, priority, {}, &Entry::priority);
 	priorityMap.emplace(it, Entry{priority, &listener});
+	++numListeners[size_t(type)];
 }
 
 void EventDistributor::unregisterEventListener(
@@ -35,28 +39,28 @@ void EventDistributor::unregisterEventListener(
 	std::scoped_lock lock(mutex);
 	auto& priorityMap = listeners[size_t(type)];
 	priorityMap.erase(rfind_unguarded(priorityMap, &listener, &Entry::listener));
+	--numListeners[size_t(type)];
 }
 
 void EventDistributor::distributeEvent(Event&& event)
 {
-	// TODO: Implement a real solution against modifying data structure while
-	//       iterating through it.
-	//       For example, assign nullptr first and then iterate again after
-	//       delivering events to remove the nullptr values.
 	// TODO: Is it useful to test for 0 listeners or should we just always
 	//       queue the event?
-	std::unique_lock lock(mutex);
-	if (!listeners[size_t(getType(event))].empty()) {
-		scheduledEvents.push_back(std::move(event));
-		// must release lock, otherwise there's a deadlock:
-		//   thread 1: Reactor::deleteMotherBoard()
-		//             EventDistributor::unregisterEventListener()
-		//   thread 2: EventDistributor::distributeEvent()
-		//             Reactor::enterMainLoop()
+	// Note: this doesn't take 'mutex', so a thread that posts events can't
+	// block (or deadlock) on the main thread (e.g. while that one is
+	// unregistering listeners in Reactor::deleteMotherBoard()).
+	if (numListeners[size_t(getType(event))] == 0) return;
+
+	bool wasEmpty = scheduledEvents.push({std::move(event), Timer::getTime()});
+	if (wasEmpty) {
+		// Only needed for the first event of a batch, the main thread
+		// can't be sleeping while there are already events queued.
+		// Taking (and releasing) the mutex ensures the wakeup can't get
+		// lost between the check and the wait in sleep().
+		{ std::scoped_lock lock(cvMutex); }
 		condition.notify_all();
-		lock.unlock();
-		reactor.enterMainLoop();
 	}
+	reactor.enterMainLoop();
 }
 
 bool EventDistributor::isRegistered(EventType type, EventListener* listener) const
@@ -75,7 +79,6 @@ void EventDistributor::deliverEvents()
 	reactor.getInterpreter().poll();
 	reactor.getRTScheduler().execute();
 
-	std::unique_lock lock(mutex);
 	// It's possible that executing an event triggers scheduling of another
 	// event. We also want to execute those secondary events. That's why
 	// we have this while loop here.
@@ -83,13 +86,21 @@ void EventDistributor::deliverEvents()
 	// event and as reaction to the latter event, AfterCommand will
 	// unsubscribe from the ols MSXEventDistributor. This really should be
 	// done before we exit this method.
-	while (!scheduledEvents.empty()) {
-		assert(eventsCopy.empty());
-		swap(eventsCopy, scheduledEvents);
-		for (const auto& event : eventsCopy) {
+	assert(eventsCopy.empty());
+	while (scheduledEvents.popAll(eventsCopy)) {
+		auto now = Timer::getTime();
+		for (const auto& [event, postTime] : eventsCopy) {
+			auto latency = (now > postTime) ? (now - postTime) : 0;
+			// floor(log2(latency)), with latency=0 also in bucket 0
+			auto bucket = std::min<size_t>(std::bit_width(latency | 1) - 1,
+			                               NUM_LATENCY_BUCKETS - 1);
+			++latencyHistogram[bucket];
+
 			auto type = getType(event);
-			priorityMapCopy = listeners[size_t(type)];
-			lock.unlock();
+			{
+				std::scoped_lock lock(mutex);
+				priorityMapCopy = listeners[size_t(type)];
+			}
 			auto allowPriority = Priority::LOWEST; // allow all
 			for (const auto& e : priorityMapCopy) {
 				// It's possible delivery to one of the previous
@@ -103,7 +114,6 @@ void EventDistributor::deliverEvents()
 					allowPriority = e.priority;
 				}
 			}
-			lock.lock();
 		}
 		eventsCopy.clear();
 	}
@@ -113,7 +123,8 @@ bool EventDistributor::sleep(unsigned us)
 {
 	std::chrono::microseconds duration(us);
 	std::unique_lock lock(cvMutex);
-	return condition.wait_for(lock, duration) == std::cv_status::timeout;
+	return !condition.wait_for(lock, duration,
+		[&] { return !scheduledEvents.empty(); });
 }
 
 } // namespace openmsx
@@ -3,10 +3,13 @@
 
 #include "Event.hh"
 
+#include "MPSCQueue.hh"
 #include "stl.hh"
 
 #include <array>
+#include <atomic>
 #include <condition_variable>
+#include <cstdint>
 #include <mutex>
 #include <vector>
 
@@ -53,6 +56,7 @@ public:
 	/** Schedule the given event for delivery. Actual delivery happens
 	  * when the deliverEvents() method is called. Events are always
 	  * in the main thread.
+	  * This method can be called from any thread, it doesn't block.
 	  */
 	void distributeEvent(Event&& event);
 
@@ -70,6 +74,17 @@ public:
 	  */
 	bool sleep(unsigned us);
 
+	/** Histogram of the time between distributeEvent() and the delivery
+	  * of that event (in the main thread). Bucket 'i' counts the events
+	  * with a latency in the range [2^i, 2^(i+1)) microseconds (bucket 0
+	  * also contains latency 0, the last bucket also everything above).
+	  */
+	static constexpr size_t NUM_LATENCY_BUCKETS = 24;
+	using LatencyHistogram = std::array<uint64_t, NUM_LATENCY_BUCKETS>;
+	[[nodiscard]] const LatencyHistogram& getLatencyHistogram() const {
+		return latencyHistogram;
+	}
+
 private:
 	[[nodiscard]] bool isRegistered(EventType type, EventListener* listener) const;
 
@@ -82,11 +97,18 @@ private:
 	};
 	using PriorityMap = std::vector<Entry>; // sorted on priority
 	std::array<PriorityMap, size_t(EventType::NUM_EVENT_TYPES)> listeners;
-	using EventQueue = std::vector<Event>;
-	EventQueue scheduledEvents;
-	std::mutex mutex; // lock data structures
+	// number of listeners per type, can be read without taking 'mutex'
+	std::array<std::atomic<unsigned>, size_t(EventType::NUM_EVENT_TYPES)> numListeners = {};
+	struct ScheduledEvent {
+		Event event;
+		uint64_t postTime; // in microseconds, see Timer::getTime()
+	};
+	using EventQueue = std::vector<ScheduledEvent>;
+	MPSCQueue<ScheduledEvent> scheduledEvents;
+	std::mutex mutex; // lock 'listeners'
 	std::mutex cvMutex; // lock condition_variable
 	std::condition_variable condition;
+	LatencyHistogram latencyHistogram = {}; // only accessed from main thread
 };
 
 } // namespace openmsx
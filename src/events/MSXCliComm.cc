@@ -13,18 +13,22 @@ MSXCliComm::MSXCliComm(MSXMotherBoard& motherBoard_, GlobalCliComm& cliComm_)
 
 void MSXCliComm::log(LogLevel level, std::string_view message, float fraction)
 {
-	if (!suppressMessages) {
+	// The run-ahead shadow machine would only repeat what the real machine
+	// already reported.
+	if (!suppressMessages && !motherBoard.isShadow()) {
 		cliComm.log(level, message, fraction);
 	}
 }
 
 void MSXCliComm::update(UpdateType type, std::string_view name, std::string_view value)
 {
+	if (motherBoard.isShadow()) return;
 	cliComm.updateHelper(type, motherBoard.getMachineID(), name, value);
 }
 
 void MSXCliComm::updateFiltered(UpdateType type, std::string_view name, std::string_view value)
 {
+	if (motherBoard.isShadow()) return;
 	if (auto [it, inserted] = prevValues[type].try_emplace(name, value);
 	    !inserted) { // was already present ..
 		if (it->second == value) {
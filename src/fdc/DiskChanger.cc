@@ -46,6 +46,7 @@ DiskChanger::DiskChanger(MSXMotherBoard& board,
 	, preChangeCallback(std::move(preChangeCallback_))
 	, driveName(std::move(driveName_))
 	, doubleSidedDrive(doubleSidedDrive_)
+	, shadow(board.isShadow())
 {
 	init(tmpStrCat(board.getMachineID(), "::"), createCmd);
 }
@@ -57,6 +58,7 @@ DiskChanger::DiskChanger(Reactor& reactor_, std::string driveName_)
 	, scheduler(nullptr)
 	, driveName(std::move(driveName_))
 	, doubleSidedDrive(true) // irrelevant, but needs a value
+	, shadow(false)
 {
 	init({}, true);
 }
@@ -364,8 +366,13 @@ void DiskChanger::serialize(Archive& ar, unsigned version)
 			}
 		}
 
-		std::string newChecksum = calcSha1(getSectorAccessibleDisk(), filePool);
-		if (oldChecksum != newChecksum) {
+		if (shadow) {
+			// The run-ahead shadow machine shares the image with the
+			// real machine, so the content is the same. It must not
+			// write to it.
+			disk->forceWriteProtect();
+		} else if (std::string newChecksum = calcSha1(getSectorAccessibleDisk(), filePool);
+		           oldChecksum != newChecksum) {
 			controller.getCliComm().printWarning(
 				"The content of the disk image ",
 				diskName.getResolved(),
@@ -98,6 +98,7 @@ private:
 	friend class DiskCommand;
 	std::optional<DiskCommand> diskCommand; // must come after driveName
 	const bool doubleSidedDrive; // for DirAsDSK
+	const bool shadow; // in the run-ahead shadow machine
 
 	bool diskChangedFlag;
 };
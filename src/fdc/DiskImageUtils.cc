@@ -11,6 +11,7 @@
 #include "view.hh"
 #include "xrange.hh"
 #include <algorithm>
+#include <array>
 #include <bit>
 #include <cassert>
 #include <ctime>
@@ -439,10 +440,14 @@ void format(SectorAccessibleDisk& disk, MSXBootSectorType bootType, size_t nbSec
 		disk.writeSector(result.fatStart + fat * result.sectorsPerFat, buf);
 	}
 
-	// write 'empty' data sectors
-	ranges::fill(buf.raw, 0xE5);
-	for (auto i : xrange(result.dataStart, nbSectors)) {
-		disk.writeSector(i, buf);
+	// write 'empty' data sectors, many at once (this can be a large area
+	// for a hard disk partition)
+	std::array<SectorBuffer, 64> dataBuf;
+	for (auto& b : dataBuf) ranges::fill(b.raw, 0xE5);
+	for (size_t i = result.dataStart; i < nbSectors; /**/) {
+		auto num = std::min(dataBuf.size(), nbSectors - i);
+		disk.writeSectors(subspan(dataBuf, 0, num), i);
+		i += num;
 	}
 }
 
@@ -1,10 +1,12 @@
 #include "DiskManipulator.hh"
 
+#include "CliComm.hh"
 #include "CommandException.hh"
 #include "DSKDiskImage.hh"
 #include "DiskContainer.hh"
 #include "DiskImageUtils.hh"
 #include "DiskPartition.hh"
+#include "Display.hh"
 #include "File.hh"
 #include "FileContext.hh"
 #include "FileException.hh"
@@ -20,6 +22,7 @@
 #include "StringOp.hh"
 #include "TclArgParser.hh"
 #include "TclObject.hh"
+#include "Timer.hh"
 #include "narrow.hh"
 #include "one_of.hh"
 #include "ranges.hh"
@@ -631,6 +634,22 @@ MSXtar DiskManipulator::getMSXtar(
 	}
 
 	MSXtar result(disk, reactor.getMsxChar2Unicode());
+	// Like HD::showProgress(): only show progress when the command already
+	// takes more than 1 second, and then at most once per second (plus
+	// the final 100% of the current file).
+	result.setProgressCallback(
+		[&reactor = reactor, lastTime = Timer::getTime(), everDidProgress = false]
+		(std::string_view message, size_t done, size_t total) mutable {
+			auto now = Timer::getTime();
+			if (((now - lastTime) > 1000000) ||
+			    ((done == total) && everDidProgress)) {
+				lastTime = now;
+				reactor.getCliComm().printProgress(
+					message, float(done) / float(total));
+				reactor.getDisplay().repaint();
+				everDidProgress = true;
+			}
+		});
 	string cwd = driveData.getWorkingDir(driveData.partition);
 	try {
 		result.chdir(cwd);
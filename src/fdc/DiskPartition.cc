@@ -49,9 +49,10 @@ DiskPartition::DiskPartition(SectorAccessibleDisk& parent_,
 	setNbSectors(length);
 }
 
-void DiskPartition::readSectorImpl(size_t sector, SectorBuffer& buf)
+void DiskPartition::readSectorsImpl(
+	std::span<SectorBuffer> buffers, size_t startSector)
 {
-	parent.readSector(start + sector, buf);
+	parent.readSectors(buffers, start + startSector);
 }
 
 void DiskPartition::writeSectorImpl(size_t sector, const SectorBuffer& buf)
@@ -59,6 +60,12 @@ void DiskPartition::writeSectorImpl(size_t sector, const SectorBuffer& buf)
 	parent.writeSector(start + sector, buf);
 }
 
+void DiskPartition::writeSectorsImpl(
+	std::span<const SectorBuffer> buffers, size_t startSector)
+{
+	parent.writeSectors(buffers, start + startSector);
+}
+
 bool DiskPartition::isWriteProtectedImpl() const
 {
 	return parent.isWriteProtected();
@@ -28,6 +28,8 @@
 #include <cstring>
 #include <cassert>
 #include <cctype>
+#include <span>
+#include <vector>
 
 using std::string;
 using std::string_view;
@@ -84,6 +86,10 @@ static constexpr uint8_t EBPB_SIGNATURE = 0x29;  // Extended BIOS Parameter Bloc
 // For details, read http://home.teleport.com/~brainy/lfn.htm
 static constexpr MSXDirEntry::AttribValue T_MSX_LFN(0x0F); // LFN entry (long files names)
 
+// Maximum number of sectors that is transferred at once when adding or
+// extracting a file (limits the size of the intermediate buffer).
+static constexpr unsigned MAX_RUN_SECTORS = 256;
+
 /** Transforms a cluster number towards the first sector of this cluster
   * The calculation uses info read fom the boot sector
   */
@@ -217,6 +223,7 @@ MSXtar::MSXtar(MSXtar&& other) noexcept
 	: disk(other.disk)
 	, fatBuffer(std::move(other.fatBuffer))
 	, msxChars(other.msxChars)
+	, progressCallback(std::move(other.progressCallback))
 	, findFirstFreeClusterStart(other.findFirstFreeClusterStart)
 	, clusterCount(other.clusterCount)
 	, fatCount(other.fatCount)
@@ -236,12 +243,10 @@ MSXtar::~MSXtar()
 	if (!fatCacheDirty) return;
 
 	for (auto fat : xrange(fatCount)) {
-		for (auto i : xrange(sectorsPerFat)) {
-			try {
-				disk.writeSector(i + fatStart + fat * sectorsPerFat, fatBuffer[i]);
-			} catch (MSXException&) {
-				// nothing
-			}
+		try {
+			disk.writeSectors(fatBuffer.first(sectorsPerFat), fatStart + fat * sectorsPerFat);
+		} catch (MSXException&) {
+			// nothing
 		}
 	}
 }
@@ -610,19 +615,27 @@ void MSXtar::alterFileInDSK(MSXDirEntry& msxDirEntry, const string& hostName)
 		throw MSXException("Error reading host file: ", hostName);
 	}
 	auto hostSize = narrow<unsigned>(st->st_size);
-	auto remaining = hostSize;
 
 	// open host file for reading
 	File file(hostName, "rb");
 
-	// copy host file to image
+	// First plan the whole FAT chain: reuse the existing chain (when
+	// overwriting a file) and extend it with free clusters. Only then copy
+	// the data, in runs of consecutive clusters. Free clusters are
+	// allocated in increasing order, so typically the whole file is a
+	// single run.
+	unsigned clusterSize = sectorsPerCluster * SECTOR_SIZE;
+	unsigned neededClusters = (hostSize + clusterSize - 1) / clusterSize;
+	std::vector<Cluster> clusters;
+	clusters.reserve(neededClusters);
+
 	DirCluster prevCl = Free{};
 	FatCluster curCl = std::visit(overloaded{
 		[](Free) -> FatCluster { return EndOfChain{}; },
 		[](Cluster cluster) -> FatCluster { return cluster; }
 	}, getStartCluster(msxDirEntry));
 
-	while (remaining) {
+	while (clusters.size() < neededClusters) {
 		Cluster cluster;
 		// allocate new cluster if needed
 		try {
@@ -643,17 +656,7 @@ void MSXtar::alterFileInDSK(MSXDirEntry& msxDirEntry, const string& hostName)
 			// no more free clusters or invalid entry in FAT chain
 			break;
 		}
-
-		// fill cluster
-		unsigned logicalSector = clusterToSector(cluster);
-		for (unsigned j = 0; (j < sectorsPerCluster) && remaining; ++j) {
-			SectorBuffer buf;
-			unsigned chunkSize = std::min(SECTOR_SIZE, remaining);
-			file.read(subspan(buf.raw, 0, chunkSize));
-			ranges::fill(subspan(buf.raw, chunkSize), 0);
-			writeLogicalSector(logicalSector + j, buf);
-			remaining -= chunkSize;
-		}
+		clusters.push_back(cluster);
 
 		// advance to next cluster
 		prevCl = cluster;
@@ -669,10 +672,37 @@ void MSXtar::alterFileInDSK(MSXDirEntry& msxDirEntry, const string& hostName)
 	// free rest of FAT chain
 	freeFatChain(curCl);
 
+	// copy host file to image
+	unsigned remaining = std::min(hostSize, narrow<unsigned>(clusters.size()) * clusterSize);
+	unsigned truncated = hostSize - remaining;
+	unsigned total = remaining;
+	std::string message = progressCallback ? strCat("Importing ", hostName) : std::string{};
+	std::vector<SectorBuffer> buf;
+	for (size_t i = 0; remaining; /**/) {
+		// find a run of consecutive clusters
+		size_t n = 1;
+		while ((i + n) < clusters.size() &&
+		       (clusters[i + n].index == clusters[i].index + n) &&
+		       ((n + 1) * sectorsPerCluster <= MAX_RUN_SECTORS)) {
+			++n;
+		}
+		unsigned runSize = std::min(remaining, narrow<unsigned>(n) * clusterSize);
+		unsigned numSectors = (runSize + SECTOR_SIZE - 1) / SECTOR_SIZE;
+		buf.resize(numSectors);
+		std::span<uint8_t> raw{buf[0].raw.data(), numSectors * size_t(SECTOR_SIZE)};
+		file.read(raw.first(runSize));
+		ranges::fill(raw.subspan(runSize), 0);
+		// data sectors never overlap with the (cached) FAT
+		disk.writeSectors(buf, clusterToSector(clusters[i]));
+		remaining -= runSize;
+		i += n;
+		if (progressCallback) progressCallback(message, total - remaining, total);
+	}
+
 	// write (possibly truncated) file size
-	msxDirEntry.size = hostSize - remaining;
+	msxDirEntry.size = hostSize - truncated;
 
-	if (remaining) {
+	if (truncated) {
 		throw MSXException("Disk full, ", hostName, " truncated.");
 	}
 }
@@ -1030,13 +1060,24 @@ void MSXtar::fileExtract(const string& resultFile, const MSXDirEntry& dirEntry)
 	}, getStartCluster(dirEntry));
 
 	File file(resultFile, "wb");
+	unsigned total = size;
+	std::string message = progressCallback ? strCat("Exporting ", resultFile) : std::string{};
+	std::vector<SectorBuffer> buf;
 	while (size && sector) {
-		SectorBuffer buf;
-		readLogicalSector(sector, buf);
-		unsigned saveSize = std::min(size, SECTOR_SIZE);
-		file.write(subspan(buf.raw, 0, saveSize));
+		// read a run of consecutive sectors at once
+		unsigned first = sector;
+		unsigned num = 0;
+		do {
+			++num;
+			sector = getNextSector(sector);
+		} while ((sector == first + num) && (num < MAX_RUN_SECTORS) &&
+		         (num * SECTOR_SIZE < size));
+		buf.resize(num);
+		disk.readSectors(buf, first);
+		unsigned saveSize = std::min(size, num * SECTOR_SIZE);
+		file.write(std::span<const uint8_t>{buf[0].raw.data(), saveSize});
 		size -= saveSize;
-		sector = getNextSector(sector);
+		if (progressCallback) progressCallback(message, total - size, total);
 	}
 	// now change the access time
 	changeTime(resultFile, dirEntry);
@@ -13,6 +13,7 @@
 #include "MemBuffer.hh"
 #include "zstring_view.hh"
 
+#include <functional>
 #include <string_view>
 #include <variant>
 
@@ -53,6 +54,13 @@ public:
 	MSXtar(MSXtar&& other) noexcept;
 	~MSXtar();
 
+	/** Called while a file is copied to or from the disk image, after each
+	  * run of sectors, with a description (e.g. "Importing foo.dsk") and
+	  * the number of bytes done and in total (for that file).
+	  */
+	using ProgressCallback = std::function<void(std::string_view message, size_t done, size_t total)>;
+	void setProgressCallback(ProgressCallback callback) { progressCallback = std::move(callback); }
+
 	void chdir(std::string_view newRootDir);
 	void mkdir(std::string_view newRootDir);
 	std::string dir(); // formatted output
@@ -123,6 +131,7 @@ private:
 	SectorAccessibleDisk& disk;
 	MemBuffer<SectorBuffer> fatBuffer;
 	const MsxChar2Unicode& msxChars;
+	ProgressCallback progressCallback; // can be empty
 	FAT::Cluster findFirstFreeClusterStart{0}; // all clusters before this one are in use
 
 	unsigned clusterCount;
@@ -24,6 +24,12 @@ void RamDSKDiskImage::writeSectorImpl(size_t sector, const SectorBuffer& buf)
 	data[sector] = buf;
 }
 
+void RamDSKDiskImage::writeSectorsImpl(
+	std::span<const SectorBuffer> buffers, size_t startSector)
+{
+	ranges::copy(buffers, data.subspan(startSector, buffers.size()));
+}
+
 bool RamDSKDiskImage::isWriteProtectedImpl() const
 {
 	return false;
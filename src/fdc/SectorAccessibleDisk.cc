@@ -83,10 +83,29 @@ void SectorAccessibleDisk::writeSector(size_t sector, const SectorBuffer& buf)
 void SectorAccessibleDisk::writeSectors(
 	std::span<const SectorBuffer> buffers, size_t startSector)
 {
-	// Simply write one-at-a-time. There's no possibility (nor any need) yet
-	// to allow to optimize this
+	if (buffers.empty()) return;
+	if (isWriteProtected()) {
+		throw WriteProtectedException();
+	}
+	auto last = startSector + buffers.size() - 1;
+	if (!isDummyDisk() && (getNbSectors() <= last)) {
+		throw NoSuchSectorException("No such sector");
+	}
+	try {
+		writeSectorsImpl(buffers, startSector);
+	} catch (MSXException& e) {
+		throw DiskIOErrorException("Disk I/O error: ", e.getMessage());
+	}
+	flushCaches();
+}
+
+void SectorAccessibleDisk::writeSectorsImpl(
+	std::span<const SectorBuffer> buffers, size_t startSector)
+{
+	// Default implementation writes one sector at a time. But subclasses
+	// can override this method if they can do it more efficiently.
 	for (auto [i, buf] : enumerate(buffers)) {
-		writeSector(startSector + i, buf);
+		writeSectorImpl(startSector + i, buf);
 	}
 }
 
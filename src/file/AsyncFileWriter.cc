@@ -0,0 +1,145 @@
+#include "AsyncFileWriter.hh"
+
+#include "CliComm.hh"
+#include "FileException.hh"
+#include "FileOperations.hh"
+
+#include "ranges.hh"
+#include "stl.hh"
+#include "strCat.hh"
+#include "unistdp.hh"
+
+#include <atomic>
+#include <cassert>
+#include <cstdio>
+
+#ifdef _WIN32
+#include <io.h>
+#endif
+
+namespace openmsx {
+
+static int syncFile(FILE* file)
+{
+#ifdef _WIN32
+	return _commit(_fileno(file));
+#else
+	return fsync(fileno(file));
+#endif
+}
+
+AsyncFileWriter::AsyncFileWriter(CliComm& cliComm_)
+	: cliComm(cliComm_)
+	, thread([this] { run(); })
+{
+}
+
+AsyncFileWriter::~AsyncFileWriter()
+{
+	{
+		std::scoped_lock lock(mutex);
+		stop = true;
+	}
+	condition.notify_all();
+	thread.join(); // first finishes all pending jobs
+	reportErrors();
+}
+
+void AsyncFileWriter::write(std::string filename, std::vector<uint8_t> data,
+                            std::string description)
+{
+	reportErrors();
+	{
+		std::scoped_lock lock(mutex);
+		if (auto it = ranges::find(jobs, filename, &Job::filename);
+		    it != jobs.end()) {
+			// not yet started, only write the latest content
+			it->data = std::move(data);
+		} else {
+			jobs.push_back({std::move(filename), std::move(data),
+			                std::move(description)});
+		}
+	}
+	condition.notify_all();
+}
+
+void AsyncFileWriter::flush(std::string_view filename)
+{
+	{
+		std::unique_lock lock(mutex);
+		condition.wait(lock, [&] {
+			return (writing != filename) &&
+			       !contains(jobs, filename, &Job::filename);
+		});
+	}
+	reportErrors();
+}
+
+void AsyncFileWriter::run()
+{
+	std::unique_lock lock(mutex);
+	while (true) {
+		condition.wait(lock, [&] { return stop || !jobs.empty(); });
+		if (jobs.empty()) {
+			assert(stop);
+			return;
+		}
+		auto job = std::move(jobs.front());
+		jobs.erase(jobs.begin());
+		writing = job.filename;
+		lock.unlock();
+
+		std::string error;
+		try {
+			writeFile(job);
+		} catch (FileException& e) {
+			error = strCat("Couldn't save ", job.description, ' ',
+			               job.filename, " (", e.getMessage(), ").");
+		}
+
+		lock.lock();
+		writing.clear();
+		if (!error.empty()) errors.push_back(std::move(error));
+		condition.notify_all(); // for flush()
+	}
+}
+
+void AsyncFileWriter::writeFile(const Job& job)
+{
+	// The temporary name must be unique, also between different openMSX
+	// processes (possibly saving the same file).
+	static std::atomic<unsigned> counter = 0;
+	auto tmpName = strCat(job.filename, '.', int(getpid()), '.', counter++, ".tmp");
+
+	auto file = FileOperations::openFile(tmpName, "wb");
+	if (!file) throw FileException("Couldn't create temporary file");
+	// Sync before the rename, otherwise after a crash of the host system
+	// the renamed file could still be (partially) empty.
+	bool ok = (job.data.empty() ||
+	           (fwrite(job.data.data(), job.data.size(), 1, file.get()) == 1)) &&
+	          (fflush(file.get()) == 0) &&
+	          (syncFile(file.get()) == 0);
+	ok = (fclose(file.release()) == 0) && ok;
+	if (!ok) {
+		FileOperations::unlink(tmpName);
+		throw FileException("Error while writing file");
+	}
+	if (FileOperations::replaceFile(tmpName, job.filename) != 0) {
+		FileOperations::unlink(tmpName);
+		throw FileException("Couldn't replace file");
+	}
+}
+
+void AsyncFileWriter::reportErrors()
+{
+	std::vector<std::string> tmp;
+	{
+		std::scoped_lock lock(mutex);
+		swap(tmp, errors);
+	}
+	for (const auto& e : tmp) {
+		cliComm.printWarning(e);
+	}
+}
+
+} // namespace openmsx
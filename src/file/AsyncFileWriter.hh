@@ -0,0 +1,79 @@
+#ifndef ASYNCFILEWRITER_HH
+#define ASYNCFILEWRITER_HH
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace openmsx {
+
+class CliComm;
+
+/** Writes (persistent) files in a background thread, e.g. the content of
+  * SRAM or flash memory. Writing a multi-megabyte flash image would
+  * otherwise stall the emulation.
+  *
+  * - A file is first written (and synced to disk) under a temporary, unique
+  *   name and then renamed. So when openMSX crashes (or gets killed, or the
+  *   host loses power) halfway, the file still has either the old or the
+  *   new content.
+  * - When a file is written again before the previous write started, only
+  *   the latest content is written.
+  * - All pending writes are finished before this object is destroyed.
+  *
+  * All methods must be called from the main thread. Errors are reported
+  * (as warnings) from the main thread, on the next call to write() or
+  * flush().
+  */
+class AsyncFileWriter
+{
+public:
+	explicit AsyncFileWriter(CliComm& cliComm);
+	AsyncFileWriter(const AsyncFileWriter&) = delete;
+	AsyncFileWriter(AsyncFileWriter&&) = delete;
+	AsyncFileWriter& operator=(const AsyncFileWriter&) = delete;
+	AsyncFileWriter& operator=(AsyncFileWriter&&) = delete;
+	~AsyncFileWriter();
+
+	/** Schedule writing 'data' to the file with the given (resolved) name.
+	  * @param description Used in error messages, e.g. "SRAM".
+	  */
+	void write(std::string filename, std::vector<uint8_t> data,
+	           std::string description);
+
+	/** Wait till the scheduled write (if any) of the given file is
+	  * finished. Writes of other files may still be pending.
+	  */
+	void flush(std::string_view filename);
+
+private:
+	struct Job {
+		std::string filename;
+		std::vector<uint8_t> data;
+		std::string description;
+	};
+
+	void run();
+	static void writeFile(const Job& job);
+	void reportErrors();
+
+private:
+	CliComm& cliComm;
+
+	std::mutex mutex; // protects the members below
+	std::condition_variable condition;
+	std::vector<Job> jobs; // at most one per filename
+	std::vector<std::string> errors;
+	std::string writing; // file the worker is writing, empty if idle
+	bool stop = false;
+
+	std::thread thread; // must come last
+};
+
+} // namespace openmsx
+
+#endif
@@ -51,6 +51,7 @@
 #include "build-info.hh"
 #include <algorithm>
 #include <array>
+#include <cstdio>
 #include <sstream>
 #include <cerrno>
 #include <cstdlib>
@@ -183,6 +184,18 @@ int rmdir(zstring_view path)
 #endif
 }
 
+int replaceFile(zstring_view from, zstring_view to)
+{
+#ifdef _WIN32
+	// _wrename() fails when the destination already exists
+	return MoveFileExW(utf8to16(from).c_str(), utf8to16(to).c_str(),
+	                   MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)
+	       ? 0 : -1;
+#else
+	return ::rename(from.c_str(), to.c_str());
+#endif
+}
+
 #ifdef _WIN32
 int deleteRecursive(zstring_view path)
 {
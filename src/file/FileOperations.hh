@@ -70,6 +70,13 @@ namespace openmsx::FileOperations {
 	 */
 	int rmdir(zstring_view path);
 
+	/** Rename 'from' to 'to', replacing 'to' if it already exists. On
+	  * the same filesystem this is atomic: other processes (or openMSX
+	  * after a crash) either see the old or the new content of 'to'.
+	  * Returns 0 on success (like rename()).
+	  */
+	int replaceFile(zstring_view from, zstring_view to);
+
 	/** Recursively delete a file or directory and (in case of a directory)
 	  * all its sub-components.
 	  */
@@ -3,6 +3,7 @@
 #include "File.hh"
 #include "FileException.hh"
 #include "foreach_file.hh"
+#include "StartupTrace.hh"
 
 #include "Date.hh"
 #include "Timer.hh"
@@ -31,15 +32,22 @@ FilePoolCore::FilePoolCore(std::string fileCache_,
 	, getDirectories(std::move(getDirectories_))
 	, reportProgress(std::move(reportProgress_))
 {
-	try {
-		readSha1sums();
-	} catch (MSXException&) {
-		// ignore, probably .filecache doesn't exist yet
-	}
+	// Reading (and indexing) a big '.filecache' takes a while. Do it in a
+	// background thread, so that it overlaps with the rest of the startup.
+	// All public member functions first wait till this is finished.
+	initialLoad = std::async(std::launch::async, [this] {
+		StartupTrace::Phase phase("read filepool cache");
+		try {
+			readSha1sums();
+		} catch (MSXException&) {
+			// ignore, probably .filecache doesn't exist yet
+		}
+	});
 }
 
 FilePoolCore::~FilePoolCore()
 {
+	waitForInitialLoad();
 	if (needWrite) {
 		writeSha1sums();
 	}
@@ -240,8 +248,14 @@ void FilePoolCore::writeSha1sums()
 	}
 }
 
+void FilePoolCore::waitForInitialLoad()
+{
+	if (initialLoad.valid()) initialLoad.get();
+}
+
 File FilePoolCore::getFile(FileType fileType, const Sha1Sum& sha1sum)
 {
+	waitForInitialLoad();
 	File result = getFromPool(sha1sum);
 	if (result.is_open()) return result;
 
@@ -459,6 +473,7 @@ std::pair<FilePoolCore::Index, FilePoolCore::Entry*> FilePoolCore::findInDatabas
 
 Sha1Sum FilePoolCore::getSha1Sum(File& file)
 {
+	waitForInitialLoad();
 	auto time = file.getModificationDate();
 	const std::string& filename = file.getURL();
 
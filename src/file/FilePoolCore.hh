@@ -11,6 +11,7 @@
 #include <cstdint>
 #include <ctime>
 #include <functional>
+#include <future>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -155,6 +156,7 @@ private:
 	        std::string_view poolPath,
 	        ScanProgress& progress);
 	[[nodiscard]] Sha1Sum calcSha1sum(File& file) const;
+	void waitForInitialLoad();
 	[[nodiscard]] std::pair<Index, Entry*> findInDatabase(std::string_view filename);
 
 private:
@@ -169,6 +171,8 @@ private:
 	Sha1Index sha1Index; // entries accessible via sha1, sorted on 'CompareSha1'
 	FilenameIndex filenameIndex{FilenameIndexHash(pool), FilenameIndexEqual(pool)}; // accessible via filename
 
+	std::future<void> initialLoad; // reads '.filecache' in a background thread
+
 	bool stop = false; // abort long search (set via reportProgress callback)
 	bool needWrite = false; // dirty '.filecache'? write on exit
 
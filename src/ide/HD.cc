@@ -6,14 +6,22 @@
 #include "HDImageCLI.hh"
 #include "MSXMotherBoard.hh"
 #include "Reactor.hh"
+#include "ReverseManager.hh"
 #include "Display.hh"
 #include "GlobalSettings.hh"
 #include "MSXException.hh"
+#include "FileOperations.hh"
 #include "Timer.hh"
+#include "foreach_file.hh"
 #include "narrow.hh"
+#include "ranges.hh"
 #include "serialize.hh"
+#include "strCat.hh"
 #include "tiger.hh"
+#include "xxhash.hh"
+#include <algorithm>
 #include <array>
+#include <bit>
 #include <cassert>
 #include <memory>
 
@@ -64,6 +72,13 @@ HD::HD(const DeviceConfig& config)
 		filesize = file.getSize();
 	}
 	tigerTree.emplace(*this, filesize, filename.getResolved());
+	loadTigerTreeState();
+	openJournal();
+	if (motherBoard.isShadow()) {
+		// The run-ahead shadow machine shares the image with the real
+		// machine, it must not write to it.
+		forceWriteProtect();
+	}
 
 	(*hdInUse)[id] = true;
 	hdCommand.emplace(
@@ -79,6 +94,8 @@ HD::HD(const DeviceConfig& config)
 
 HD::~HD()
 {
+	journal->forgetFile(file);
+	saveTigerTreeState();
 	motherBoard.unregisterMediaInfo(*this);
 	motherBoard.getMSXCliComm().update(CliComm::UpdateType::HARDWARE, name, "remove");
 
@@ -95,10 +112,15 @@ void HD::getMediaInfo(TclObject& result)
 
 void HD::switchImage(const Filename& newFilename)
 {
-	file = File(newFilename);
+	saveTigerTreeState();
+	File newFile(newFilename);
+	journal->forgetFile(file);
+	file = std::move(newFile);
 	filename = newFilename;
 	filesize = file.getSize();
 	tigerTree.emplace(*this, filesize, filename.getResolved());
+	loadTigerTreeState();
+	openJournal();
 	motherBoard.getMSXCliComm().update(CliComm::UpdateType::MEDIA, getName(),
 	                                   filename.getResolved());
 }
@@ -111,15 +133,25 @@ size_t HD::getNbSectorsImpl() const
 void HD::readSectorsImpl(
 	std::span<SectorBuffer> buffers, size_t startSector)
 {
+	journal->flushOtherFile(file);
 	file.seek(startSector * sizeof(SectorBuffer));
 	file.read(buffers);
 }
 
 void HD::writeSectorImpl(size_t sector, const SectorBuffer& buf)
 {
-	file.seek(sector * sizeof(buf));
-	file.write(buf.raw);
-	tigerTree->notifyChange(sector * sizeof(buf), sizeof(buf),
+	writeSectorsImpl(std::span{&buf, 1}, sector);
+}
+
+void HD::writeSectorsImpl(
+	std::span<const SectorBuffer> buffers, size_t startSector)
+{
+	// The journal is only needed to be able to go back in time, so only
+	// while reverse is collecting. Otherwise the recorded history is of
+	// no use anymore.
+	journal->writeSectors(file, buffers, startSector,
+	                      motherBoard.getReverseManager().isCollecting());
+	tigerTree->notifyChange(startSector * sizeof(SectorBuffer), buffers.size_bytes(),
 	                        file.getModificationDate());
 }
 
@@ -133,6 +165,7 @@ Sha1Sum HD::getSha1SumImpl(FilePool& filePool)
 	if (hasPatches()) {
 		return SectorAccessibleDisk::getSha1SumImpl(filePool);
 	}
+	journal->flushOtherFile(file);
 	return filePool.getSha1Sum(file);
 }
 
@@ -163,6 +196,120 @@ std::string HD::getTigerTreeHash()
 	return tigerTree->calcHash(callback).toString(); // calls HD::getData()
 }
 
+// The (upper part of the) tiger tree of an image is stored in a cache file,
+// so that the (possibly multi-GB) image doesn't need to be hashed again on
+// the next run. The cache file starts with the name of the image, followed
+// by the TigerTree state (which is only used when the image was not
+// modified since the state was saved).
+static std::string getTigerTreeCacheDir()
+{
+	return strCat(FileOperations::getUserDataDir(), "/tigertree");
+}
+static std::string getTigerTreeCacheFile(std::string_view imageName)
+{
+	return strCat(getTigerTreeCacheDir(), '/', hex_string<8>(xxhash(imageName)), ".tth");
+}
+static uint32_t hashTigerTreeState(std::span<const uint8_t> state)
+{
+	return xxhash(std::string_view(std::bit_cast<const char*>(state.data()), state.size()));
+}
+
+// Keep the cache directory bounded: remove the files of images that no longer
+// exist and, when there are still too many, the least recently written ones.
+static void pruneTigerTreeCache()
+{
+	static constexpr size_t MAX_CACHE_FILES = 64;
+	struct Entry {
+		std::string path;
+		time_t time;
+	};
+	std::vector<Entry> entries;
+	foreach_file(getTigerTreeCacheDir(), [&](const std::string& path, std::string_view name,
+	                                         const FileOperations::Stat& st) {
+		if (!name.ends_with(".tth")) return;
+		bool stale = true;
+		try {
+			File cache(path);
+			auto data = cache.mmap();
+			if (auto it = ranges::find(data, '\0'); it != data.end()) {
+				std::string imageName(data.begin(), it);
+				stale = !FileOperations::isRegularFile(imageName);
+			}
+		} catch (MSXException&) {
+			// unreadable, remove it
+		}
+		if (stale) {
+			FileOperations::unlink(path);
+		} else {
+			entries.emplace_back(path, FileOperations::getModificationDate(st));
+		}
+	});
+	if (entries.size() <= MAX_CACHE_FILES) return;
+	ranges::sort(entries, {}, &Entry::time);
+	for (const auto& e : std::span{entries}.first(entries.size() - MAX_CACHE_FILES)) {
+		FileOperations::unlink(e.path);
+	}
+}
+
+void HD::loadTigerTreeState()
+{
+	// the run-ahead shadow machine never needs the hash
+	if (motherBoard.isShadow()) return;
+	cachedTigerTreeState.reset();
+	const auto& imageName = filename.getResolved();
+	try {
+		File cache(getTigerTreeCacheFile(imageName));
+		auto data = cache.mmap();
+		auto header = strCat(imageName, '\0');
+		if (data.size() < header.size() ||
+		    !std::equal(header.begin(), header.end(), data.begin())) {
+			return; // different image with the same hash
+		}
+		auto state = data.subspan(header.size());
+		if (tigerTree->loadState(state)) {
+			cachedTigerTreeState = hashTigerTreeState(state);
+		}
+	} catch (MSXException&) {
+		// no (valid) cache, ignore
+	}
+}
+
+void HD::saveTigerTreeState()
+{
+	if (motherBoard.isShadow()) return;
+	auto state = tigerTree->saveState();
+	if (state.empty()) return;
+	auto stateHash = hashTigerTreeState(state);
+	if (cachedTigerTreeState == stateHash) return; // not changed
+	const auto& imageName = filename.getResolved();
+	try {
+		FileOperations::mkdirp(getTigerTreeCacheDir());
+		{
+			File cache(getTigerTreeCacheFile(imageName), File::OpenMode::TRUNCATE);
+			cache.write(std::span{imageName.c_str(), imageName.size() + 1});
+			cache.write(std::span{state});
+		}
+		cachedTigerTreeState = stateHash;
+		pruneTigerTreeCache();
+	} catch (MSXException&) {
+		// it's only a cache, ignore
+	}
+}
+
+void HD::openJournal()
+{
+	journal = HDJournal::get(filename.getResolved());
+}
+
+bool HD::restoreJournal(uint64_t journalId, unsigned checkpoint)
+{
+	if (journalId != journal->getId()) return false;
+	return journal->restore(file, checkpoint, [&](size_t sector) {
+		tigerTree->notifyChange(sector * sizeof(SectorBuffer), sizeof(SectorBuffer),
+		                        file.getModificationDate());
+	});
+}
+
 uint8_t* HD::getData(size_t offset, size_t size)
 {
 	assert(size <= TigerTree::BLOCK_SIZE);
@@ -217,6 +364,7 @@ int HD::insertDisk(const std::string& newFilename)
 
 // version 1: initial version
 // version 2: replaced 'checksum'(=sha1) with 'tthsum`
+// version 3: added 'journalId' and 'journalCheckpoint'
 template<typename Archive>
 void HD::serialize(Archive& ar, unsigned version)
 {
@@ -240,6 +388,7 @@ void HD::serialize(Archive& ar, unsigned version)
 			//  - So to get in the same state as the initial
 			//    savestate we again close the file. Otherwise the
 			//    checksum-check code below goes wrong.
+			journal->forgetFile(file);
 			file.close();
 		} else {
 			tmp.updateAfterLoadState();
@@ -252,6 +401,24 @@ void HD::serialize(Archive& ar, unsigned version)
 	if (file.is_open()) {
 		bool mismatch = false;
 
+		if (ar.versionAtLeast(version, 3)) {
+			// When (within this session) the image was written after
+			// this state was saved, the journal can undo those writes.
+			uint64_t journalId = 0;
+			unsigned journalCheckpoint = HDJournal::NONE;
+			if constexpr (!Archive::IS_LOADER) {
+				journalId = journal->getId();
+				journalCheckpoint = journal->checkpoint();
+			}
+			ar.serialize("journalId", journalId,
+			             "journalCheckpoint", journalCheckpoint);
+			if constexpr (Archive::IS_LOADER) {
+				// If not possible, the checksum check below will
+				// (likely) fail.
+				(void)restoreJournal(journalId, journalCheckpoint);
+			}
+		}
+
 		if (ar.versionAtLeast(version, 2)) {
 			// use tiger-tree-hash
 			string oldTiger;
@@ -260,6 +427,9 @@ void HD::serialize(Archive& ar, unsigned version)
 			}
 			ar.serialize("tthsum", oldTiger);
 			if constexpr (Archive::IS_LOADER) {
+				// (the shadow machine uses the same image as the
+				// real machine, so there's no need to check)
+				if (motherBoard.isShadow()) return;
 				string newTiger = getTigerTreeHash();
 				mismatch = oldTiger != newTiger;
 			}
@@ -5,6 +5,7 @@
 #include "File.hh"
 #include "Filename.hh"
 #include "HDCommand.hh"
+#include "HDJournal.hh"
 #include "SectorAccessibleDisk.hh"
 #include "MSXMotherBoard.hh"
 #include "TigerTree.hh"
@@ -48,6 +49,8 @@ private:
 	void readSectorsImpl(
 		std::span<SectorBuffer> buffers, size_t startSector) override;
 	void writeSectorImpl(size_t sector, const SectorBuffer& buf) override;
+	void writeSectorsImpl(
+		std::span<const SectorBuffer> buffers, size_t startSector) override;
 	[[nodiscard]] size_t getNbSectorsImpl() const override;
 	[[nodiscard]] bool isWriteProtectedImpl() const override;
 	[[nodiscard]] Sha1Sum getSha1SumImpl(FilePool& filePool) override;
@@ -63,12 +66,20 @@ private:
 	[[nodiscard]] bool isCacheStillValid(time_t& time) override;
 
 	void showProgress(size_t position, size_t maxPosition);
+	void loadTigerTreeState();
+	void saveTigerTreeState();
+	void openJournal();
+	[[nodiscard]] bool restoreJournal(uint64_t journalId, unsigned checkpoint);
 
 private:
 	MSXMotherBoard& motherBoard;
 	std::string name;
 	std::optional<HDCommand> hdCommand; // delayed init
 	std::optional<TigerTree> tigerTree; // delayed init
+	std::shared_ptr<HDJournal> journal;
+	// hash of the tiger tree state as it is in the cache file (after
+	// loading or saving it), avoids rewriting an unchanged state
+	std::optional<uint32_t> cachedTigerTreeState;
 
 	File file;
 	Filename filename;
@@ -81,7 +92,7 @@ private:
 };
 
 REGISTER_BASE_CLASS(HD, "HD");
-SERIALIZE_CLASS_VERSION(HD, 2);
+SERIALIZE_CLASS_VERSION(HD, 3);
 
 } // namespace openmsx
 
@@ -0,0 +1,253 @@
+#include "HDJournal.hh"
+
+#include "File.hh"
+
+#include "lz4.hh"
+#include "random.hh"
+#include "ranges.hh"
+#include "xrange.hh"
+
+#include <cassert>
+
+namespace openmsx {
+
+HDJournal::Sector::Sector(const SectorBuffer& buf, size_t& memoryUsage_)
+	: memoryUsage(memoryUsage_)
+{
+	data.resize(LZ4::compressBound(int(sizeof(buf))));
+	auto len = size_t(LZ4::compress(buf.raw.data(), data.data(), int(sizeof(buf))));
+	if (len < sizeof(buf)) {
+		data.resize(len);
+	} else {
+		// not compressible, store raw
+		data.assign(buf.raw.begin(), buf.raw.end());
+	}
+	data.shrink_to_fit();
+	memoryUsage += data.size();
+}
+
+HDJournal::Sector::~Sector()
+{
+	memoryUsage -= data.size();
+}
+
+void HDJournal::Sector::get(SectorBuffer& buf) const
+{
+	if (data.size() == sizeof(buf)) {
+		ranges::copy(data, buf.raw);
+	} else {
+		LZ4::decompress(data.data(), buf.raw.data(), int(data.size()), int(sizeof(buf)));
+	}
+}
+
+
+HDJournal::HDJournal(size_t budget_)
+	: budget(budget_)
+	, id((uint64_t(random_32bit()) << 32) | random_32bit())
+{
+}
+
+std::shared_ptr<HDJournal> HDJournal::get(const std::string& imageName)
+{
+	// Journals are shared by all HD objects (in all machines) that use the
+	// same image, and live as long as one of them does.
+	static std::map<std::string, std::weak_ptr<HDJournal>, std::less<>> journals;
+	auto& weak = journals[imageName];
+	auto result = weak.lock();
+	if (!result) {
+		result = std::make_shared<HDJournal>();
+		weak = result;
+	}
+	return result;
+}
+
+HDJournal::SectorData HDJournal::makeSector(const SectorBuffer& buf)
+{
+	return std::make_shared<const Sector>(buf, memoryUsage);
+}
+
+void HDJournal::recordWrite(size_t sector, const SectorBuffer& newContent,
+                            function_ref<void(SectorBuffer&)> readOriginal)
+{
+	if (!base.contains(sector)) {
+		SectorBuffer original;
+		readOriginal(original);
+		base.emplace(sector, makeSector(original));
+	}
+	pending.insert_or_assign(sector, makeSector(newContent));
+	enforceBudget();
+}
+
+unsigned HDJournal::checkpoint()
+{
+	if (pending.empty() && checkpoints.contains(current)) {
+		// Nothing was written since the current checkpoint. This is
+		// the common case when states are saved often (e.g. each frame
+		// for run-ahead).
+		return current;
+	}
+	auto cp = nextId++;
+	checkpoints.emplace(cp, Checkpoint{current, std::move(pending)});
+	pending.clear();
+	current = cp;
+	enforceBudget();
+	return cp;
+}
+
+HDJournal::Delta HDJournal::resolve(unsigned cp, const Delta& extra) const
+{
+	Delta result = extra;
+	while (cp != NONE) {
+		auto it = checkpoints.find(cp);
+		assert(it != checkpoints.end());
+		for (const auto& [sector, data] : it->second.delta) {
+			result.try_emplace(sector, data); // newest content wins
+		}
+		cp = it->second.parent;
+	}
+	return result;
+}
+
+bool HDJournal::restore(unsigned cp,
+                        function_ref<void(size_t, const SectorBuffer&)> write)
+{
+	if (!checkpoints.contains(cp)) return false;
+	if (cp == current && pending.empty()) return true;
+
+	auto target = resolve(cp, Delta());
+	auto now = resolve(current, pending);
+	SectorBuffer buf;
+	for (const auto& [sector, original] : base) {
+		const auto* t = lookup(target, sector);
+		const auto* n = lookup(now, sector);
+		const auto& want = t ? *t : original;
+		const auto& have = n ? *n : original;
+		if (want != have) {
+			want->get(buf);
+			write(sector, buf);
+		}
+	}
+	pending.clear();
+	current = cp;
+	return true;
+}
+
+void HDJournal::flushOtherFile(const File& file)
+{
+	if (unflushed && (unflushed != &file)) {
+		unflushed->flush();
+		unflushed = nullptr;
+	}
+}
+
+void HDJournal::forgetFile(const File& file)
+{
+	if (unflushed == &file) unflushed = nullptr;
+}
+
+void HDJournal::writeSectors(File& file, std::span<const SectorBuffer> buffers,
+                             size_t startSector, bool record)
+{
+	flushOtherFile(file);
+	if (record) {
+		for (auto i : xrange(buffers.size())) {
+			auto sector = startSector + i;
+			recordWrite(sector, buffers[i], [&](SectorBuffer& original) {
+				file.seek(sector * sizeof(SectorBuffer));
+				file.read(original.raw);
+			});
+		}
+	} else if (!empty()) {
+		clear();
+	}
+	file.seek(startSector * sizeof(SectorBuffer));
+	file.write(buffers);
+	unflushed = &file;
+}
+
+bool HDJournal::restore(File& file, unsigned cp,
+                        function_ref<void(size_t)> changed)
+{
+	flushOtherFile(file);
+	bool result = restore(cp, [&](size_t sector, const SectorBuffer& buf) {
+		file.seek(sector * sizeof(buf));
+		file.write(buf.raw);
+		changed(sector);
+	});
+	// rare, so simply flush right away
+	file.flush();
+	return result;
+}
+
+void HDJournal::clear()
+{
+	checkpoints.clear();
+	base.clear();
+	pending.clear();
+	current = NONE;
+	assert(memoryUsage == 0);
+}
+
+void HDJournal::dropCheckpoint(std::map<unsigned, Checkpoint>::iterator it)
+{
+	auto dropped = it->first;
+	auto& cp = it->second;
+	if (cp.parent == NONE) {
+		// The content of this checkpoint becomes the new 'base', that
+		// releases the (older) content it replaces. Other roots (other
+		// timelines) still need that older content.
+		std::vector<Checkpoint*> otherRoots;
+		for (auto& [i, other] : checkpoints) {
+			if (other.parent == NONE && i != dropped) otherRoots.push_back(&other);
+		}
+		for (const auto& [sector, data] : cp.delta) {
+			auto* b = lookup(base, sector);
+			assert(b);
+			for (auto* other : otherRoots) {
+				other->delta.try_emplace(sector, *b);
+			}
+			*b = data;
+		}
+		for (auto& [i, child] : checkpoints) {
+			if (child.parent == dropped) child.parent = NONE;
+		}
+		// When no other checkpoint (nor 'pending') has a different
+		// content for a sector, the image itself has this content, so
+		// then it's not needed in 'base' either.
+		for (const auto& [sector, data] : cp.delta) {
+			if (pending.contains(sector)) continue;
+			if (ranges::any_of(checkpoints, [&](const auto& p) {
+				return (p.first != dropped) && p.second.delta.contains(sector);
+			})) continue;
+			base.erase(sector);
+		}
+	} else {
+		// Children now directly follow the parent of the dropped
+		// checkpoint, so they must include its changes.
+		for (auto& [i, child] : checkpoints) {
+			if (child.parent != dropped) continue;
+			for (const auto& [sector, data] : cp.delta) {
+				child.delta.try_emplace(sector, data);
+			}
+			child.parent = cp.parent;
+		}
+	}
+	checkpoints.erase(it);
+}
+
+void HDJournal::enforceBudget()
+{
+	while ((memoryUsage > budget) || (checkpoints.size() > MAX_CHECKPOINTS)) {
+		// drop the oldest checkpoint, except the current one
+		auto it = ranges::find_if(checkpoints, [&](const auto& p) { return p.first != current; });
+		if (it == checkpoints.end()) {
+			// Only the original content remains, nothing more we can
+			// drop. Give up on everything recorded so far.
+			clear();
+			return;
+		}
+		dropCheckpoint(it);
+	}
+}
+
+} // namespace openmsx
@@ -0,0 +1,154 @@
+#ifndef HDJOURNAL_HH
+#define HDJOURNAL_HH
+
+#include "DiskImageUtils.hh"
+
+#include "function_ref.hh"
+#include "hash_map.hh"
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace openmsx {
+
+class File;
+
+/** A copy-on-write journal of the sector writes to a hard disk image.
+  *
+  * Hard disk images are not part of a savestate (they're too big), only a
+  * hash of the content is stored. Without this journal, going back in time
+  * (reverse) past a write to the disk would result in a mismatch between
+  * the state of the machine and the content of the image.
+  *
+  * Each time the state of the HD is saved, a checkpoint is created. Per
+  * checkpoint the journal stores the (new) content of the sectors that were
+  * written since the previous checkpoint, and for each sector that was ever
+  * written, the original content. With that any earlier checkpoint can be
+  * restored by only rewriting the sectors that differ. Because reverse can
+  * create alternative timelines, the checkpoints form a tree.
+  *
+  * The sector content is LZ4 compressed and shared between checkpoints. The
+  * total memory usage is bounded: when it grows too large, the oldest
+  * checkpoints are dropped (the content of the oldest remaining one then
+  * replaces the original content), and eventually the whole journal.
+  *
+  * The same journal is shared by all HD objects that use the same image (so
+  * also by the HD in an MSXMotherBoard that is created by reverse).
+  */
+class HDJournal
+{
+public:
+	static constexpr unsigned NONE = unsigned(-1);
+	static constexpr size_t DEFAULT_BUDGET = 64 * 1024 * 1024;
+	static constexpr size_t MAX_CHECKPOINTS = 10000;
+
+	explicit HDJournal(size_t budget = DEFAULT_BUDGET);
+
+	/** Get (or create) the journal for the given (resolved) image name. */
+	[[nodiscard]] static std::shared_ptr<HDJournal> get(const std::string& imageName);
+
+	/** Identifies this journal, different in each openMSX session. */
+	[[nodiscard]] uint64_t getId() const { return id; }
+
+	/** Record a write to the given sector. The 'readOriginal' callback is
+	  * only called when the sector was not written before, it must read
+	  * the current (not yet overwritten) content of the sector.
+	  */
+	void recordWrite(size_t sector, const SectorBuffer& newContent,
+	                 function_ref<void(SectorBuffer&)> readOriginal);
+
+	/** Create a checkpoint for the current content of the image. When
+	  * nothing was written since the current checkpoint, that one is
+	  * returned again. */
+	[[nodiscard]] unsigned checkpoint();
+
+	/** Bring the image back to the content of the given checkpoint.
+	  * 'write' is called for each sector that has to be rewritten.
+	  * Returns false when the checkpoint is not (or no longer) known, then
+	  * nothing is written.
+	  */
+	[[nodiscard]] bool restore(unsigned cp,
+	             function_ref<void(size_t, const SectorBuffer&)> write);
+
+	/** The same image can be opened by several File objects (e.g. by the
+	  * HD of the old and of the new machine while going back in time).
+	  * One must neither read stale data nor have its writes undone when
+	  * another one writes out its buffered data later (e.g. when that
+	  * File is closed). So before accessing the image via 'file', call
+	  * this method: it flushes the File that has buffered writes, if
+	  * that's a different one.
+	  */
+	void flushOtherFile(const File& file);
+
+	/** Must be called before the given File is closed or destroyed. */
+	void forgetFile(const File& file);
+
+	/** Write sectors to the image file. When 'record' is true the writes
+	  * are first recorded (the original content is read from the same
+	  * file), otherwise the journal is cleared.
+	  */
+	void writeSectors(File& file, std::span<const SectorBuffer> buffers,
+	                  size_t startSector, bool record);
+
+	/** Like restore() above, but rewrite the sectors directly in the
+	  * image file (which is flushed). 'changed' is called for each
+	  * rewritten sector.
+	  */
+	[[nodiscard]] bool restore(File& file, unsigned cp,
+	                           function_ref<void(size_t)> changed);
+
+	/** Forget everything, the current content becomes the new original. */
+	void clear();
+	[[nodiscard]] bool empty() const { return base.empty() && checkpoints.empty(); }
+
+	[[nodiscard]] size_t getMemoryUsage() const { return memoryUsage; }
+	[[nodiscard]] size_t getNumCheckpoints() const { return checkpoints.size(); }
+
+private:
+	class Sector {
+	public:
+		Sector(const SectorBuffer& buf, size_t& memoryUsage);
+		~Sector();
+		Sector(const Sector&) = delete;
+		Sector& operator=(const Sector&) = delete;
+
+		void get(SectorBuffer& buf) const;
+
+	private:
+		std::vector<uint8_t> data; // compressed, or raw if that's smaller
+		size_t& memoryUsage;
+	};
+	using SectorData = std::shared_ptr<const Sector>;
+	using Delta = hash_map<size_t, SectorData>;
+
+	struct Checkpoint {
+		unsigned parent;
+		Delta delta;
+	};
+
+	[[nodiscard]] SectorData makeSector(const SectorBuffer& buf);
+	/** The content of all sectors that differ from 'base' in checkpoint
+	  * 'cp', with 'extra' taking precedence. */
+	[[nodiscard]] Delta resolve(unsigned cp, const Delta& extra) const;
+	void enforceBudget();
+	void dropCheckpoint(std::map<unsigned, Checkpoint>::iterator it);
+
+private:
+	size_t memoryUsage = 0; // must outlive all Sector objects
+	size_t budget;
+	uint64_t id;
+	std::map<unsigned, Checkpoint> checkpoints;
+	Delta base;    // original content, for all sectors that differ in some checkpoint
+	Delta pending; // written since the current checkpoint
+	unsigned current = NONE;
+	unsigned nextId = 0;
+	File* unflushed = nullptr; // possibly has buffered writes
+};
+
+} // namespace openmsx
+
+#endif
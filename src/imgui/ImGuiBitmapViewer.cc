@@ -14,6 +14,9 @@
 
 #include <imgui.h>
 
+#include <chrono>
+#include <vector>
+
 namespace openmsx {
 
 using namespace std::literals;
@@ -520,15 +523,9 @@ void ImGuiBitmapViewer::paint(MSXMotherBoard* motherBoard)
 			[](uint16_t msx) { return ImGuiPalette::toRGBA(msx); });
 		if (color0 < 16) palette[0] = palette[color0];
 
-		MemBuffer<uint32_t> pixels(512 * 256 * 4); // max size: screen 6/7, show all pages
-		renderBitmap(vram.getData(), palette, mode, height, page,
-				pixels.data());
-		if (!bitmapTex) {
-			bitmapTex.emplace(false, false); // no interpolation, no wrapping
-		}
-		bitmapTex->bind();
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0,
-				GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+		updateBitmap(vram, DecodeKey{mode, page, height, palette,
+		                             getVramGeneration(vram, mode, page, height)},
+		             gl::ivec2{width, height});
 		int zx = (1 + bitmapZoom) * divX;
 		int zy = (1 + bitmapZoom) * 2;
 		auto zm = gl::vec2(float(zx), float(zy));
@@ -545,18 +542,22 @@ void ImGuiBitmapViewer::paint(MSXMotherBoard* motherBoard)
 
 			if (bitmapGrid && (zx > 1) && (zy > 1)) {
 				auto color = ImGui::ColorConvertFloat4ToU32(bitmapGridColor);
-				for (auto y : xrange(zy)) {
-					auto* line = &pixels[y * zx];
-					for (auto x : xrange(zx)) {
-						line[x] = (x == 0 || y == 0) ? color : 0;
+				if (!bitmapGridTex || (bitmapGridKey != gl::ivec3(zx, zy, int(color)))) {
+					MemBuffer<uint32_t> pixels(zx * zy);
+					for (auto y : xrange(zy)) {
+						auto* line = &pixels[y * zx];
+						for (auto x : xrange(zx)) {
+							line[x] = (x == 0 || y == 0) ? color : 0;
+						}
 					}
+					if (!bitmapGridTex) {
+						bitmapGridTex.emplace(false, true); // no interpolation, with wrapping
+					}
+					bitmapGridTex->bind();
+					glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, zx, zy, 0,
+							GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+					bitmapGridKey = gl::ivec3(zx, zy, int(color));
 				}
-				if (!bitmapGridTex) {
-					bitmapGridTex.emplace(false, true); // no interpolation, with wrapping
-				}
-				bitmapGridTex->bind();
-				glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, zx, zy, 0,
-						GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
 				ImGui::SetCursorPos(pos);
 				ImGui::Image(bitmapGridTex->getImGui(), size, gl::vec2{}, msxSize);
 			}
@@ -685,9 +686,60 @@ void ImGuiBitmapViewer::paint(MSXMotherBoard* motherBoard)
 	});
 }
 
+uint64_t ImGuiBitmapViewer::getVramGeneration(const VDPVRAM& vram, int mode, int page, int lines)
+{
+	// the VRAM range that's read by renderBitmap()
+	auto begin = unsigned(0x8000 * page);
+	auto end = begin + unsigned(128 * lines);
+	auto result = vram.getGeneration(begin, end);
+	if (mode == one_of(SCR7, SCR8, SCR11, SCR12)) {
+		// planar modes
+		result += vram.getGeneration(begin + 0x10000, end + 0x10000);
+	}
+	return result;
+}
+
+void ImGuiBitmapViewer::updateBitmap(const VDPVRAM& vram, const DecodeKey& key, gl::ivec2 size)
+{
+	// Normally the result of a background decode is only shown once it's
+	// finished (so possibly one frame late). But when there's no usable
+	// image yet (e.g. the size changed), wait for it.
+	auto mustWait = [&] { return !bitmapTex || (bitmapTexSize != size); };
+	if (pendingDecode.valid() &&
+	    (mustWait() || (pendingDecode.wait_for(std::chrono::seconds(0)) == std::future_status::ready))) {
+		uploadBitmap(pendingDecode.get());
+	}
+	if (bitmapTexKey == key) return; // VRAM, palette and mode didn't change
+	if (pendingDecode.valid()) return; // try again next frame
+
+	auto vramData = vram.getData();
+	pendingDecode = std::async(std::launch::async,
+		[key, size, vramCopy = std::vector<uint8_t>(vramData.begin(), vramData.end())] {
+			DecodeResult result{key, size, MemBuffer<uint32_t>(size.x * size.y)};
+			renderBitmap(vramCopy, key.palette, key.mode, key.lines, key.page,
+			             result.pixels.data());
+			return result;
+		});
+	if (mustWait()) {
+		uploadBitmap(pendingDecode.get());
+	}
+}
+
+void ImGuiBitmapViewer::uploadBitmap(const DecodeResult& result)
+{
+	if (!bitmapTex) {
+		bitmapTex.emplace(false, false); // no interpolation, no wrapping
+	}
+	bitmapTex->bind();
+	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, result.size.x, result.size.y, 0,
+			GL_RGBA, GL_UNSIGNED_BYTE, result.pixels.data());
+	bitmapTexKey = result.key;
+	bitmapTexSize = result.size;
+}
+
 // TODO avoid code duplication with src/video/BitmapConverter
 void ImGuiBitmapViewer::renderBitmap(std::span<const uint8_t> vram, std::span<const uint32_t, 16> palette16,
-                                     int mode, int lines, int page, uint32_t* output) const
+                                     int mode, int lines, int page, uint32_t* output)
 {
 	auto yjk2rgb = [](int y, int j, int k) -> std::tuple<int, int, int> {
 		// Note the formula for 'blue' differs from the 'traditional' formula
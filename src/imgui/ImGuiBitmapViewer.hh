@@ -4,16 +4,21 @@
 #include "ImGuiPart.hh"
 
 #include "GLUtil.hh"
+#include "MemBuffer.hh"
 #include "gl_vec.hh"
 #include "static_vector.hh"
 
+#include <array>
 #include <cstdint>
+#include <future>
 #include <optional>
 #include <span>
 #include <string>
 
 namespace openmsx {
 
+class VDPVRAM;
+
 class ImGuiBitmapViewer final : public ImGuiPart
 {
 public:
@@ -28,8 +33,25 @@ public:
 	void paint(MSXMotherBoard* motherBoard) override;
 
 private:
-	void renderBitmap(std::span<const uint8_t> vram, std::span<const uint32_t, 16> palette16,
-	                  int mode, int lines, int page, uint32_t* output) const;
+	// The decoded bitmap only depends on these values. So as long as they
+	// don't change, there's no need to decode (and upload) it again.
+	struct DecodeKey {
+		int mode, page, lines;
+		std::array<uint32_t, 16> palette;
+		uint64_t vramGeneration;
+		[[nodiscard]] bool operator==(const DecodeKey&) const = default;
+	};
+	struct DecodeResult {
+		DecodeKey key;
+		gl::ivec2 size;
+		MemBuffer<uint32_t> pixels;
+	};
+
+	[[nodiscard]] static uint64_t getVramGeneration(const VDPVRAM& vram, int mode, int page, int lines);
+	void updateBitmap(const VDPVRAM& vram, const DecodeKey& key, gl::ivec2 size);
+	void uploadBitmap(const DecodeResult& result);
+	static void renderBitmap(std::span<const uint8_t> vram, std::span<const uint32_t, 16> palette16,
+	                         int mode, int lines, int page, uint32_t* output);
 
 public:
 	bool show = true;
@@ -53,7 +75,11 @@ private:
 	bool rasterBeam = false;
 
 	std::optional<gl::Texture> bitmapTex; // TODO also deallocate when needed
+	std::optional<DecodeKey> bitmapTexKey; // current content of 'bitmapTex'
+	gl::ivec2 bitmapTexSize;
+	std::future<DecodeResult> pendingDecode; // decoding in a background thread
 	std::optional<gl::Texture> bitmapGridTex;
+	gl::ivec3 bitmapGridKey; // zoomX, zoomY, color
 
 	int showCmdOverlay = 0; // 0->none, 1->in-progress, 2->also finished
 	gl::vec4 colorSrcDone{0.0f, 1.0f, 0.0f, 0.66f};
@@ -390,7 +390,8 @@ void ImGuiBreakPoints::paintTab(MSXCPUInterface& cpuInterface, Debugger& debugge
 				to_underlying(WatchPoint::Type::WRITE_MEM),
 				{}, {}, {}, {}, // address
 				{}, // cond
-				makeTclList("debug", "break")};
+				makeTclList("debug", "break"),
+				{}}; // action
 			if (addr) {
 				item.wantEnable = false;
 				item.addr = addr;
@@ -452,6 +453,12 @@ static const std::vector<DebugCondition>& getOpenMSXItems(DebugCondition*, const
 [[nodiscard]] static TclObject getCommand(const BreakPointBase& bp) { return bp.getCommand(); }
 [[nodiscard]] static TclObject getCommand(const std::shared_ptr<WatchPoint>& wp) { return wp->getCommand(); }
 
+[[nodiscard]] static TclObject getAction(const std::shared_ptr<WatchPoint>& wp)
+{
+	const auto& action = wp->getAction();
+	return action ? action->getSpec() : TclObject{};
+}
+
 
 template<typename Item>
 void ImGuiBreakPoints::syncFromOpenMsx(std::vector<GuiItem>& items, MSXCPUInterface& cpuInterface)
@@ -483,6 +490,7 @@ void ImGuiBreakPoints::syncFromOpenMsx(std::vector<GuiItem>& items, MSXCPUInterf
 			// item exists on the openMSX side, make sure it's in sync
 			if constexpr (isWatchPoint) {
 				it->wpType = to_underlying(item->getType());
+				it->action = getAction(item);
 			}
 			if constexpr (hasAddress) {
 				assert(it->addr);
@@ -510,8 +518,10 @@ void ImGuiBreakPoints::syncFromOpenMsx(std::vector<GuiItem>& items, MSXCPUInterf
 			std::optional<uint16_t> endAddr;
 			TclObject addrStr;
 			TclObject endAddrStr;
+			TclObject action;
 			if constexpr (isWatchPoint) {
 				wpType = item->getType();
+				action = getAction(item);
 			}
 			if constexpr (hasAddress) {
 				addr = getAddress(item);
@@ -525,7 +535,7 @@ void ImGuiBreakPoints::syncFromOpenMsx(std::vector<GuiItem>& items, MSXCPUInterf
 				true,
 				to_underlying(wpType),
 				addr, endAddr, std::move(addrStr), std::move(endAddrStr),
-				getCondition(item), getCommand(item)});
+				getCondition(item), getCommand(item), std::move(action)});
 			selectedRow = -1;
 		}
 	}
@@ -626,6 +636,10 @@ void ImGuiBreakPoints::syncToOpenMsx(
 {
 	Item* tag = nullptr;
 
+	// A watchpoint with a native action can't be re-created from the GUI
+	// (the action would be lost), leave it untouched.
+	if (!item.action.getString().empty()) return;
+
 	if (item.id > 0) {
 		// (temporarily) remove it from the openMSX side
 		remove(tag, cpuInterface, item.id); // temp remove it
@@ -657,11 +671,12 @@ void ImGuiBreakPoints::drawRow(MSXCPUInterface& cpuInterface, Debugger& debugger
 	};
 
 	bool needSync = false;
+	bool readOnly = !item.action.getString().empty(); // see GuiItem::action
 	std::string cond{item.cond.getString()};
 	std::string cmd {item.cmd .getString()};
 	bool validAddr = isValidAddr<Item>(item);
 	bool validCond = isValidCond<Item>(cond, interp);
-	bool validCmd  = isValidCmd(cmd, interp);
+	bool validCmd  = readOnly || isValidCmd(cmd, interp);
 
 	if (ImGui::TableNextColumn()) { // enable
 		auto pos = ImGui::GetCursorPos();
@@ -671,7 +686,7 @@ void ImGuiBreakPoints::drawRow(MSXCPUInterface& cpuInterface, Debugger& debugger
 			selectedRow = row;
 		}
 		ImGui::SetCursorPos(pos);
-		im::Disabled(!validAddr || !validCond || !validCmd, [&]{
+		im::Disabled(readOnly || !validAddr || !validCond || !validCmd, [&]{
 			if (ImGui::Checkbox("##enabled", &item.wantEnable)) {
 				needSync = true;
 			}
@@ -680,10 +695,12 @@ void ImGuiBreakPoints::drawRow(MSXCPUInterface& cpuInterface, Debugger& debugger
 	}
 	if (ImGui::TableNextColumn()) { // type
 		ImGui::SetNextItemWidth(-FLT_MIN);
-		if (ImGui::Combo("##type", &item.wpType, "read IO\000write IO\000read memory\000write memory\000")) {
-			validAddr = isValidAddr<Item>(item);
-			needSync = true;
-		}
+		im::Disabled(readOnly, [&]{
+			if (ImGui::Combo("##type", &item.wpType, "read IO\000write IO\000read memory\000write memory\000")) {
+				validAddr = isValidAddr<Item>(item);
+				needSync = true;
+			}
+		});
 		if (ImGui::IsItemActive()) selectedRow = row;
 	}
 	if (ImGui::TableNextColumn()) { // address
@@ -713,7 +730,7 @@ void ImGuiBreakPoints::drawRow(MSXCPUInterface& cpuInterface, Debugger& debugger
 			});
 			addrToolTip();
 			ImGui::SetCursorPos(pos);
-			if (ImGui::InvisibleButton("##range-button", {-FLT_MIN, rowHeight})) {
+			if (ImGui::InvisibleButton("##range-button", {-FLT_MIN, rowHeight}) && !readOnly) {
 				ImGui::OpenPopup("range-popup");
 			}
 			if (ImGui::IsItemActive()) selectedRow = row;
@@ -753,7 +770,7 @@ void ImGuiBreakPoints::drawRow(MSXCPUInterface& cpuInterface, Debugger& debugger
 			ImGui::TextUnformatted(slot.toDisplayString());
 		});
 		ImGui::SetCursorPos(pos);
-		if (ImGui::InvisibleButton("##cond-button", {-FLT_MIN, rowHeight})) {
+		if (ImGui::InvisibleButton("##cond-button", {-FLT_MIN, rowHeight}) && !readOnly) {
 			ImGui::OpenPopup("cond-popup");
 		}
 		if (ImGui::IsItemActive()) selectedRow = row;
@@ -768,6 +785,12 @@ void ImGuiBreakPoints::drawRow(MSXCPUInterface& cpuInterface, Debugger& debugger
 	if (ImGui::TableNextColumn()) { // action
 		setRedBg(validCmd);
 		im::Font(manager.fontMono, [&]{
+			if (readOnly) {
+				ImGui::TextUnformatted(tmpStrCat("-action ", item.action.getString()));
+				simpleToolTip("A watchpoint with a native action can't be edited here, "
+				              "only removed (use 'debug set_watchpoint' to create a new one).");
+				return;
+			}
 			ImGui::SetNextItemWidth(-FLT_MIN);
 			if (ImGui::InputText("##cmd", &cmd)) {
 				item.cmd = cmd;
@@ -46,6 +46,9 @@ public:
 		TclObject endAddrStr;
 		TclObject cond;
 		TclObject cmd;
+		TclObject action; // only for WatchPoint: the spec of its native
+		                  // action, if any. Then it's read-only in the GUI
+		                  // (re-creating it would lose the action).
 	};
 
 public:
@@ -338,14 +338,21 @@ void ImGuiCharacter::paint(MSXMotherBoard* motherBoard)
 			if (mode == SCR3) return {256, 256};
 			return {256,  64}; // SCR1, OTHER
 		}();
+		// Only render the patterns again when one of the inputs changed.
+		const auto& vdpVram = vdp->getVRAM();
+		PatternKey patternKey{mode, fgCol, bgCol, fgBlink, bgBlink, lines, patReg, colReg, palette,
+			patTable.getGeneration(vdpVram, 0x2000) + colTable.getGeneration(vdpVram, 0x2000)};
 		std::array<uint32_t, 256 * 256> pixels; // max size for SCR2
-		renderPatterns(mode, palette, fgCol, bgCol, fgBlink, bgBlink, patTable, colTable, lines, pixels);
-		if (!patternTex.get()) {
-			patternTex = gl::Texture(false, false); // no interpolation, no wrapping
+		if (!patternTex.get() || (patternTexKey != patternKey)) {
+			renderPatterns(mode, palette, fgCol, bgCol, fgBlink, bgBlink, patTable, colTable, lines, pixels);
+			if (!patternTex.get()) {
+				patternTex = gl::Texture(false, false); // no interpolation, no wrapping
+			}
+			patternTex.bind();
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, patternTexSize.x, patternTexSize.y, 0,
+				GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+			patternTexKey = patternKey;
 		}
-		patternTex.bind();
-		glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, patternTexSize.x, patternTexSize.y, 0,
-			GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
 
 		// create grid texture
 		auto charWidth = mode == one_of(TEXT40, TEXT80) ? 6 : 8;
@@ -356,18 +363,21 @@ void ImGuiCharacter::paint(MSXMotherBoard* motherBoard)
 			auto gColor = ImGui::ColorConvertFloat4ToU32(gridColor);
 			auto gridWidth = charWidth * zx;
 			auto gridHeight = 8 * zy;
-			for (auto y : xrange(gridHeight)) {
-				auto* line = &pixels[y * gridWidth];
-				for (auto x : xrange(gridWidth)) {
-					line[x] = (x == 0 || y == 0) ? gColor : 0;
+			if (!gridTex.get() || (gridTexKey != gl::ivec3(gridWidth, gridHeight, int(gColor)))) {
+				for (auto y : xrange(gridHeight)) {
+					auto* line = &pixels[y * gridWidth];
+					for (auto x : xrange(gridWidth)) {
+						line[x] = (x == 0 || y == 0) ? gColor : 0;
+					}
 				}
+				if (!gridTex.get()) {
+					gridTex = gl::Texture(false, true); // no interpolation, with wrapping
+				}
+				gridTex.bind();
+				glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, gridWidth, gridHeight, 0,
+					GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+				gridTexKey = gl::ivec3(gridWidth, gridHeight, int(gColor));
 			}
-			if (!gridTex.get()) {
-				gridTex = gl::Texture(false, true); // no interpolation, with wrapping
-			}
-			gridTex.bind();
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, gridWidth, gridHeight, 0,
-				GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
 		}
 		if (nameTableOverlay && !smallHexDigits.get()) {
 			initHexDigits();
@@ -6,6 +6,9 @@
 #include "GLUtil.hh"
 #include "gl_vec.hh"
 
+#include <array>
+#include <cstdint>
+#include <optional>
 #include <string>
 
 namespace openmsx {
@@ -64,6 +67,18 @@ private:
 
 	gl::Texture patternTex{gl::Null{}}; // TODO also deallocate when needed
 	gl::Texture gridTex   {gl::Null{}};
+
+	// The pattern texture only needs to be rendered again when one of
+	// these values changes.
+	struct PatternKey {
+		int mode, fgCol, bgCol, fgBlink, bgBlink, lines;
+		unsigned patReg, colReg;
+		std::array<uint32_t, 16> palette;
+		uint64_t vramGeneration;
+		[[nodiscard]] bool operator==(const PatternKey&) const = default;
+	};
+	std::optional<PatternKey> patternTexKey;
+	gl::ivec3 gridTexKey; // width, height, color
 	gl::Texture smallHexDigits{gl::Null{}};
 
 	static constexpr auto persistentElements = std::tuple{
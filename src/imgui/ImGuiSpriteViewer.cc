@@ -346,24 +346,31 @@ void ImGuiSpriteViewer::paint(MSXMotherBoard* motherBoard)
 		attTable.setRegister(attReg, 7);
 		attTable.setIndexSize((mode == 2) ? 10 : 7);
 
-		// create pattern texture
-		if (!patternTex.get()) {
-			patternTex = gl::Texture(false, false); // no interpolation, no wrapping
-		}
-		patternTex.bind();
+		// create pattern texture (only when one of the inputs changed)
 		std::array<uint32_t, 256 * 64> pixels;
-		if (mode != 0) {
-			if (size == 8) {
-				renderPatterns8 (patTable, pixels);
+		PatternKey patternKey{(mode != 0) ? size : 0, patReg, planar,
+		                      patTable.getGeneration(vdp->getVRAM(), 256 * 8),
+		                      getColor(imColor::TEXT), getColor(imColor::TRANSPARENT),
+		                      getColor(imColor::GRAY)};
+		if (!patternTex.get() || (patternTexKey != patternKey)) {
+			if (!patternTex.get()) {
+				patternTex = gl::Texture(false, false); // no interpolation, no wrapping
+			}
+			patternTex.bind();
+			if (mode != 0) {
+				if (size == 8) {
+					renderPatterns8 (patTable, pixels);
+				} else {
+					renderPatterns16(patTable, pixels);
+				}
+				glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 256, 64, 0,
+				             GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
 			} else {
-				renderPatterns16(patTable, pixels);
+				pixels[0] = getColor(imColor::GRAY);
+				glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0,
+				             GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
 			}
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 256, 64, 0,
-			             GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
-		} else {
-			pixels[0] = getColor(imColor::GRAY);
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, 1, 1, 0,
-			             GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+			patternTexKey = patternKey;
 		}
 
 		// create grid texture
@@ -371,19 +378,22 @@ void ImGuiSpriteViewer::paint(MSXMotherBoard* motherBoard)
 		auto gColor = ImGui::ColorConvertFloat4ToU32(gridColor);
 		if (grid) {
 			size_t gridSize = size * zm;
-			for (auto y : xrange(gridSize)) {
-				auto* line = &pixels[y * gridSize];
-				for (auto x : xrange(gridSize)) {
-					line[x] = (x == 0 || y == 0) ? gColor : 0;
+			if (!gridTex.get() || (gridTexKey != gl::ivec2(narrow<int>(gridSize), int(gColor)))) {
+				for (auto y : xrange(gridSize)) {
+					auto* line = &pixels[y * gridSize];
+					for (auto x : xrange(gridSize)) {
+						line[x] = (x == 0 || y == 0) ? gColor : 0;
+					}
 				}
+				if (!gridTex.get()) {
+					gridTex = gl::Texture(false, true); // no interpolation, with wrapping
+				}
+				gridTex.bind();
+				glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA,
+				             narrow<int>(gridSize), narrow<int>(gridSize),
+				             0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+				gridTexKey = gl::ivec2(narrow<int>(gridSize), int(gColor));
 			}
-			if (!gridTex.get()) {
-				gridTex = gl::Texture(false, true); // no interpolation, with wrapping
-			}
-			gridTex.bind();
-			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA,
-			             narrow<int>(gridSize), narrow<int>(gridSize),
-			             0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
 		}
 
 		// create checker board texture
@@ -6,6 +6,8 @@
 #include "GLUtil.hh"
 #include "gl_vec.hh"
 
+#include <cstdint>
+#include <optional>
 #include <string>
 
 namespace openmsx {
@@ -61,6 +63,22 @@ private:
 	gl::Texture checkerTex {gl::Null{}};
 	gl::Texture renderTex  {gl::Null{}};
 
+	// The pattern texture only needs to be rendered again when one of
+	// these values changes.
+	struct PatternKey {
+		int size; // 0 -> sprites disabled
+		unsigned patReg;
+		bool planar;
+		uint64_t vramGeneration;
+		// the (user configurable) colors used in the texture
+		uint32_t textColor;
+		uint32_t transparentColor;
+		uint32_t grayColor;
+		[[nodiscard]] bool operator==(const PatternKey&) const = default;
+	};
+	std::optional<PatternKey> patternTexKey;
+	gl::ivec2 gridTexKey; // size, color
+
 	static constexpr auto validSizes = {8, 16};
 	static constexpr auto persistentElements = std::tuple{
 		PersistentElement{"show",                &ImGuiSpriteViewer::show},
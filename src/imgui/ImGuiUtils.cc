@@ -8,6 +8,7 @@
 #include "IntegerSetting.hh"
 #include "FloatSetting.hh"
 #include "VideoSourceSetting.hh"
+#include "VDPVRAM.hh"
 #include "KeyMappings.hh"
 
 #include "ranges.hh"
@@ -340,4 +341,21 @@ void setColors(int style)
 	imColors[size_t(KEY_NOT_ACTIVE)] = 0x80'00'00'00;
 }
 
+uint64_t VramTable::getGeneration(const VDPVRAM& vdpVram, unsigned num) const
+{
+	// All accessed addresses are in the range [begin, begin + num), though
+	// depending on the register value not all addresses in this range are
+	// actually accessed.
+	auto begin = getAddress(0);
+	auto end = begin + num;
+	if (!planar) {
+		return vdpVram.getGeneration(begin, end);
+	}
+	// even addresses map to the 1st 64kB, odd addresses to the 2nd 64kB
+	auto b = begin >> 1;
+	auto e = (end + 1) >> 1;
+	return vdpVram.getGeneration(b, e) +
+	       vdpVram.getGeneration(b + 0x1'0000, e + 0x1'0000);
+}
+
 } // namespace openmsx
@@ -68,6 +68,7 @@ class FloatSetting;
 class HotKey;
 class IntegerSetting;
 class Setting;
+class VDPVRAM;
 class VideoSourceSetting;
 
 struct EnumToolTip {
@@ -333,6 +334,13 @@ public:
 		}
 		return vram[addr];
 	}
+
+	/** Returns a value that changes when the VRAM content that can be
+	  * accessed via the indices [0, num) changes (see
+	  * VDPVRAM::getGeneration()).
+	  */
+	[[nodiscard]] uint64_t getGeneration(const VDPVRAM& vdpVram, unsigned num) const;
+
 private:
 	std::span<const uint8_t> vram;
 	unsigned registerMask = 0;
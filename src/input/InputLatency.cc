@@ -0,0 +1,148 @@
+#include "InputLatency.hh"
+
+#include "TclObject.hh"
+#include "Timer.hh"
+
+#include "narrow.hh"
+#include "outer.hh"
+#include "ranges.hh"
+#include "strCat.hh"
+
+#include <algorithm>
+#include <vector>
+
+#include <SDL.h>
+
+namespace openmsx {
+
+InputLatency::InputLatency(InfoCommand& machineInfoCommand)
+	: info(machineInfoCommand)
+{
+}
+
+void InputLatency::beginEvent(const Event& event)
+{
+	using enum EventType;
+	Source source = [&] {
+		switch (getType(event)) {
+			case KEY_DOWN: case KEY_UP:
+				return Source::KEYBOARD;
+			case MOUSE_MOTION: case MOUSE_BUTTON_DOWN: case MOUSE_BUTTON_UP:
+			case JOY_AXIS_MOTION: case JOY_HAT:
+			case JOY_BUTTON_DOWN: case JOY_BUTTON_UP:
+				return Source::JOYSTICK_PORT;
+			default:
+				return Source::NUM;
+		}
+	}();
+	if (source == Source::NUM) return;
+
+	// Like in EventDelay: the SDL timestamp (in ms) tells how long ago
+	// the event was created.
+	const auto& sdlEvent = get_event<SdlEvent>(event);
+	auto sdlOffset = SDL_GetTicks() - sdlEvent.getCommonSdlEvent().timestamp;
+	auto now = Timer::getTime();
+	auto offset = std::min<uint64_t>(1000 * uint64_t(sdlOffset), now);
+	current = Current{source, now - offset};
+}
+
+void InputLatency::stateChanged()
+{
+	if (!current) return; // e.g. a Tcl command, not host input
+
+	auto& m = measurements[size_t(current->source)];
+	auto now = Timer::getTime();
+	if (m.stage != Stage::IDLE) {
+		if ((now - m.origin) < MAX_AGE) return; // already measuring
+		++discarded;
+	}
+	m.stage = Stage::CHANGED;
+	m.origin = current->origin;
+	m.changed = now;
+}
+
+void InputLatency::markRead(Source source, EmuTime::param time)
+{
+	auto& m = measurements[size_t(source)];
+	m.stage = Stage::READ;
+	m.read = Timer::getTime();
+	m.readTime = time;
+}
+
+void InputLatency::frameRendered(EmuTime::param frameEnd)
+{
+	for (auto& m : measurements) {
+		if ((m.stage == Stage::READ) && (m.readTime <= frameEnd)) {
+			m.stage = Stage::RENDERED;
+		}
+	}
+}
+
+void InputLatency::framePainted()
+{
+	auto now = Timer::getTime();
+	for (auto& m : measurements) {
+		if (m.stage != Stage::RENDERED) continue;
+		m.stage = Stage::IDLE;
+		if (samples.full()) samples.pop_front();
+		samples.push_back(Sample{
+			.dispatch = m.changed - m.origin,
+			.emulate  = m.read - m.changed,
+			.display  = now - m.read});
+	}
+}
+
+
+// class InputLatency::Info
+
+InputLatency::Info::Info(InfoCommand& machineInfoCommand)
+	: InfoTopic(machineInfoCommand, "input_latency")
+{
+}
+
+void InputLatency::Info::execute(
+	std::span<const TclObject> /*tokens*/, TclObject& result) const
+{
+	const auto& latency = OUTER(InputLatency, info);
+	const auto& samples = latency.getSamples();
+
+	std::vector<uint64_t> values(samples.size());
+	auto percentiles = [&](auto proj) {
+		std::ranges::transform(samples, values.begin(), proj);
+		ranges::sort(values);
+		// nearest-rank method
+		auto get = [&](unsigned p) -> uint64_t {
+			if (values.empty()) return 0;
+			auto rank = (p * values.size() + 99) / 100;
+			return values[std::max<size_t>(rank, 1) - 1];
+		};
+		return TclObject(TclObject::MakeDictTag{},
+			"p50", tmpStrCat(get(50)),
+			"p90", tmpStrCat(get(90)),
+			"p99", tmpStrCat(get(99)),
+			"max", tmpStrCat(get(100)));
+	};
+	result.addDictKeyValues(
+		"samples", narrow<int>(samples.size()),
+		"discarded", latency.discarded,
+		"total",    percentiles([](const Sample& s) { return s.total(); }),
+		"dispatch", percentiles(&Sample::dispatch),
+		"emulate",  percentiles(&Sample::emulate),
+		"display",  percentiles(&Sample::display));
+}
+
+std::string InputLatency::Info::help(std::span<const TclObject> /*tokens*/) const
+{
+	return strCat(
+	       "Returns statistics about the latency (in microseconds) between "
+	       "host input (keyboard, mouse, joystick) and the first painted "
+	       "frame in which the MSX has read the changed input. Percentiles "
+	       "(p50, p90, p99 and max) are given for the 'total' latency and "
+	       "for its parts: from host event till state change in the MSX "
+	       "('dispatch', this includes the 'inputdelay' setting), till the "
+	       "first read by the MSX program ('emulate') and till the frame "
+	       "containing that read is painted ('display'). Only the most "
+	       "recent ", MAX_SAMPLES, " measurements are used.\n");
+}
+
+} // namespace openmsx
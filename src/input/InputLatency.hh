@@ -0,0 +1,113 @@
+#ifndef INPUTLATENCY_HH
+#define INPUTLATENCY_HH
+
+#include "EmuTime.hh"
+#include "Event.hh"
+#include "InfoTopic.hh"
+
+#include "circular_buffer.hh"
+
+#include <array>
+#include <cstdint>
+#include <optional>
+
+namespace openmsx {
+
+/** Measures the latency between host input and the displayed picture.
+  *
+  * A measurement follows one host input event:
+  *  - the event enters the host event queue (SDL timestamps it),
+  *  - MSXEventDistributor delivers it to the MSX input devices (this is
+  *    delayed by EventDelay) and that results in a state change via
+  *    StateChangeDistributor,
+  *  - the MSX program reads the changed state for the first time,
+  *  - the frame that contains that read is painted by PostProcessor.
+  * Per type of input (keyboard matrix or joystick ports) there's at most
+  * one measurement in flight, input that arrives in the mean time is not
+  * measured separately.
+  *
+  * Key events are assumed to end up in the keyboard matrix, all other
+  * input events in the joystick ports. So e.g. for a keyjoystick the read
+  * of the keyboard matrix ends the measurement.
+  */
+class InputLatency
+{
+public:
+	enum class Source : uint8_t { KEYBOARD, JOYSTICK_PORT, NUM };
+
+	/** All durations are in microseconds. */
+	struct Sample {
+		uint64_t dispatch; // host event -> state change in the MSX
+		uint64_t emulate;  // state change -> first read by the MSX
+		uint64_t display;  // first read -> frame painted
+
+		[[nodiscard]] uint64_t total() const { return dispatch + emulate + display; }
+	};
+	/** Only the most recent samples are kept. */
+	static constexpr size_t MAX_SAMPLES = 256;
+	/** Measurements that don't complete within this time (in us) are
+	  * discarded, e.g. because the program doesn't read the input. */
+	static constexpr uint64_t MAX_AGE = 2'000'000;
+
+	explicit InputLatency(InfoCommand& machineInfoCommand);
+
+	/** Called by MSXEventDistributor before and after an event is
+	  * delivered to the MSX input devices. */
+	void beginEvent(const Event& event);
+	void endEvent() { current.reset(); }
+
+	/** Called by StateChangeDistributor for each live (not replayed)
+	  * state change. */
+	void stateChanged();
+
+	/** Called when the MSX reads the keyboard matrix or a joystick port.
+	  * Note: not for debugger peeks. */
+	void inputRead(Source source, EmuTime::param time) {
+		if (measurements[size_t(source)].stage == Stage::CHANGED) [[unlikely]] {
+			markRead(source, time);
+		}
+	}
+
+	/** A frame that ends at the given time is rendered and will be painted
+	  * next. */
+	void frameRendered(EmuTime::param frameEnd);
+	/** That frame is painted. */
+	void framePainted();
+
+	[[nodiscard]] const auto& getSamples() const { return samples; }
+
+private:
+	void markRead(Source source, EmuTime::param time);
+
+private:
+	enum class Stage : uint8_t { IDLE, CHANGED, READ, RENDERED };
+	struct Measurement {
+		Stage stage = Stage::IDLE;
+		uint64_t origin = 0;  // host event was created
+		uint64_t changed = 0; // state change in the MSX
+		uint64_t read = 0;    // first read by the MSX
+		EmuTime readTime = EmuTime::zero();
+	};
+	std::array<Measurement, size_t(Source::NUM)> measurements;
+
+	// Host event that's currently being delivered.
+	struct Current {
+		Source source;
+		uint64_t origin;
+	};
+	std::optional<Current> current;
+
+	circular_buffer<Sample> samples{MAX_SAMPLES};
+	unsigned discarded = 0;
+
+	struct Info final : InfoTopic {
+		explicit Info(InfoCommand& machineInfoCommand);
+		void execute(std::span<const TclObject> tokens,
+		             TclObject& result) const override;
+		[[nodiscard]] std::string help(std::span<const TclObject> tokens) const override;
+	} info;
+};
+
+} // namespace openmsx
+
+#endif
@@ -1,4 +1,5 @@
 #include "MSXEventDistributor.hh"
+#include "InputLatency.hh"
 #include "MSXEventListener.hh"
 #include "stl.hh"
 #include <cassert>
@@ -36,6 +37,7 @@ void MSXEventDistributor::distributeEvent(const Event& event, EmuTime::param tim
 	// 'listenersCopy' could be a local variable. But making it a member
 	// variable allows to reuse the allocated vector-capacity.
 	listenersCopy = listeners;
+	if (inputLatency) inputLatency->beginEvent(event);
 	for (auto& l : listenersCopy) {
 		if (isRegistered(l)) {
 			// it's possible the listener unregistered itself
@@ -43,6 +45,7 @@ void MSXEventDistributor::distributeEvent(const Event& event, EmuTime::param tim
 			l->signalMSXEvent(event, time);
 		}
 	}
+	if (inputLatency) inputLatency->endEvent();
 }
 
 } // namespace openmsx
@@ -7,6 +7,7 @@
 
 namespace openmsx {
 
+class InputLatency;
 class MSXEventListener;
 
 class MSXEventDistributor
@@ -40,12 +41,17 @@ public:
 	  */
 	void distributeEvent(const Event& event, EmuTime::param time);
 
+	/** Host input events are tagged for latency measurements, see
+	  * InputLatency. */
+	void setInputLatency(InputLatency* latency) { inputLatency = latency; }
+
 private:
 	[[nodiscard]] bool isRegistered(MSXEventListener* listener) const;
 
 private:
 	std::vector<MSXEventListener*> listeners; // unordered
 	std::vector<MSXEventListener*> listenersCopy; // see distributeEvent()
+	InputLatency* inputLatency = nullptr;
 };
 
 } // namespace openmsx
@@ -1,5 +1,6 @@
 #include "StateChangeDistributor.hh"
 
+#include "InputLatency.hh"
 #include "StateChangeListener.hh"
 #include "StateChange.hh"
 
@@ -60,6 +61,11 @@ void StateChangeDistributor::distribute(const StateChange& event) const
 	}
 }
 
+void StateChangeDistributor::signalInputLatency() const
+{
+	inputLatency->stateChanged();
+}
+
 void StateChangeDistributor::stopReplay(EmuTime::param time)
 {
 	if (!isReplaying()) return;
@@ -11,6 +11,8 @@
 
 namespace openmsx {
 
+class InputLatency;
+
 class StateChangeDistributor
 {
 public:
@@ -64,6 +66,7 @@ public:
 			T event(time, std::forward<Args>(args)...);
 			distribute(event); // might throw, ok
 		}
+		if (inputLatency) signalInputLatency();
 	}
 
 	void distributeReplay(const StateChange& event) const {
@@ -93,13 +96,19 @@ public:
 
 	[[nodiscard]] bool isReplaying() const;
 
+	/** Live state changes are reported for latency measurements, see
+	  * InputLatency. */
+	void setInputLatency(InputLatency* latency) { inputLatency = latency; }
+
 private:
 	[[nodiscard]] bool isRegistered(StateChangeListener* listener) const;
 	void distribute(const StateChange& event) const;
+	void signalInputLatency() const;
 
 private:
 	std::vector<StateChangeListener*> listeners; // unordered
 	ReverseManager* recorder = nullptr;
+	InputLatency* inputLatency = nullptr;
 	bool viewOnlyMode = false;
 	bool blockNewEventsDuringReplay = false; // used when executing callbacks during replay
 };
@@ -12,6 +12,7 @@
 #include "MSXException.hh"
 #include "Reactor.hh"
 #include "RenderSettings.hh"
+#include "StartupTrace.hh"
 #include "Thread.hh"
 #include "openmsx.hh"
 
@@ -114,8 +115,12 @@ static int main(int argc, char **argv)
 #endif
 
 	try {
+		StartupTrace::init();
 		randomize(); // seed global random generator
-		initializeSDL();
+		{
+			StartupTrace::Phase phase("SDL init");
+			initializeSDL();
+		}
 
 		Thread::setMainThread();
 		Reactor reactor;
@@ -127,11 +132,17 @@ static int main(int argc, char **argv)
 		std::span<char*> args{argv, size_t(argc)};
 #endif
 		CommandLineParser parser(reactor);
-		parser.parse(args);
+		{
+			StartupTrace::Phase phase("parse command line");
+			parser.parse(args);
+		}
 		CommandLineParser::ParseStatus parseStatus = parser.getParseStatus();
 
 		if (parseStatus != one_of(CommandLineParser::EXIT, CommandLineParser::TEST)) {
-			reactor.runStartupScripts(parser);
+			{
+				StartupTrace::Phase phase("startup scripts");
+				reactor.runStartupScripts(parser);
+			}
 
 			auto& display = reactor.getDisplay();
 			auto& render = display.getRenderSettings().getRendererSetting();
@@ -152,9 +163,13 @@ static int main(int argc, char **argv)
 			                    reactor.getGlobalCliComm());
 
 			if (parser.getParseStatus() == CommandLineParser::RUN) {
+				StartupTrace::Phase phase("power on");
 				reactor.powerOn();
 			}
-			display.repaint();
+			{
+				StartupTrace::Phase phase("initial repaint");
+				display.repaint();
+			}
 			reactor.run();
 		}
 	} catch (FatalError& e) {
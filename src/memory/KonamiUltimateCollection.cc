@@ -173,7 +173,7 @@ void KonamiUltimateCollection::writeMem(word addr, byte value, EmuTime::param ti
 				// [0x9000,0x97FF] [0xB000,0xB7FF]
 				// Masking of the mapper bits is done on write
 				bankRegs[page8kB] = value;
-				invalidateDeviceRCache(0x4000 + 0x2000 * page8kB, 0x2000);
+				refillDeviceRCache(0x4000 + 0x2000 * page8kB, 0x2000);
 			}
 		} else {
 			// Konami
@@ -185,7 +185,7 @@ void KonamiUltimateCollection::writeMem(word addr, byte value, EmuTime::param ti
 				if (!((addr < 0x5000) || ((0x5800 <= addr) && (addr < 0x6000)))) {
 					// Masking of the mapper bits is done on write
 					bankRegs[page8kB] = value;
-					invalidateDeviceRCache(0x4000 + 0x2000 * page8kB, 0x2000);
+					refillDeviceRCache(0x4000 + 0x2000 * page8kB, 0x2000);
 				}
 			}
 		}
@@ -37,6 +37,7 @@ MSXMapperIO::MSXMapperIO(const DeviceConfig& config)
 	, debuggable(getMotherBoard(), getName())
 	, mask(calcReadBackMask(getMotherBoard()))
 {
+	setFastIOHandlers<MSXMapperIO>();
 	reset(EmuTime::dummy());
 }
 
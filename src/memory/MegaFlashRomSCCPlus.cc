@@ -417,7 +417,7 @@ void MegaFlashRomSCCPlus::writeMem(word addr, byte value, EmuTime::param time)
 					// write (and only in Konami(-scc) mode)
 					byte mask = (configReg & 0x01) ? 0x3F : 0x7F;
 					bankRegs[subslot][page8kB] = value & mask;
-					invalidateDeviceRCache(0x4000 + 0x2000 * page8kB, 0x2000);
+					refillDeviceRCache(0x4000 + 0x2000 * page8kB, 0x2000);
 				}
 			}
 			break;
@@ -435,14 +435,14 @@ void MegaFlashRomSCCPlus::writeMem(word addr, byte value, EmuTime::param time)
 			if ((addr < 0x5000) || ((0x5800 <= addr) && (addr < 0x6000))) break; // only SCC range works
 			byte mask = (configReg & 0x01) ? 0x1F : 0x7F;
 			bankRegs[subslot][page8kB] = value & mask;
-			invalidateDeviceRCache(0x4000 + 0x2000 * page8kB, 0x2000);
+			refillDeviceRCache(0x4000 + 0x2000 * page8kB, 0x2000);
 			break;
 		}
 		case 0x40:
 		case 0x60:
 			// 64kB
 			bankRegs[subslot][page8kB] = value;
-			invalidateDeviceRCache(0x0000 + 0x4000 * page8kB, 0x4000);
+			refillDeviceRCache(0x0000 + 0x4000 * page8kB, 0x4000);
 			break;
 		case 0x80:
 		case 0xA0:
@@ -450,7 +450,7 @@ void MegaFlashRomSCCPlus::writeMem(word addr, byte value, EmuTime::param time)
 			if ((0x6000 <= addr) && (addr < 0x8000)) {
 				byte bank = (addr >> 11) & 0x03;
 				bankRegs[subslot][bank] = value;
-				invalidateDeviceRCache(0x4000 + 0x2000 * bank, 0x2000);
+				refillDeviceRCache(0x4000 + 0x2000 * bank, 0x2000);
 			}
 			break;
 		case 0xC0:
@@ -465,12 +465,12 @@ void MegaFlashRomSCCPlus::writeMem(word addr, byte value, EmuTime::param time)
 			if ((0x6000 <= addr) && (addr < 0x6800)) {
 				bankRegs[subslot][0] = narrow_cast<uint8_t>(2 * value + 0);
 				bankRegs[subslot][1] = narrow_cast<uint8_t>(2 * value + 1);
-				invalidateDeviceRCache(0x4000, 0x4000);
+				refillDeviceRCache(0x4000, 0x4000);
 			}
 			if ((0x7000 <= addr) && (addr < 0x7800)) {
 				bankRegs[subslot][2] = narrow_cast<uint8_t>(2 * value + 0);
 				bankRegs[subslot][3] = narrow_cast<uint8_t>(2 * value + 1);
-				invalidateDeviceRCache(0x8000, 0x4000);
+				refillDeviceRCache(0x8000, 0x4000);
 			}
 			break;
 		}
@@ -108,12 +108,12 @@ void ROMHunterMk2::writeMem(word addr, byte value, EmuTime::param /*time*/)
 			if ((0x6000 <= addr) && (addr < 0x6800)) {
 				bankRegs[0] = narrow_cast<byte>(2 * maskedValue + 0);
 				bankRegs[1] = narrow_cast<byte>(2 * maskedValue + 1);
-				invalidateDeviceRCache(0x4000, 0x4000);
+				refillDeviceRCache(0x4000, 0x4000);
 			}
 			if ((0x7000 <= addr) && (addr < 0x7800)) {
 				bankRegs[2] = narrow_cast<byte>(2 * maskedValue + 0);
 				bankRegs[3] = narrow_cast<byte>(2 * maskedValue + 1);
-				invalidateDeviceRCache(0x8000, 0x4000);
+				refillDeviceRCache(0x8000, 0x4000);
 			}
 			break;
 		}
@@ -122,7 +122,7 @@ void ROMHunterMk2::writeMem(word addr, byte value, EmuTime::param /*time*/)
 			if ((0x6000 <= addr) && (addr < 0x8000)) {
 				byte bank = (addr >> 11) & 0x03;
 				bankRegs[bank] = value & 0x1F;
-				invalidateDeviceRCache(0x4000 + 0x2000 * bank, 0x2000);
+				refillDeviceRCache(0x4000 + 0x2000 * bank, 0x2000);
 			}
 			break;
 		case 0b101:
@@ -130,7 +130,7 @@ void ROMHunterMk2::writeMem(word addr, byte value, EmuTime::param /*time*/)
 			if ((0x6000 <= addr) && (addr < 0xC000)) {
 				unsigned bank = (addr >> 13) - 2;
 				bankRegs[bank] = value & 0x1F;
-				invalidateDeviceRCache(0x4000 + 0x2000 * bank, 0x2000);
+				refillDeviceRCache(0x4000 + 0x2000 * bank, 0x2000);
 			}
 			break;
 		case 0b100:
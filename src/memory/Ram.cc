@@ -9,11 +9,15 @@
 #include "narrow.hh"
 #include "one_of.hh"
 #include "serialize.hh"
+#include "serialize_stl.hh"
+#include "xrange.hh"
 
 #include <zlib.h>
 
 #include <algorithm>
+#include <array>
 #include <bit>
+#include <vector>
 
 namespace openmsx {
 
@@ -36,6 +40,10 @@ Ram::Ram(const XMLElement& xml_, size_t size)
 
 void Ram::clear(byte c)
 {
+	fillValue = c;
+	static constexpr auto SEGMENT_SIZE = SparseRamBuffer::SEGMENT_SIZE;
+	std::array<byte, SEGMENT_SIZE> pattern;
+
 	if (const auto* init = xml.findChild("initialContent")) {
 		// get pattern (and decode)
 		auto encoding = init->getAttributeValue("encoding");
@@ -56,6 +64,14 @@ void Ram::clear(byte c)
 			if (buf.empty()) {
 				throw MSXException("Zero-length initial pattern");
 			}
+			if ((SEGMENT_SIZE % buf.size()) == 0) {
+				// pattern repeats within one segment, use sparse fill
+				for (size_t i = 0; i < SEGMENT_SIZE; i += buf.size()) {
+					ranges::copy(buf, subspan(pattern, i));
+				}
+				ram.fill(pattern);
+				return;
+			}
 			done = std::min(size(), buf.size());
 			ranges::copy(buf.first(done), ram.data());
 		} else {
@@ -71,9 +87,11 @@ void Ram::clear(byte c)
 			done += tmp;
 			left -= tmp;
 		}
+		ram.forgetPattern();
 	} else {
 		// no init pattern specified
-		ranges::fill(*this, c);
+		ranges::fill(pattern, c);
+		ram.fill(pattern);
 	}
 }
 
@@ -102,11 +120,47 @@ void RamDebuggable::write(unsigned address, byte value)
 }
 
 
+// version 1: initial version, full content in one blob
+// version 2: only store the 16kB segments that differ from the fill pattern
 template<typename Archive>
-void Ram::serialize(Archive& ar, unsigned /*version*/)
+void Ram::serialize(Archive& ar, unsigned version)
 {
-	// ar.serialize_blob("ram", std::span{*this}); // TODO error with clang-15/libc++
-	ar.serialize_blob("ram", std::span{begin(), end()});
+	if (!ar.versionAtLeast(version, 2)) {
+		// ar.serialize_blob("ram", std::span{*this}); // TODO error with clang-15/libc++
+		ar.serialize_blob("ram", std::span{begin(), end()});
+		return;
+	}
+
+	std::vector<unsigned> segments; // the segments that are stored
+	if constexpr (Archive::IS_LOADER) {
+		byte fill = 0xff;
+		ar.serialize("fill", fill,
+		             "segments", segments);
+		if (fill != fillValue) clear(fill);
+		if (ram.hasFillPattern()) {
+			// reset segments that are not in the savestate
+			size_t next = 0;
+			for (auto i : xrange(ram.numSegments())) {
+				if ((next < segments.size()) && (segments[next] == i)) {
+					++next;
+				} else if (!ram.isPristine(i)) {
+					ram.resetSegment(i);
+				}
+			}
+		}
+	} else {
+		for (auto i : xrange(ram.numSegments())) {
+			if (!ram.isPristine(i)) segments.push_back(narrow<unsigned>(i));
+		}
+		ar.serialize("fill", fillValue,
+		             "segments", segments);
+	}
+	for (auto i : segments) {
+		if (i >= ram.numSegments()) {
+			throw MSXException("Invalid RAM segment in savestate: ", i);
+		}
+		ar.serialize_blob("segment", ram.getSegment(i));
+	}
 }
 INSTANTIATE_SERIALIZE_METHODS(Ram);
 
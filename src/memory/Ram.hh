@@ -2,8 +2,9 @@
 #define RAM_HH
 
 #include "SimpleDebuggable.hh"
-#include "MemBuffer.hh"
+#include "SparseRamBuffer.hh"
 #include "openmsx.hh"
+#include "serialize_meta.hh"
 #include "static_string_view.hh"
 #include <optional>
 #include <string>
@@ -50,6 +51,11 @@ public:
 	[[nodiscard]] auto end()   const { return ram.end(); }
 
 	[[nodiscard]] const std::string& getName() const;
+
+	/** Fill the whole RAM with the given value, or with the pattern from
+	  * the 'initialContent' config tag (if present). Memory that was
+	  * allocated for written 16kB segments is released again.
+	  */
 	void clear(byte c = 0xff);
 
 	template<typename Archive>
@@ -57,9 +63,11 @@ public:
 
 private:
 	const XMLElement& xml;
-	MemBuffer<byte> ram;
+	SparseRamBuffer ram;
 	const std::optional<RamDebuggable> debuggable; // can be nullopt
+	byte fillValue = 0xff; // parameter of the last clear() call
 };
+SERIALIZE_CLASS_VERSION(Ram, 2);
 
 } // namespace openmsx
 
@@ -170,7 +170,7 @@ void ReproCartridgeV1::writeMem(word addr, byte value, EmuTime::param time)
 			// [0x5000,0x57FF] [0x7000,0x77FF]
 			// [0x9000,0x97FF] [0xB000,0xB7FF]
 			bankRegs[page8kB] = value;
-			invalidateDeviceRCache(0x4000 + 0x2000 * page8kB, 0x2000);
+			refillDeviceRCache(0x4000 + 0x2000 * page8kB, 0x2000);
 		}
 
 		// SCC mode register
@@ -209,7 +209,7 @@ void ReproCartridgeV2::writeMem(word addr, byte value, EmuTime::param time)
 				// [0x5000,0x57FF] [0x7000,0x77FF]
 				// [0x9000,0x97FF] [0xB000,0xB7FF]
 				bankRegs[page8kB] = value;
-				invalidateDeviceRCache(0x4000 + 0x2000 * page8kB, 0x2000);
+				refillDeviceRCache(0x4000 + 0x2000 * page8kB, 0x2000);
 			}
 
 			// SCC mode register
@@ -229,7 +229,7 @@ void ReproCartridgeV2::writeMem(word addr, byte value, EmuTime::param time)
 			// write (and only in Konami(-scc) mode)
 			if ((addr < 0x5000) || ((0x5800 <= addr) && (addr < 0x6000))) break; // only SCC range works
 			bankRegs[page8kB] = value & 0x7F;
-			invalidateDeviceRCache(0x4000 + 0x2000 * page8kB, 0x2000);
+			refillDeviceRCache(0x4000 + 0x2000 * page8kB, 0x2000);
 			break;
 		}
 		case 2:
@@ -238,7 +238,7 @@ void ReproCartridgeV2::writeMem(word addr, byte value, EmuTime::param time)
 			if ((0x6000 <= addr) && (addr < 0x8000)) {
 				byte bank = (addr >> 11) & 0x03;
 				bankRegs[bank] = value;
-				invalidateDeviceRCache(0x4000 + 0x2000 * bank, 0x2000);
+				refillDeviceRCache(0x4000 + 0x2000 * bank, 0x2000);
 			}
 			break;
 		case 3:
@@ -253,12 +253,12 @@ void ReproCartridgeV2::writeMem(word addr, byte value, EmuTime::param time)
 			if ((0x6000 <= addr) && (addr < 0x6800)) {
 				bankRegs[0] = narrow_cast<byte>(2 * value + 0);
 				bankRegs[1] = narrow_cast<byte>(2 * value + 1);
-				invalidateDeviceRCache(0x4000, 0x4000);
+				refillDeviceRCache(0x4000, 0x4000);
 			}
 			if ((0x7000 <= addr) && (addr < 0x7800)) {
 				bankRegs[2] = narrow_cast<byte>(2 * value + 0);
 				bankRegs[3] = narrow_cast<byte>(2 * value + 1);
-				invalidateDeviceRCache(0x8000, 0x4000);
+				refillDeviceRCache(0x8000, 0x4000);
 			}
 			break;
 		default:
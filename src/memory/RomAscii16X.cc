@@ -63,8 +63,8 @@ void RomAscii16X::writeMem(word addr, byte value, EmuTime::param /* time */)
 	if ((addr & 0x3FFF) >= 0x2000) {
 		const word index = (addr >> 12) & 1;
 		bankRegs[index] = (addr & 0x0F00) | value;
-		invalidateDeviceRCache(0x4000 ^ (index << 14), 0x4000);
-		invalidateDeviceRCache(0xC000 ^ (index << 14), 0x4000);
+		refillDeviceRCache(0x4000 ^ (index << 14), 0x4000);
+		refillDeviceRCache(0xC000 ^ (index << 14), 0x4000);
 	}
 }
 
@@ -3,7 +3,9 @@
 #include "CliComm.hh"
 #include "File.hh"
 #include "FileContext.hh"
+#include "FileOperations.hh"
 #include "MSXException.hh"
+#include "Version.hh"
 
 #include "String32.hh"
 #include "StringOp.hh"
@@ -18,7 +20,10 @@
 
 #include <array>
 #include <cassert>
+#include <cstdio>
+#include <cstring>
 #include <string_view>
+#include <type_traits>
 
 using std::string_view;
 
@@ -567,16 +572,184 @@ static void parseDB(CliComm& cliComm, char* buf, char* bufStart,
 	}
 }
 
+// Parsing softwaredb.xml takes a relatively long time, and it's done on each
+// startup. So after parsing, the result is stored in a binary cache file,
+// which can be loaded almost without any processing. The layout is:
+//   CacheHeader
+//   key:     'keySize' bytes, identifies the source files, see getCacheKey()
+//            (padded to a multiple of 8 bytes)
+//   entries: 'numEntries' x RomDatabase::Entry, sorted on sha1
+//   strings: 'poolSize' bytes, the String32 members of RomInfo index in here
+// The cache is only used when its key matches, so it gets regenerated
+// automatically when any of the softwaredb.xml files (or openMSX itself)
+// changes. The header also contains the total size and a checksum of
+// everything after the header, so truncated or otherwise damaged files are
+// rejected as well.
+//
+// The String32 members only contain offsets (not pointers) on 64-bit hosts.
+// On 32-bit hosts we don't use the cache.
+static constexpr bool USE_DB_CACHE = std::is_same_v<String32, uint32_t>;
+
+struct CacheHeader {
+	std::array<char, 16> magic;
+	uint32_t formatVersion;
+	uint32_t entrySize;
+	uint32_t keySize;
+	uint32_t numEntries;
+	uint32_t poolSize;
+	uint32_t checksum; // xxhash of everything after the header
+	uint64_t fileSize;
+};
+static constexpr std::array<char, 16> CACHE_MAGIC = {
+	'o', 'p', 'e', 'n', 'M', 'S', 'X', ' ', 's', 'w', 'd', 'b', 'c', 'a', 'c', 'h'};
+static constexpr uint32_t CACHE_FORMAT_VERSION = 2;
+static_assert(std::is_trivially_copyable_v<RomDatabase::Entry>);
+static_assert((sizeof(CacheHeader) % 8) == 0);
+static_assert(alignof(RomDatabase::Entry) <= 8);
+
+[[nodiscard]] static size_t padTo8(size_t size)
+{
+	return (size + 7) & ~size_t(7);
+}
+
+[[nodiscard]] static std::string getCacheKey(std::span<const std::string> filenames)
+{
+	std::string key = strCat(Version::full(), '\n');
+	for (const auto& filename : filenames) {
+		if (auto st = FileOperations::getStat(filename)) {
+			strAppend(key, filename, ' ', uint64_t(st->st_size), ' ',
+			          uint64_t(FileOperations::getModificationDate(*st)), '\n');
+		} else {
+			strAppend(key, filename, " -\n");
+		}
+	}
+	return key;
+}
+
+bool RomDatabase::loadCache(const std::string& filename, std::string_view key)
+{
+	try {
+		File file(filename);
+		auto mem = file.mmap();
+
+		CacheHeader header;
+		if (mem.size() < sizeof(header)) return false;
+		memcpy(&header, mem.data(), sizeof(header));
+		if ((header.magic != CACHE_MAGIC) ||
+		    (header.formatVersion != CACHE_FORMAT_VERSION) ||
+		    (header.entrySize != sizeof(Entry)) ||
+		    (header.keySize != key.size()) ||
+		    (header.fileSize != mem.size())) {
+			return false;
+		}
+		size_t keyOffset = sizeof(header);
+		size_t entriesOffset = keyOffset + padTo8(header.keySize);
+		size_t poolOffset = entriesOffset + size_t(header.numEntries) * sizeof(Entry);
+		auto payload = std::string_view(std::bit_cast<const char*>(&mem[keyOffset]),
+		                                mem.size() - keyOffset);
+		if ((mem.size() != poolOffset + header.poolSize) ||
+		    (header.poolSize == 0) ||
+		    (payload.substr(0, key.size()) != key) ||
+		    (xxhash(payload) != header.checksum)) {
+			return false;
+		}
+
+		// mmap'ed memory is page aligned, and entriesOffset is a multiple of 8
+		const auto* entries = std::bit_cast<const Entry*>(&mem[entriesOffset]);
+		db.assign(entries, entries + header.numEntries);
+		buffer.resize(header.poolSize);
+		memcpy(buffer.data(), &mem[poolOffset], header.poolSize);
+		return true;
+	} catch (MSXException&) {
+		// ignore, e.g. cache file doesn't exist yet
+		db.clear();
+		return false;
+	}
+}
+
+void RomDatabase::saveCache(const std::string& filename, std::string_view key) const
+{
+	// Only store the strings that are actually referenced (the source
+	// buffer also contains all the xml markup).
+	std::string pool(1, '\0'); // offset 0 is the empty string
+	hash_map<uint32_t, uint32_t> remap;
+	remap[0u] = 0;
+	auto convert = [&](uint32_t oldOffset) {
+		auto [it, inserted] = remap.try_emplace(oldOffset, 0u);
+		if (inserted) {
+			it->second = narrow<uint32_t>(pool.size());
+			pool += std::string_view(fromString32(buffer.data(), oldOffset));
+			pool += '\0';
+		}
+		return it->second;
+	};
+	auto entries = to_vector(view::transform(db, [&](const Entry& e) {
+		const auto& r = e.romInfo;
+		const char* buf = buffer.data();
+		auto offset = [&](std::string_view str) {
+			return convert(narrow<uint32_t>(str.data() - buf));
+		};
+		return Entry{e.sha1, RomInfo(
+			offset(r.getTitle(buf)), offset(r.getYear(buf)),
+			offset(r.getCompany(buf)), offset(r.getCountry(buf)),
+			r.getOriginal(), offset(r.getOrigType(buf)),
+			offset(r.getRemark(buf)), r.getRomType(), r.getGenMSXid())};
+	}));
+
+	std::string payload(key);
+	payload.resize(padTo8(key.size()), '\0');
+	payload.append(std::bit_cast<const char*>(entries.data()), entries.size() * sizeof(Entry));
+	payload += pool;
+
+	CacheHeader header = {};
+	header.magic = CACHE_MAGIC;
+	header.formatVersion = CACHE_FORMAT_VERSION;
+	header.entrySize = sizeof(Entry);
+	header.keySize = narrow<uint32_t>(key.size());
+	header.numEntries = narrow<uint32_t>(entries.size());
+	header.poolSize = narrow<uint32_t>(pool.size());
+	header.checksum = xxhash(payload);
+	header.fileSize = sizeof(header) + payload.size();
+
+	// Write to a temporary file (with a unique name, so concurrently
+	// starting openMSX processes don't interfere) first, then rename. So
+	// other processes never see a partially written cache.
+	std::string tmpName;
+	try {
+		auto file = FileOperations::openUniqueFile(
+			std::string(FileOperations::getDirName(filename)), tmpName);
+		if (!file) return;
+		bool ok = (fwrite(&header, sizeof(header), 1, file.get()) == 1) &&
+		          (fwrite(payload.data(), payload.size(), 1, file.get()) == 1) &&
+		          (fflush(file.get()) == 0);
+		file.reset(); // close
+		if (!ok || (std::rename(tmpName.c_str(), filename.c_str()) != 0)) {
+			FileOperations::unlink(tmpName);
+		}
+	} catch (MSXException&) {
+		// ignore, the cache is only an optimization
+		if (!tmpName.empty()) FileOperations::unlink(tmpName);
+	}
+}
+
 RomDatabase::RomDatabase(CliComm& cliComm)
 {
+	auto filenames = to_vector(view::transform(systemFileContext().getPaths(),
+		[](const auto& p) { return p + "/softwaredb.xml"; }));
+	auto cacheFile = FileOperations::join(FileOperations::getUserDataDir(), ".softwaredb.cache");
+	auto cacheKey = getCacheKey(filenames);
+	if constexpr (USE_DB_CACHE) {
+		if (loadCache(cacheFile, cacheKey)) return;
+	}
+
 	db.reserve(3500);
 	UnknownTypes unknownTypes;
 	// first user- then system-directory
 	std::vector<File> files;
 	size_t bufferSize = 0;
-	for (const auto& p : systemFileContext().getPaths()) {
+	for (const auto& filename : filenames) {
 		try {
-			auto& f = files.emplace_back(p + "/softwaredb.xml");
+			auto& f = files.emplace_back(filename);
 			bufferSize += f.getSize() + rapidsax::EXTRA_BUFFER_SPACE;
 		} catch (MSXException& /*e*/) {
 			// Ignore. It's not unusual the DB in the user
@@ -616,6 +789,9 @@ RomDatabase::RomDatabase(CliComm& cliComm)
 		}
 		cliComm.printWarning(output);
 	}
+	if constexpr (USE_DB_CACHE) {
+		if (!db.empty()) saveCache(cacheFile, cacheKey);
+	}
 }
 
 const RomInfo* RomDatabase::fetchRomInfo(const Sha1Sum& sha1sum) const
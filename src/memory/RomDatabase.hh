@@ -6,6 +6,8 @@
 #include "MemBuffer.hh"
 #include "sha1.hh"
 
+#include <string>
+#include <string_view>
 #include <vector>
 
 namespace openmsx {
@@ -30,6 +32,10 @@ public:
 
 	[[nodiscard]] const char* getBufferStart() const { return buffer.data(); }
 
+private:
+	[[nodiscard]] bool loadCache(const std::string& filename, std::string_view key);
+	void saveCache(const std::string& filename, std::string_view key) const;
+
 private:
 	RomDB db;
 	MemBuffer<char> buffer;
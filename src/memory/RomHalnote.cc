@@ -91,7 +91,7 @@ void RomHalnote::writeMem(word address, byte value, EmuTime::param /*time*/)
 			if (subBanks[subBank] != value) {
 				subBanks[subBank] = value;
 				if (subMapperEnabled) {
-					invalidateDeviceRCache(
+					refillDeviceRCache(
 						0x7000 + subBank * 0x800, 0x800);
 				}
 			}
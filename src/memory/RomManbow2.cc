@@ -122,7 +122,7 @@ void RomManbow2::setRom(unsigned region, byte block)
 	assert(region < 4);
 	auto nrBlocks = narrow<unsigned>(flash.size() / 0x2000);
 	bank[region] = block & narrow<byte>(nrBlocks - 1);
-	invalidateDeviceRCache(0x4000 + region * 0x2000, 0x2000);
+	refillDeviceRCache(0x4000 + region * 0x2000, 0x2000);
 }
 
 byte RomManbow2::peekMem(word address, EmuTime::param time) const
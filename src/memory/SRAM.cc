@@ -1,17 +1,22 @@
 #include "SRAM.hh"
 
+#include "AsyncFileWriter.hh"
 #include "DeviceConfig.hh"
 #include "File.hh"
 #include "FileContext.hh"
 #include "FileException.hh"
 #include "FileNotFoundException.hh"
 #include "MSXCliComm.hh"
+#include "MSXMotherBoard.hh"
 #include "Reactor.hh"
 #include "openmsx.hh"
 
+#include "ranges.hh"
 #include "serialize.hh"
 #include "small_buffer.hh"
 
+#include <vector>
+
 namespace openmsx {
 
 // class SRAM
@@ -83,11 +88,20 @@ void SRAM::load(bool* loaded)
 {
 	assert(config.getXML());
 	if (loaded) *loaded = false;
+	if (config.getMotherBoard().isShadow()) {
+		// The run-ahead shadow machine gets its content from the real
+		// machine, and must never overwrite the file.
+		schedulable.reset();
+		return;
+	}
 	const auto& filename = config.getChildData("sramname");
 	try {
+		auto resolved = config.getFileContext().resolveCreate(filename);
+		// a previous SRAM object (e.g. of the same machine before a
+		// reset) may still be saving this file
+		config.getReactor().getAsyncFileWriter().flush(resolved);
 		bool headerOk = true;
-		File file(config.getFileContext().resolveCreate(filename),
-			  File::OpenMode::LOAD_PERSISTENT);
+		File file(std::move(resolved), File::OpenMode::LOAD_PERSISTENT);
 		if (header) {
 			size_t length = strlen(header);
 			small_buffer<char, 64> buf(uninitialized_tag{}, length);
@@ -112,17 +126,19 @@ void SRAM::load(bool* loaded)
 
 void SRAM::save() const
 {
+	// Take a snapshot of the content, the actual writing happens in a
+	// background thread (for large flash memories this takes a while).
 	assert(config.getXML());
 	const auto& filename = config.getChildData("sramname");
 	try {
-		File file(config.getFileContext().resolveCreate(filename),
-			  File::OpenMode::SAVE_PERSISTENT);
-		if (header) {
-			auto length = strlen(header);
-			file.write(std::span{header, length});
-		}
-		//file.write(std::span{ram}); // TODO error with clang-15/libc++
-		file.write(std::span{ram.begin(), ram.end()});
+		auto resolved = config.getFileContext().resolveCreate(filename);
+		std::vector<uint8_t> data;
+		auto headerLen = header ? strlen(header) : 0;
+		data.reserve(headerLen + ram.size());
+		data.insert(data.end(), header, header + headerLen);
+		data.insert(data.end(), ram.begin(), ram.end());
+		config.getReactor().getAsyncFileWriter().write(
+			std::move(resolved), std::move(data), "SRAM");
 	} catch (FileException& e) {
 		config.getCliComm().printWarning(
 			"Couldn't save SRAM ", filename,
@@ -0,0 +1,164 @@
+#include "SparseRamBuffer.hh"
+
+#include "ranges.hh"
+#include "xrange.hh"
+
+#include <cstring>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <unistd.h>
+#include <mutex>
+#include <vector>
+#define SPARSE_RAM_MMAP 1
+#else
+#define SPARSE_RAM_MMAP 0
+#endif
+
+namespace openmsx {
+
+#if SPARSE_RAM_MMAP
+// A single file (memfd) holds the fill patterns of all SparseRamBuffers,
+// each distinct pattern only once, in its own SEGMENT_SIZE block. Blocks are
+// never changed or removed (changing them would be visible in existing
+// mappings). In practice there are only a few distinct patterns (e.g. all
+// 0xFF or the 'initialContent' of a RAM), still the number is limited.
+class PatternFile
+{
+public:
+	static constexpr size_t SEGMENT_SIZE = SparseRamBuffer::SEGMENT_SIZE;
+	static constexpr size_t MAX_PATTERNS = 64;
+
+	static PatternFile& instance() {
+		static PatternFile oneInstance;
+		return oneInstance;
+	}
+
+	[[nodiscard]] int getFd() const { return fd; }
+
+	/** Returns the offset of the given pattern in the file, it's added
+	  * when needed. Returns -1 on error. */
+	[[nodiscard]] int64_t getOffset(std::span<const uint8_t, SEGMENT_SIZE> pattern) {
+		std::scoped_lock lock(mutex);
+		if (fd == -1) return -1;
+		for (auto i : xrange(patterns.size())) {
+			if (ranges::equal(patterns[i], pattern)) return int64_t(i * SEGMENT_SIZE);
+		}
+		if (patterns.size() == MAX_PATTERNS) return -1;
+		auto offset = patterns.size() * SEGMENT_SIZE;
+		if ((ftruncate(fd, off_t(offset + SEGMENT_SIZE)) != 0) ||
+		    (pwrite(fd, pattern.data(), SEGMENT_SIZE, off_t(offset)) != ssize_t(SEGMENT_SIZE))) {
+			return -1;
+		}
+		patterns.emplace_back(pattern.begin(), pattern.end());
+		return int64_t(offset);
+	}
+
+private:
+	PatternFile() : fd(memfd_create("openmsx-ram", MFD_CLOEXEC)) {}
+	~PatternFile() { if (fd != -1) close(fd); }
+
+private:
+	std::mutex mutex;
+	std::vector<std::vector<uint8_t>> patterns; // content of the file
+	int fd;
+};
+#endif
+
+SparseRamBuffer::SparseRamBuffer(size_t size)
+	: dat(nullptr)
+	, sz(size)
+	, patternCopy(SEGMENT_SIZE)
+{
+#if SPARSE_RAM_MMAP
+	// Only worth it for buffers that span several segments. Segments must
+	// also be a multiple of the (host) page size.
+	auto pageSize = sysconf(_SC_PAGESIZE);
+	if ((sz >= 4 * SEGMENT_SIZE) && ((sz % SEGMENT_SIZE) == 0) &&
+	    (pageSize > 0) && ((SEGMENT_SIZE % size_t(pageSize)) == 0)) {
+		// Reserve the address range. Until the first call to fill()
+		// this is simply lazily allocated zero-initialized memory.
+		void* p = mmap(nullptr, sz, PROT_READ | PROT_WRITE,
+		               MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (p != MAP_FAILED) {
+			dat = static_cast<uint8_t*>(p);
+			mapped = true;
+		}
+	}
+#endif
+	if (!mapped) {
+		fallback.resize(sz);
+		dat = fallback.data();
+	}
+}
+
+SparseRamBuffer::~SparseRamBuffer()
+{
+#if SPARSE_RAM_MMAP
+	if (mapped) munmap(dat, sz);
+#endif
+}
+
+bool SparseRamBuffer::mapSegments([[maybe_unused]] size_t first, [[maybe_unused]] size_t num)
+{
+#if SPARSE_RAM_MMAP
+	if (!mapped || (patternOffset == -1)) return false;
+	int fd = PatternFile::instance().getFd();
+	for (auto i : xrange(first, first + num)) {
+		// MAP_FIXED replaces the existing mapping, this also drops
+		// the private (written) copy of this segment, if any. On
+		// failure the old mapping remains (the address range stays
+		// reserved).
+		void* p = mmap(dat + i * SEGMENT_SIZE, SEGMENT_SIZE,
+		               PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED,
+		               fd, off_t(patternOffset));
+		if (p == MAP_FAILED) return false;
+	}
+	return true;
+#else
+	return false;
+#endif
+}
+
+void SparseRamBuffer::copyPattern(size_t segment)
+{
+	auto seg = getSegment(segment);
+	ranges::copy(std::span{patternCopy.data(), seg.size()}, seg.data());
+}
+
+void SparseRamBuffer::fill(std::span<const uint8_t, SEGMENT_SIZE> pattern)
+{
+	ranges::copy(pattern, patternCopy.data());
+	hasPattern = true;
+
+#if SPARSE_RAM_MMAP
+	if (mapped) {
+		patternOffset = PatternFile::instance().getOffset(pattern);
+		if (mapSegments(0, numSegments())) return;
+		// Something went wrong, continue with regular copies. The
+		// buffer itself stays in place.
+		patternOffset = -1;
+	}
+#endif
+	for (auto i : xrange(numSegments())) {
+		copyPattern(i);
+	}
+}
+
+bool SparseRamBuffer::isPristine(size_t segment) const
+{
+	if (!hasPattern) return false;
+	assert(segment < numSegments());
+	auto offset = segment * SEGMENT_SIZE;
+	auto len = std::min(SEGMENT_SIZE, sz - offset);
+	return memcmp(dat + offset, patternCopy.data(), len) == 0;
+}
+
+void SparseRamBuffer::resetSegment(size_t segment)
+{
+	assert(hasPattern);
+	if (mapSegments(segment, 1)) return;
+	copyPattern(segment);
+}
+
+} // namespace openmsx
@@ -0,0 +1,114 @@
+#ifndef SPARSERAMBUFFER_HH
+#define SPARSERAMBUFFER_HH
+
+#include "MemBuffer.hh"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace openmsx {
+
+/** Backing store for (large) emulated RAM.
+  *
+  * The buffer is logically split in 16kB segments. Initially all segments
+  * contain the same 'fill pattern' (e.g. all 0xFF), and most MSX software
+  * only ever touches a small fraction of e.g. a 4MB memory mapper. So
+  * instead of allocating (and filling) the full buffer up front, all
+  * untouched segments share one read-only copy of the fill pattern. Memory
+  * for a segment is only allocated on the first write to that segment.
+  *
+  * On Linux this is implemented with copy-on-write mappings of the fill
+  * pattern (so also writes via the CPU cache lines, which bypass any
+  * software checks, trigger the allocation). All buffers share a single
+  * file that holds each distinct fill pattern once. On other platforms this
+  * falls back to a regular, fully allocated buffer. When mapping the
+  * pattern fails, the segments are filled with copies of the pattern
+  * instead (so memory gets allocated). In all cases the 'isPristine()'
+  * check still works, so e.g. savestates can still skip never-written
+  * segments.
+  *
+  * From the outside this behaves like a regular contiguous buffer: data()
+  * points to 'size()' consecutive readable and writable bytes. That
+  * pointer never changes during the lifetime of the buffer (it may be
+  * stored e.g. in the CPU cache lines).
+  */
+class SparseRamBuffer
+{
+public:
+	static constexpr size_t SEGMENT_SIZE = 0x4000;
+
+	explicit SparseRamBuffer(size_t size);
+	SparseRamBuffer(const SparseRamBuffer&) = delete;
+	SparseRamBuffer(SparseRamBuffer&&) = delete;
+	SparseRamBuffer& operator=(const SparseRamBuffer&) = delete;
+	SparseRamBuffer& operator=(SparseRamBuffer&&) = delete;
+	~SparseRamBuffer();
+
+	[[nodiscard]] const uint8_t& operator[](size_t i) const {
+		assert(i < sz);
+		return dat[i];
+	}
+	[[nodiscard]] uint8_t& operator[](size_t i) {
+		assert(i < sz);
+		return dat[i];
+	}
+	[[nodiscard]] size_t size() const { return sz; }
+	[[nodiscard]]       uint8_t* data()       { return dat; }
+	[[nodiscard]] const uint8_t* data() const { return dat; }
+	[[nodiscard]]       uint8_t* begin()       { return dat; }
+	[[nodiscard]] const uint8_t* begin() const { return dat; }
+	[[nodiscard]]       uint8_t* end()         { return dat + sz; }
+	[[nodiscard]] const uint8_t* end()   const { return dat + sz; }
+
+	[[nodiscard]] size_t numSegments() const {
+		return (sz + SEGMENT_SIZE - 1) / SEGMENT_SIZE;
+	}
+	[[nodiscard]] std::span<uint8_t> getSegment(size_t segment) {
+		assert(segment < numSegments());
+		auto offset = segment * SEGMENT_SIZE;
+		return {dat + offset, std::min(SEGMENT_SIZE, sz - offset)};
+	}
+
+	/** Fill the whole buffer with the given pattern, the pattern must be
+	  * exactly one segment big (it's repeated for each segment). This
+	  * releases all memory that was allocated for written segments.
+	  */
+	void fill(std::span<const uint8_t, SEGMENT_SIZE> pattern);
+
+	/** Forget the fill pattern: the content of the buffer is no longer
+	  * (assumed to be) a repetition of a pattern. E.g. used after the
+	  * buffer got (fully) initialized by other means. From now on
+	  * isPristine() always returns false (until the next fill()).
+	  */
+	void forgetPattern() { hasPattern = false; }
+	[[nodiscard]] bool hasFillPattern() const { return hasPattern; }
+
+	/** Does the given segment (still) contain the fill pattern? */
+	[[nodiscard]] bool isPristine(size_t segment) const;
+
+	/** Restore the given segment to the fill pattern (and release the
+	  * memory that was allocated for it).
+	  * Only allowed when there is a fill pattern.
+	  */
+	void resetSegment(size_t segment);
+
+private:
+	[[nodiscard]] bool mapSegments(size_t first, size_t num);
+	void copyPattern(size_t segment);
+
+private:
+	uint8_t* dat;
+	size_t sz;
+	MemBuffer<uint8_t> fallback;      // used when we can't (or don't) use mappings
+	MemBuffer<uint8_t> patternCopy;   // SEGMENT_SIZE bytes
+	int64_t patternOffset = -1; // of 'patternCopy' in the shared pattern file, -1 if not in there
+	bool mapped = false; // reserved address range, segments can be mapped
+	bool hasPattern = false;
+};
+
+} // namespace openmsx
+
+#endif
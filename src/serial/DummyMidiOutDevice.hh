@@ -11,6 +11,7 @@ public:
 	// SerialDataInterface (part)
 	void recvByte(byte value, EmuTime::param time) override;
 	[[nodiscard]] std::string_view getDescription() const override;
+	[[nodiscard]] bool isHostOutput() const override { return false; }
 	void plugHelper(Connector& connector, EmuTime::param time) override;
 	void unplugHelper(EmuTime::param time) override;
 };
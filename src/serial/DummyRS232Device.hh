@@ -10,6 +10,7 @@ class DummyRS232Device final : public RS232Device
 public:
 	void signal(EmuTime::param time) override;
 	[[nodiscard]] std::string_view getDescription() const override;
+	[[nodiscard]] bool isHostOutput() const override { return false; }
 	void plugHelper(Connector& connector, EmuTime::param time) override;
 	void unplugHelper(EmuTime::param time) override;
 
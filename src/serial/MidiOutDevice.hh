@@ -22,6 +22,7 @@ public:
 
 	// Pluggable (part)
 	[[nodiscard]] std::string_view getClass() const final;
+	[[nodiscard]] bool isHostOutput() const override { return true; }
 
 	// SerialDataInterface (part)
 	void recvByte(byte value, EmuTime::param time) override;
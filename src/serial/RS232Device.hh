@@ -11,6 +11,7 @@ class RS232Device : public Pluggable, public SerialDataInterface
 public:
 	// Pluggable (part)
 	[[nodiscard]] std::string_view getClass() const final;
+	[[nodiscard]] bool isHostOutput() const override { return true; }
 
 	// input
 	virtual void signal(EmuTime::param time) = 0;
@@ -2,10 +2,12 @@
 #define SERIALIZE_STL_HH
 
 #include "serialize_core.hh"
+#include "PolymorphicLog.hh"
 #include "circular_buffer.hh"
 #include "static_vector.hh"
 #include <deque>
 #include <iterator>
+#include <memory>
 #include <vector>
 
 namespace openmsx {
@@ -67,6 +69,33 @@ template<typename T> struct serialize_as_collection<cb_queue<T>>
 template<typename T, size_t N> struct serialize_as_collection<static_vector<T, N>>
 	: serialize_as_stl_collection<static_vector<T, N>> {};
 
+// Saved (and loaded) the same way as a collection of (unique_)pointers.
+template<typename T> struct serialize_as_collection<PolymorphicLog<T>> : std::true_type
+{
+	static constexpr int size = -1; // variable size
+	using value_type = std::unique_ptr<T>;
+	// save
+	static auto begin(const PolymorphicLog<T>& l) { return l.begin(); }
+	static auto end  (const PolymorphicLog<T>& l) { return l.end();   }
+	// load
+	static constexpr bool loadInPlace = false;
+	static void prepare(PolymorphicLog<T>& l, int /*n*/) {
+		l.clear();
+	}
+	struct Output {
+		PolymorphicLog<T>* log;
+		Output& operator*() { return *this; }
+		Output& operator++() { return *this; }
+		Output& operator=(std::unique_ptr<T> t) {
+			log->adopt(std::move(t));
+			return *this;
+		}
+	};
+	static auto output(PolymorphicLog<T>& l) {
+		return Output{&l};
+	}
+};
+
 } // namespace openmsx
 
 #endif
@@ -1,4 +1,5 @@
 #include "MSXPSG.hh"
+#include "InputLatency.hh"
 #include "LedStatus.hh"
 #include "CassettePort.hh"
 #include "MSXMotherBoard.hh"
@@ -38,6 +39,7 @@ MSXPSG::MSXPSG(const DeviceConfig& config)
 	, addressMask(config.getChildDataAsBool("mirrored_registers", true) ? 0x0f : 0xff)
 	, ay8910(getName(), *this, config, getCurrentTime())
 {
+	setFastIOHandlers<MSXPSG>();
 	reset(getCurrentTime());
 }
 
@@ -61,6 +63,10 @@ byte MSXPSG::readIO(word port, EmuTime::param time)
 {
 	switch (port & 0x03) {
 	case 2:
+		if (registerLatch == 14) { // I/O port A: joystick ports
+			getMotherBoard().getInputLatency().inputRead(
+				InputLatency::Source::JOYSTICK_PORT, time);
+		}
 		return ay8910.readRegister(registerLatch, time);
 	default:
 		// nothing for 0, 1 and 3
@@ -0,0 +1,64 @@
+#include "FramePacer.hh"
+
+#include "Timer.hh"
+
+#include "ranges.hh"
+
+#include <algorithm>
+#include <thread>
+
+namespace openmsx {
+
+uint64_t FramePacer::waitUntil(uint64_t deadline)
+{
+	auto now = Timer::getTime();
+	if (now >= deadline) {
+		// E.g. emulating or drawing the frame took too long.
+		++late;
+		auto jitter = now - deadline;
+		record(jitter);
+		return jitter;
+	}
+
+	if (auto spin = getSpin(); (deadline - now) > spin) {
+		auto target = deadline - spin;
+		Timer::sleepUntil(target);
+		auto woke = Timer::getTime();
+		auto latency = (woke > target) ? double(woke - target) : 0.0;
+		const double ALPHA = 0.1;
+		oversleep = oversleep * (1 - ALPHA) + latency * ALPHA;
+	}
+	while ((now = Timer::getTime()) < deadline) {
+		std::this_thread::yield();
+	}
+	auto jitter = now - deadline;
+	record(jitter);
+	return jitter;
+}
+
+void FramePacer::record(uint64_t jitter)
+{
+	// first bucket with an upper bound that's not below 'jitter'
+	auto bucket = size_t(ranges::lower_bound(BUCKET_BOUNDS, jitter) - BUCKET_BOUNDS.begin());
+	++histogram[bucket];
+	++count;
+	if (jitter > MISS_THRESHOLD) ++missed;
+	maxJitter = std::max(maxJitter, jitter);
+}
+
+void FramePacer::resetStats()
+{
+	histogram = {};
+	count = 0;
+	missed = 0;
+	late = 0;
+	maxJitter = 0;
+}
+
+uint64_t FramePacer::getSpin() const
+{
+	// twice the average wake-up latency, that covers most of the variation
+	return std::clamp(uint64_t(2.0 * oversleep), MIN_SPIN, MAX_SPIN);
+}
+
+} // namespace openmsx
@@ -0,0 +1,62 @@
+#ifndef FRAMEPACER_HH
+#define FRAMEPACER_HH
+
+#include <array>
+#include <cstdint>
+#include <span>
+
+namespace openmsx {
+
+/** Waits until absolute deadlines (e.g. the moment the next frame should be
+  * shown) and keeps statistics about how precisely those were met.
+  *
+  * The OS is asked to sleep until a bit before the deadline (an absolute
+  * deadline, so it doesn't drift when this thread gets scheduled late). The
+  * remaining time is spent spinning. How long to spin is derived from the
+  * measured wake-up latency of the OS.
+  */
+class FramePacer
+{
+public:
+	/** Upper bounds (in us) of the buckets of the jitter histogram. There's
+	  * one more bucket for everything above the last bound. */
+	static constexpr std::array<uint64_t, 8> BUCKET_BOUNDS = {
+		50, 100, 200, 500, 1000, 2000, 5000, 10000
+	};
+	/** Waking up more than this (in us) after the deadline counts as a
+	  * missed deadline. */
+	static constexpr uint64_t MISS_THRESHOLD = 1000;
+	static constexpr uint64_t MIN_SPIN = 100;
+	static constexpr uint64_t MAX_SPIN = 2000;
+
+	using Histogram = std::array<uint64_t, BUCKET_BOUNDS.size() + 1>;
+
+	/** Wait until the given time, see Timer::getTime().
+	  * @return How late (in us) this method returned.
+	  */
+	uint64_t waitUntil(uint64_t deadline);
+
+	/** Add a measurement to the statistics, waitUntil() already does this. */
+	void record(uint64_t jitter);
+	void resetStats();
+
+	[[nodiscard]] uint64_t getCount() const { return count; }
+	[[nodiscard]] uint64_t getMissed() const { return missed; }
+	[[nodiscard]] uint64_t getLate() const { return late; }
+	[[nodiscard]] uint64_t getMaxJitter() const { return maxJitter; }
+	[[nodiscard]] std::span<const uint64_t> getHistogram() const { return histogram; }
+	/** The time (in us) that is currently spent spinning. */
+	[[nodiscard]] uint64_t getSpin() const;
+
+private:
+	Histogram histogram = {};
+	uint64_t count = 0;     // number of deadlines
+	uint64_t missed = 0;    // jitter was above MISS_THRESHOLD
+	uint64_t late = 0;      // deadline had already passed before waiting
+	uint64_t maxJitter = 0;
+	double oversleep = 250.0; // average wake-up latency of the OS (us)
+};
+
+} // namespace openmsx
+
+#endif
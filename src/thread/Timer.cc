@@ -1,6 +1,13 @@
 #include "Timer.hh"
+
+#include "systemfuncs.hh"
+
 #include <chrono>
 #include <thread>
+#if HAVE_CLOCK_NANOSLEEP
+#include <cerrno>
+#include <ctime>
+#endif
 
 namespace openmsx::Timer {
 
@@ -29,4 +36,22 @@ void sleep(uint64_t us)
 	std::this_thread::sleep_for(std::chrono::microseconds(us));
 }
 
+void sleepUntil(uint64_t time)
+{
+#if HAVE_CLOCK_NANOSLEEP
+	// steady_clock (used in getTime()) is CLOCK_MONOTONIC. An absolute
+	// deadline doesn't drift when the sleep is interrupted or when this
+	// thread gets scheduled late before going to sleep.
+	timespec ts;
+	ts.tv_sec  = time_t(time / 1000000);
+	ts.tv_nsec = long((time % 1000000) * 1000);
+	while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) {
+		// interrupted by a signal, sleep again
+	}
+#else
+	using namespace std::chrono;
+	std::this_thread::sleep_until(steady_clock::time_point(microseconds(time)));
+#endif
+}
+
 } // namespace openmsx::Timer
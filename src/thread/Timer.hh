@@ -14,6 +14,12 @@ namespace openmsx::Timer {
 	  */
 	void sleep(uint64_t us);
 
+	/** Sleep until the given (absolute) time, in the same unit and with
+	  * the same reference as getTime(). Like sleep() this may wake up a
+	  * bit too late (or, on some platforms, too early).
+	  */
+	void sleepUntil(uint64_t time);
+
 } // namespace openmsx::Timer
 
 #endif
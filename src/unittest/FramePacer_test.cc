@@ -0,0 +1,56 @@
+#include "catch.hpp"
+#include "FramePacer.hh"
+
+#include "Timer.hh"
+
+using namespace openmsx;
+
+TEST_CASE("FramePacer: histogram")
+{
+	FramePacer pacer;
+	pacer.record(0);     // bucket 0 (<= 50us)
+	pacer.record(50);    // bucket 0
+	pacer.record(51);    // bucket 1 (<= 100us)
+	pacer.record(1000);  // bucket 4 (<= 1ms), not yet missed
+	pacer.record(1001);  // bucket 5 (<= 2ms), missed
+	pacer.record(99999); // last bucket, missed
+
+	auto hist = pacer.getHistogram();
+	REQUIRE(hist.size() == FramePacer::BUCKET_BOUNDS.size() + 1);
+	CHECK(hist[0] == 2);
+	CHECK(hist[1] == 1);
+	CHECK(hist[2] == 0);
+	CHECK(hist[4] == 1);
+	CHECK(hist[5] == 1);
+	CHECK(hist.back() == 1);
+	CHECK(pacer.getCount() == 6);
+	CHECK(pacer.getMissed() == 2);
+	CHECK(pacer.getMaxJitter() == 99999);
+
+	pacer.resetStats();
+	CHECK(pacer.getCount() == 0);
+	CHECK(pacer.getMaxJitter() == 0);
+	CHECK(pacer.getHistogram()[0] == 0);
+}
+
+TEST_CASE("FramePacer: wait")
+{
+	FramePacer pacer;
+
+	// never returns before the deadline
+	for (int i = 0; i < 5; ++i) {
+		auto deadline = Timer::getTime() + 3000;
+		auto jitter = pacer.waitUntil(deadline);
+		CHECK(Timer::getTime() >= deadline);
+		CHECK(Timer::getTime() >= deadline + jitter);
+	}
+	CHECK(pacer.getCount() == 5);
+	CHECK(pacer.getLate() == 0);
+	CHECK(pacer.getSpin() >= FramePacer::MIN_SPIN);
+	CHECK(pacer.getSpin() <= FramePacer::MAX_SPIN);
+
+	// deadline in the past
+	pacer.waitUntil(Timer::getTime() - 10);
+	CHECK(pacer.getLate() == 1);
+	CHECK(pacer.getCount() == 6);
+}
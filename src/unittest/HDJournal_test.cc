@@ -0,0 +1,244 @@
+#include "catch.hpp"
+#include "HDJournal.hh"
+
+#include "File.hh"
+#include "FileOperations.hh"
+
+#include "xrange.hh"
+
+#include <memory>
+#include <span>
+#include <vector>
+
+using namespace openmsx;
+
+// A small 'disk image' in memory, all writes go via the journal.
+struct TestDisk {
+	explicit TestDisk(size_t budget = HDJournal::DEFAULT_BUDGET)
+		: journal(budget)
+	{
+		for (auto i : xrange(sectors.size())) fill(i, 0);
+	}
+
+	void fill(size_t sector, uint8_t value) {
+		sectors[sector].raw.fill(uint8_t(sector + value));
+	}
+	void write(size_t sector, uint8_t value) {
+		SectorBuffer buf;
+		buf.raw.fill(uint8_t(sector + value));
+		journal.recordWrite(sector, buf, [&](SectorBuffer& original) {
+			original = sectors[sector];
+		});
+		sectors[sector] = buf;
+	}
+	bool restore(unsigned cp) {
+		numRestored = 0;
+		return journal.restore(cp, [&](size_t sector, const SectorBuffer& buf) {
+			sectors[sector] = buf;
+			++numRestored;
+		});
+	}
+	[[nodiscard]] std::vector<uint8_t> content() const {
+		std::vector<uint8_t> result;
+		for (const auto& s : sectors) result.push_back(s.raw[0]);
+		return result;
+	}
+
+	HDJournal journal;
+	std::array<SectorBuffer, 64> sectors;
+	unsigned numRestored = 0;
+};
+
+TEST_CASE("HDJournal: restore linear history")
+{
+	TestDisk disk;
+	auto c0 = disk.content();
+	auto cp0 = disk.journal.checkpoint();
+
+	disk.write(3, 10);
+	disk.write(4, 10);
+	auto c1 = disk.content();
+	auto cp1 = disk.journal.checkpoint();
+
+	disk.write(3, 20);
+	disk.write(7, 20);
+	auto c2 = disk.content();
+	auto cp2 = disk.journal.checkpoint();
+	CHECK(disk.journal.checkpoint() == cp2); // nothing written in between
+
+	disk.write(3, 30); // not yet checkpointed
+
+	CHECK(disk.restore(cp1));
+	CHECK(disk.content() == c1);
+	CHECK(disk.numRestored == 2); // sectors 3 and 7
+
+	CHECK(disk.restore(cp0));
+	CHECK(disk.content() == c0);
+	CHECK(disk.numRestored == 2); // sectors 3 and 4
+
+	CHECK(disk.restore(cp2));
+	CHECK(disk.content() == c2);
+
+	CHECK(disk.restore(cp2));
+	CHECK(disk.numRestored == 0);
+
+	CHECK(!disk.restore(12345));
+	CHECK(disk.content() == c2);
+}
+
+TEST_CASE("HDJournal: restore across branches")
+{
+	TestDisk disk;
+	auto cp0 = disk.journal.checkpoint();
+	disk.write(1, 10);
+	auto cpA = disk.journal.checkpoint();
+	disk.write(2, 10);
+	auto cA = disk.content();
+	auto cpA2 = disk.journal.checkpoint();
+
+	// go back and take a different path
+	CHECK(disk.restore(cpA));
+	disk.write(2, 20);
+	disk.write(5, 20);
+	auto cB = disk.content();
+	auto cpB = disk.journal.checkpoint();
+
+	CHECK(disk.restore(cpA2));
+	CHECK(disk.content() == cA);
+	CHECK(disk.restore(cpB));
+	CHECK(disk.content() == cB);
+	CHECK(disk.restore(cp0));
+	auto c0 = TestDisk().content();
+	CHECK(disk.content() == c0);
+}
+
+TEST_CASE("HDJournal: memory budget")
+{
+	TestDisk disk(2000); // only room for a few (compressed) sectors
+	auto cp0 = disk.journal.checkpoint();
+	std::vector<unsigned> cps;
+	for (auto i : xrange(200)) {
+		disk.write(i % 16, uint8_t(i));
+		cps.push_back(disk.journal.checkpoint());
+		CHECK(disk.journal.getMemoryUsage() <= 2000);
+	}
+	// old checkpoints got dropped, the recent one is still usable
+	CHECK(!disk.restore(cp0));
+	auto c = disk.content();
+	CHECK(disk.restore(cps.back()));
+	CHECK(disk.content() == c);
+
+	disk.journal.clear();
+	CHECK(disk.journal.empty());
+	CHECK(disk.journal.getMemoryUsage() == 0);
+}
+
+TEST_CASE("HDJournal: memory budget, always new sectors")
+{
+	// E.g. copying files: each checkpoint writes sectors that were never
+	// written before. Dropping the oldest checkpoints must release memory,
+	// not only when a sector gets overwritten.
+	TestDisk disk(400);
+	std::vector<unsigned> cps;
+	std::vector<std::vector<uint8_t>> contents;
+	for (auto i : xrange(disk.sectors.size())) {
+		disk.write(i, 10);
+		cps.push_back(disk.journal.checkpoint());
+		contents.push_back(disk.content());
+		CHECK(disk.journal.getMemoryUsage() <= 400);
+		// never falls back to (almost) nothing
+		CHECK(disk.journal.getNumCheckpoints() >= std::min(i + 1, size_t(8)));
+	}
+	CHECK(disk.journal.getNumCheckpoints() < cps.size()); // some were dropped
+
+	auto n = disk.journal.getNumCheckpoints();
+	for (auto i : xrange(cps.size() - n, cps.size())) {
+		CHECK(disk.restore(cps[i]));
+		CHECK(disk.content() == contents[i]);
+	}
+	CHECK(!disk.restore(cps.front()));
+}
+
+TEST_CASE("HDJournal: drop checkpoints across branches")
+{
+	// Dropping the oldest checkpoint folds its content into the original
+	// content, other timelines must still restore correctly.
+	TestDisk disk;
+	auto cpA = disk.journal.checkpoint();
+	disk.write(1, 10);
+	disk.write(2, 10);
+	(void)disk.journal.checkpoint();
+	disk.write(1, 20);
+	auto cA2 = disk.content();
+	auto cpA2 = disk.journal.checkpoint();
+
+	CHECK(disk.restore(cpA));
+	disk.write(2, 30);
+	auto cB = disk.content();
+	auto cpB = disk.journal.checkpoint();
+
+	// this drops the two oldest checkpoints (on the A branch)
+	for (auto i : xrange(HDJournal::MAX_CHECKPOINTS - 2)) {
+		disk.write(3, uint8_t(i));
+		(void)disk.journal.checkpoint();
+	}
+	CHECK(!disk.restore(cpA));
+	CHECK(disk.restore(cpA2));
+	CHECK(disk.content() == cA2);
+	CHECK(disk.restore(cpB));
+	CHECK(disk.content() == cB);
+}
+
+TEST_CASE("HDJournal: restore while another File on the image is open")
+{
+	// When going back in time, the HD of the new machine restores the
+	// image while the HD of the old machine (with its own File object on
+	// the same image) is still alive. Closing that old File later must not
+	// (re)write stale data.
+	auto tmp = FileOperations::getTempDir() + "/hdjournal_unittest";
+	FileOperations::deleteRecursive(tmp);
+	FileOperations::mkdirp(tmp);
+	auto image = tmp + "/hd.dsk";
+	static constexpr size_t NUM_SECTORS = 32;
+	{
+		File file(image, File::OpenMode::CREATE);
+		std::vector<SectorBuffer> zero(NUM_SECTORS);
+		for (auto& s : zero) s.raw.fill(0);
+		file.write(std::span{zero});
+	}
+	auto makeSector = [](uint8_t value) {
+		SectorBuffer buf;
+		buf.raw.fill(value);
+		return buf;
+	};
+	HDJournal journal;
+	auto readSector = [&](size_t sector) {
+		File file(image);
+		journal.flushOtherFile(file);
+		SectorBuffer buf;
+		file.seek(sector * sizeof(buf));
+		file.read(buf.raw);
+		return buf.raw[0];
+	};
+
+	auto oldHD = std::make_unique<File>(image);
+	auto a = makeSector(0xAA);
+	journal.writeSectors(*oldHD, std::span{&a, 1}, 5, true);
+	auto cp = journal.checkpoint();
+	auto b = makeSector(0xBB);
+	journal.writeSectors(*oldHD, std::span{&b, 1}, 5, true);
+	CHECK(readSector(5) == 0xBB); // visible for other File objects
+
+	{
+		File newHD(image);
+		std::vector<size_t> changed;
+		CHECK(journal.restore(newHD, cp, [&](size_t sector) { changed.push_back(sector); }));
+		CHECK(changed == std::vector<size_t>{5});
+	}
+	CHECK(readSector(5) == 0xAA);
+	journal.forgetFile(*oldHD);
+	oldHD.reset(); // close
+	CHECK(readSector(5) == 0xAA);
+
+	FileOperations::deleteRecursive(tmp);
+}
@@ -0,0 +1,73 @@
+#include "catch.hpp"
+
+#include "MPSCQueue.hh"
+#include "ranges.hh"
+#include "xrange.hh"
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <thread>
+#include <vector>
+
+TEST_CASE("MPSCQueue: single thread")
+{
+	MPSCQueue<std::unique_ptr<int>> queue;
+	CHECK(queue.empty());
+
+	std::vector<std::unique_ptr<int>> result;
+	CHECK(!queue.popAll(result));
+	CHECK(result.empty());
+
+	CHECK( queue.push(std::make_unique<int>(1))); // was empty
+	CHECK(!queue.push(std::make_unique<int>(2)));
+	CHECK(!queue.push(std::make_unique<int>(3)));
+	CHECK(!queue.empty());
+
+	CHECK(queue.popAll(result));
+	CHECK(queue.empty());
+	REQUIRE(result.size() == 3);
+	CHECK(*result[0] == 1);
+	CHECK(*result[1] == 2);
+	CHECK(*result[2] == 3);
+
+	// appends to the existing content
+	CHECK(queue.push(std::make_unique<int>(4)));
+	CHECK(queue.popAll(result));
+	REQUIRE(result.size() == 4);
+	CHECK(*result[3] == 4);
+
+	// remaining elements are destroyed together with the queue
+	queue.push(std::make_unique<int>(5));
+}
+
+TEST_CASE("MPSCQueue: multiple producers")
+{
+	static constexpr int NUM_THREADS = 4;
+	static constexpr int NUM_ITEMS = 10000;
+
+	MPSCQueue<int> queue;
+	std::vector<std::thread> producers;
+	for (auto t : xrange(NUM_THREADS)) {
+		producers.emplace_back([&queue, t] {
+			for (auto i : xrange(NUM_ITEMS)) {
+				queue.push(t * NUM_ITEMS + i);
+			}
+		});
+	}
+
+	std::vector<int> result;
+	while (result.size() < size_t(NUM_THREADS * NUM_ITEMS)) {
+		queue.popAll(result);
+	}
+	for (auto& p : producers) p.join();
+	CHECK(queue.empty());
+
+	// the elements of each producer are in order
+	for (auto t : xrange(NUM_THREADS)) {
+		std::vector<int> fromThread;
+		ranges::copy_if(result, back_inserter(fromThread),
+		                [&](int v) { return (v / NUM_ITEMS) == t; });
+		CHECK(fromThread.size() == size_t(NUM_ITEMS));
+		CHECK(ranges::is_sorted(fromThread));
+	}
+}
@@ -0,0 +1,131 @@
+#include "catch.hpp"
+
+#include "PolymorphicLog.hh"
+#include "xrange.hh"
+#include <memory>
+#include <vector>
+
+
+struct LogBase
+{
+	static inline std::vector<int> destructed;
+
+	explicit LogBase(int i_) : i(i_) {}
+	virtual ~LogBase() { destructed.push_back(i); }
+	[[nodiscard]] virtual int get() const { return i; }
+
+	int i;
+};
+
+struct LogSmall final : LogBase
+{
+	using LogBase::LogBase;
+};
+
+struct LogLarge final : LogBase
+{
+	LogLarge(int i_, int extra_) : LogBase(i_), extra(extra_) {}
+	[[nodiscard]] int get() const override { return i + extra; }
+
+	int extra;
+	std::vector<int> payload = std::vector<int>(10, 1); // non-trivial member
+};
+
+TEST_CASE("PolymorphicLog: append and truncate")
+{
+	LogBase::destructed.clear();
+	{
+		PolymorphicLog<LogBase> log;
+		CHECK(log.empty());
+		CHECK(log.getMemoryUsage() == 0);
+
+		for (auto i : xrange(10)) {
+			if (i & 1) {
+				log.emplace_back<LogLarge>(i, 100);
+			} else {
+				log.emplace_back<LogSmall>(i);
+			}
+		}
+		REQUIRE(log.size() == 10);
+		CHECK(log[0].get() == 0);
+		CHECK(log[1].get() == 101);
+		CHECK(log.back().get() == 109);
+
+		log.truncate(7);
+		CHECK(log.size() == 7);
+		CHECK(LogBase::destructed == std::vector{9, 8, 7});
+
+		log.pop_back();
+		CHECK(log.back().get() == 105);
+
+		// freed memory is reused
+		const auto* p = &log.emplace_back<LogSmall>(42);
+		log.pop_back();
+		CHECK(&log.emplace_back<LogSmall>(43) == p);
+
+		LogBase::destructed.clear();
+	}
+	// remaining elements are destroyed together with the log
+	CHECK(LogBase::destructed == std::vector{43, 5, 4, 3, 2, 1, 0});
+}
+
+TEST_CASE("PolymorphicLog: multiple blocks")
+{
+	PolymorphicLog<LogBase> log;
+	static constexpr int N = 100'000;
+	for (auto i : xrange(N)) {
+		log.emplace_back<LogSmall>(i);
+	}
+	REQUIRE(log.size() == size_t(N));
+
+	// memory per element: only the object itself plus one index pointer
+	// (plus some slack at the end of the blocks and the index)
+	auto perElement = double(log.getMemoryUsage()) / N;
+	CHECK(perElement < 2.0 * (sizeof(LogSmall) + sizeof(void*)));
+
+	// shrink into an earlier block, and grow again
+	auto mem = log.getMemoryUsage();
+	log.truncate(N / 3);
+	for (auto i : xrange(N / 3, N)) {
+		log.emplace_back<LogSmall>(i);
+	}
+	CHECK(log.getMemoryUsage() == mem); // blocks are reused
+	bool ok = true;
+	for (auto i : xrange(N)) {
+		ok &= log[i].get() == i;
+	}
+	CHECK(ok);
+
+	log.clear();
+	CHECK(log.empty());
+	CHECK(log.getMemoryUsage() == 0);
+}
+
+TEST_CASE("PolymorphicLog: adopt")
+{
+	LogBase::destructed.clear();
+	PolymorphicLog<LogBase> log;
+	log.adopt(std::make_unique<LogSmall>(0));
+	log.adopt(std::make_unique<LogLarge>(1, 10));
+	log.emplace_back<LogSmall>(2);
+	log.emplace_back<LogSmall>(3);
+	REQUIRE(log.size() == 4);
+	CHECK(log[1].get() == 11);
+	CHECK(log[2].get() == 2);
+
+	log.truncate(1); // removes both adopted and block allocated elements
+	CHECK(LogBase::destructed == std::vector{3, 2, 1});
+	CHECK(log.size() == 1);
+
+	log.emplace_back<LogSmall>(4);
+	CHECK(log.back().get() == 4);
+
+	// move and swap
+	PolymorphicLog<LogBase> log2 = std::move(log);
+	CHECK(log.empty());
+	REQUIRE(log2.size() == 2);
+	swap(log, log2);
+	CHECK(log.size() == 2);
+	CHECK(log2.empty());
+	CHECK(log[0].get() == 0);
+}
@@ -0,0 +1,116 @@
+#include "catch.hpp"
+#include "SparseRamBuffer.hh"
+
+#include "ranges.hh"
+#include "xrange.hh"
+
+#include <array>
+#include <memory>
+#include <vector>
+
+using namespace openmsx;
+
+static void checkBuffer(SparseRamBuffer& buf)
+{
+	static constexpr auto SEG = SparseRamBuffer::SEGMENT_SIZE;
+	// the buffer never moves (pointers to it are stored elsewhere)
+	const auto* data = buf.data();
+
+	std::array<uint8_t, SEG> pattern;
+	ranges::fill(pattern, 0xFF);
+	buf.fill(pattern);
+	REQUIRE(buf.hasFillPattern());
+	for (auto i : xrange(buf.numSegments())) {
+		CHECK(buf.isPristine(i));
+	}
+	CHECK(buf[0] == 0xFF);
+	CHECK(buf[buf.size() - 1] == 0xFF);
+
+	// writing to one segment doesn't affect the others
+	buf[SEG + 5] = 0x12;
+	CHECK(buf[SEG + 5] == 0x12);
+	CHECK(buf[5] == 0xFF);
+	CHECK(buf.isPristine(0));
+	CHECK(!buf.isPristine(1));
+	if (buf.numSegments() > 2) {
+		CHECK(buf[2 * SEG + 5] == 0xFF);
+		CHECK(buf.isPristine(2));
+	}
+
+	// restore a single segment
+	buf.resetSegment(1);
+	CHECK(buf[SEG + 5] == 0xFF);
+	CHECK(buf.isPristine(1));
+
+	// refill with a different pattern
+	for (auto i : xrange(SEG)) pattern[i] = uint8_t(i);
+	buf[7] = 0x34;
+	buf.fill(pattern);
+	for (auto i : xrange(buf.numSegments())) {
+		CHECK(buf.isPristine(i));
+	}
+	CHECK(buf[7] == 7);
+	CHECK(buf[SEG + 7] == 7);
+
+	// without pattern nothing is pristine
+	buf.forgetPattern();
+	CHECK(!buf.isPristine(0));
+
+	CHECK(buf.data() == data);
+}
+
+TEST_CASE("SparseRamBuffer")
+{
+	SECTION("large (sparse) buffer") {
+		SparseRamBuffer buf(64 * SparseRamBuffer::SEGMENT_SIZE);
+		CHECK(buf.size() == 64 * SparseRamBuffer::SEGMENT_SIZE);
+		CHECK(buf.numSegments() == 64);
+		checkBuffer(buf);
+	}
+	SECTION("small buffer") {
+		SparseRamBuffer buf(2 * SparseRamBuffer::SEGMENT_SIZE);
+		CHECK(buf.numSegments() == 2);
+		checkBuffer(buf);
+	}
+	SECTION("partial segment") {
+		SparseRamBuffer buf(SparseRamBuffer::SEGMENT_SIZE + 100);
+		CHECK(buf.numSegments() == 2);
+		CHECK(buf.getSegment(1).size() == 100);
+		checkBuffer(buf);
+	}
+}
+
+TEST_CASE("SparseRamBuffer: shared patterns")
+{
+	static constexpr auto SEG = SparseRamBuffer::SEGMENT_SIZE;
+	std::array<uint8_t, SEG> pattern;
+	ranges::fill(pattern, 0xA5);
+
+	// many buffers with the same pattern are independent
+	std::vector<std::unique_ptr<SparseRamBuffer>> buffers;
+	for (auto i : xrange(100)) {
+		auto& buf = *buffers.emplace_back(std::make_unique<SparseRamBuffer>(8 * SEG));
+		buf.fill(pattern);
+		buf[3 * SEG] = uint8_t(i);
+	}
+	for (auto i : xrange(100)) {
+		auto& buf = *buffers[i];
+		CHECK(buf[3 * SEG] == uint8_t(i));
+		CHECK(buf[3 * SEG + 1] == 0xA5);
+		CHECK(buf.isPristine(2));
+		CHECK(!buf.isPristine(3));
+	}
+
+	// more distinct patterns than fit in the shared pattern file
+	for (auto i : xrange(100)) {
+		ranges::fill(pattern, uint8_t(i));
+		auto& buf = *buffers[i];
+		buf.fill(pattern);
+		CHECK(buf[0] == uint8_t(i));
+		CHECK(buf[8 * SEG - 1] == uint8_t(i));
+		buf[SEG] = uint8_t(i + 1);
+		buf.resetSegment(1);
+		CHECK(buf[SEG] == uint8_t(i));
+		CHECK(buf.isPristine(1));
+	}
+}
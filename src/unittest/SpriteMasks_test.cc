@@ -0,0 +1,113 @@
+#include "catch.hpp"
+#include "SpriteMasks.hh"
+
+#include "xrange.hh"
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <vector>
+
+using namespace openmsx;
+
+struct Sprite {
+	int x;
+	uint32_t pattern;
+};
+
+// The pair-wise check that SpriteChecker used before.
+static int referenceCollision(const std::vector<Sprite>& sprites, int magSize)
+{
+	int minXCollision = 999;
+	for (int i = int(sprites.size()); --i >= 1; /**/) {
+		int x_i = sprites[i].x;
+		uint32_t pattern_i = sprites[i].pattern;
+		for (int j = i; --j >= 0; /**/) {
+			int x_j = sprites[j].x;
+			int dist = x_j - x_i;
+			if ((-magSize < dist) && (dist < magSize)) {
+				uint32_t pattern_j = sprites[j].pattern;
+				if (dist < 0) {
+					pattern_j <<= -dist;
+				} else {
+					pattern_j >>= dist;
+				}
+				uint32_t colPat = pattern_i & pattern_j;
+				if (x_i < 0) {
+					colPat &= (1u << (32 + x_i)) - 1;
+				}
+				if (colPat) {
+					int xCollision = x_i + std::countl_zero(colPat);
+					minXCollision = std::min(minXCollision, xCollision);
+				}
+			}
+		}
+	}
+	return std::min(minXCollision, 256);
+}
+
+static int maskCollision(const std::vector<Sprite>& sprites)
+{
+	SpriteCollisionMask collision;
+	for (const auto& s : sprites) collision.add(s.x, s.pattern);
+	return collision.first();
+}
+
+TEST_CASE("SpriteMasks: visibleSpritesMask")
+{
+	std::minstd_rand rng(12345);
+	std::array<uint8_t, 32> spriteY;
+	for (auto round : xrange(100)) {
+		for (auto& y : spriteY) y = uint8_t(rng());
+		if (round == 0) std::iota(spriteY.begin(), spriteY.end(), uint8_t(240)); // wraps around
+		for (unsigned magSize : {8, 16, 32}) {
+			for (auto line : xrange(256)) {
+				uint32_t expected = 0;
+				for (auto n : xrange(32)) {
+					int spriteLine = (line - spriteY[n]) & 0xFF;
+					if (spriteLine < int(magSize)) expected |= 1u << n;
+				}
+				CHECK(visibleSpritesMask(spriteY, uint8_t(line), magSize) == expected);
+			}
+		}
+	}
+}
+
+TEST_CASE("SpriteMasks: SpriteCollisionMask")
+{
+	// no sprites, single sprite
+	CHECK(maskCollision({}) == 256);
+	CHECK(maskCollision({{10, 0xFFFF'FFFF}}) == 256);
+
+	// partially overlapping
+	CHECK(maskCollision({{10, 0xFF00'0000}, {14, 0xFF00'0000}}) == 14);
+	CHECK(maskCollision({{14, 0xFF00'0000}, {10, 0xFF00'0000}}) == 14);
+	// adjacent, but not overlapping
+	CHECK(maskCollision({{10, 0xFF00'0000}, {18, 0xFF00'0000}}) == 256);
+	// only the third sprite overlaps
+	CHECK(maskCollision({{0, 0xF000'0000}, {100, 0xF000'0000}, {102, 0x8000'0000}}) == 102);
+
+	// overlap left of the screen doesn't count
+	CHECK(maskCollision({{-32, 0xFFFF'FFFF}, {-32, 0xFFFF'FFFF}}) == 256);
+	CHECK(maskCollision({{-20, 0xFFFF'0000}, {-20, 0xFFFF'0000}}) == 256);
+	CHECK(maskCollision({{-20, 0xFFFF'FFFF}, {-30, 0xFFFF'FFFF}}) == 0);
+	// overlap right of the screen doesn't count either
+	CHECK(maskCollision({{250, 0xFFFF'FFFF}, {255, 0x8000'0000}}) == 255);
+	CHECK(maskCollision({{250, 0xFC00'0000}, {255, 0x7000'0000}}) == 256);
+
+	// Compare with the pair-wise check, on randomly generated lines.
+	std::minstd_rand rng(54321);
+	for (int magSize : {8, 16, 32}) {
+		auto sizeMask = uint32_t(~0ull << (32 - magSize));
+		for (auto round : xrange(20000)) {
+			(void)round;
+			std::vector<Sprite> sprites(rng() % 9); // 0..8 sprites
+			for (auto& s : sprites) {
+				s.x = int(rng() % 288) - 32; // -32..255
+				// sparse patterns, so not every line collides
+				s.pattern = uint32_t(rng()) & uint32_t(rng()) & sizeMask;
+			}
+			CHECK(maskCollision(sprites) == referenceCollision(sprites, magSize));
+		}
+	}
+}
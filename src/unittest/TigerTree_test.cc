@@ -3,6 +3,7 @@
 #include "tiger.hh"
 #include "ranges.hh"
 #include <span>
+#include <vector>
 
 using namespace openmsx;
 
@@ -88,3 +89,100 @@ TEST_CASE("TigerTree")
 		      "PLHCYOTPV4TTXTUPHYGGVPMARGMFE4U5JYRV4VA");
 	}
 }
+
+struct TTCountingData final : public TTData
+{
+	uint8_t* getData(size_t offset, size_t /*size*/) override
+	{
+		++numCalls;
+		return buffer + offset;
+	}
+
+	bool isCacheStillValid(time_t& time) override
+	{
+		time = 0; // like a file with a fixed modification time
+		return false;
+	}
+
+	uint8_t* buffer;
+	int numCalls = 0;
+};
+
+TEST_CASE("TigerTree: large tree, saveState/loadState")
+{
+	static constexpr auto BLOCK_SIZE = TigerTree::BLOCK_SIZE;
+	static constexpr size_t SIZE = 300 * BLOCK_SIZE + 123;
+	std::vector<uint8_t> buffer_(SIZE + 1);
+	auto buffer = std::span{buffer_}.subspan(1);
+	for (size_t i = 0; i < SIZE; ++i) buffer[i] = uint8_t(i * 7 + (i >> 10));
+
+	TTCountingData data;
+	data.buffer = buffer.data();
+	time_t dummyTime = 0;
+	auto dummyCallback = [](size_t, size_t) {};
+
+	// initial calculation (possibly in parallel)
+	TigerTree tt(data, SIZE, "large");
+	auto hash = tt.calcHash(dummyCallback).toString();
+
+	// recalculate some (sparse) leaves, this is done sequentially
+	for (size_t b = 0; b < 300; b += 8) {
+		tt.notifyChange(b * BLOCK_SIZE, BLOCK_SIZE, dummyTime);
+	}
+	CHECK(tt.calcHash(dummyCallback).toString() == hash);
+
+	auto state = tt.saveState();
+	REQUIRE(!state.empty());
+
+	// a fresh tree with the restored state doesn't need the data
+	TigerTree tt2(data, SIZE, "restored");
+	CHECK(tt2.loadState(state));
+	data.numCalls = 0;
+	CHECK(tt2.calcHash(dummyCallback).toString() == hash);
+	CHECK(data.numCalls == 0);
+
+	// after a change only (at most) one persisted subtree is rehashed
+	buffer[100 * BLOCK_SIZE + 5] ^= 1;
+	tt2.notifyChange(100 * BLOCK_SIZE + 5, 1, dummyTime);
+	data.numCalls = 0;
+	auto hash2 = tt2.calcHash(dummyCallback).toString();
+	CHECK(data.numCalls <= int(TigerTree::PERSIST_LEVEL));
+	CHECK(hash2 != hash);
+
+	TigerTree tt3(data, SIZE, "reference");
+	CHECK(tt3.calcHash(dummyCallback).toString() == hash2);
+
+	// state of a different size is rejected
+	TigerTree tt4(data, SIZE - BLOCK_SIZE, "other");
+	CHECK(!tt4.loadState(state));
+}
+
+TEST_CASE("TigerTree: several parallel batches")
+{
+	// More than 2 batches of (in parallel) hashed leaves, compare with a
+	// straightforward (sequential) calculation.
+	static constexpr auto BLOCK_SIZE = TigerTree::BLOCK_SIZE;
+	static constexpr size_t NUM_BLOCKS = 9000;
+	static constexpr size_t SIZE = NUM_BLOCKS * BLOCK_SIZE;
+	std::vector<uint8_t> buffer_(SIZE + 1);
+	auto buffer = std::span{buffer_}.subspan(1);
+	for (size_t i = 0; i < SIZE; ++i) buffer[i] = uint8_t(i * 13 + (i >> 12));
+
+	std::vector<TigerHash> level(NUM_BLOCKS);
+	for (size_t b = 0; b < NUM_BLOCKS; ++b) {
+		tiger_leaf(buffer.subspan(b * BLOCK_SIZE, BLOCK_SIZE), level[b]);
+	}
+	while (level.size() > 1) {
+		std::vector<TigerHash> next((level.size() + 1) / 2);
+		for (size_t i = 0; i < level.size() / 2; ++i) {
+			tiger_int(level[2 * i], level[2 * i + 1], next[i]);
+		}
+		if (level.size() & 1) next.back() = level.back();
+		level = std::move(next);
+	}
+
+	TTTestData data;
+	data.buffer = buffer.data();
+	TigerTree tt(data, SIZE, "batches");
+	CHECK(tt.calcHash([](size_t, size_t) {}).toString() == level[0].toString());
+}
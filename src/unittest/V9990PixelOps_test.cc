@@ -0,0 +1,328 @@
+#include "catch.hpp"
+#include "V9990PixelOps.hh"
+
+#include "xrange.hh"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+using namespace openmsx;
+using namespace openmsx::V9990PixelOps;
+
+// The per-pixel code that V9990BitmapConverter and V9990PxConverter used
+// before, used as reference and as baseline in the benchmarks.
+
+static uint8_t refReadBx(std::span<const uint8_t> vram, unsigned address)
+{
+	address &= 0x7FFFF;
+	return vram[((address & 1) << 18) | ((address & 0x7FFFE) >> 1)];
+}
+
+template<bool YJK, bool PAL>
+static void refYJK(std::span<const uint8_t> vram, unsigned address, std::span<uint16_t> out)
+{
+	for (size_t i = 0; i < out.size(); i += 4) {
+		std::array<uint8_t, 4> data;
+		for (auto& d : data) d = refReadBx(vram, address++);
+		int u = (data[2] & 7) + ((data[3] & 3) << 3) - ((data[3] & 4) << 3);
+		int v = (data[0] & 7) + ((data[1] & 3) << 3) - ((data[1] & 4) << 3);
+		for (auto j : xrange(4)) {
+			if (PAL && (data[j] & 0x08)) {
+				out[i + j] = uint16_t(0x8000 | (data[j] >> 4));
+			} else {
+				int y = (data[j] & 0xF8) >> 3;
+				int r = std::clamp(y + u,                   0, 31);
+				int g = std::clamp((5 * y - 2 * u - v) / 4, 0, 31);
+				int b = std::clamp(y + v,                   0, 31);
+				if constexpr (YJK) std::swap(g, b);
+				out[i + j] = uint16_t((g << 10) + (r << 5) + b);
+			}
+		}
+	}
+}
+
+static std::vector<uint8_t> randomVRAM()
+{
+	std::vector<uint8_t> vram(0x80000);
+	std::minstd_rand rng(1234);
+	for (auto& b : vram) b = uint8_t(rng());
+	return vram;
+}
+
+static std::span<const uint8_t, 0x80000> fixed(const std::vector<uint8_t>& vram)
+{
+	return std::span<const uint8_t, 0x80000>(vram.data(), 0x80000);
+}
+
+// Addresses and lengths around the interesting boundaries.
+static constexpr std::array addresses = {
+	0u, 1u, 2u, 31u, 1000u, 0x7FFC0u, 0x7FFC1u, 0x7FFFFu, 0x80010u};
+static constexpr std::array lengths = {
+	0u, 1u, 4u, 31u, 32u, 33u, 64u, 100u, 1028u};
+
+TEST_CASE("V9990PixelOps: readBx")
+{
+	auto vram = randomVRAM();
+	std::vector<uint8_t> out(1028);
+	for (auto address : addresses) {
+		for (auto len : lengths) {
+			auto o = std::span(out).first(len);
+			readBx(fixed(vram), address, o);
+			for (auto i : xrange(len)) {
+				CHECK(o[i] == refReadBx(vram, address + i));
+			}
+		}
+	}
+}
+
+template<bool YJK, bool PAL>
+static void checkYJK(const std::vector<uint8_t>& vram)
+{
+	std::vector<uint8_t> data(1028);
+	std::vector<uint16_t> expected(1028), actual(1028);
+	for (auto address : addresses) {
+		for (auto len : lengths) {
+			len &= ~3;
+			auto d = std::span(data).first(len);
+			auto a = std::span(actual).first(len);
+			readBx(fixed(vram), address, d);
+			refYJK<YJK, PAL>(vram, address, std::span(expected).first(len));
+			yjkToIndex<YJK, PAL>(d, a);
+			CHECK(std::ranges::equal(a, std::span(expected).first(len)));
+		}
+	}
+}
+
+TEST_CASE("V9990PixelOps: yjkToIndex")
+{
+	auto vram = randomVRAM();
+	checkYJK<false, false>(vram);
+	checkYJK<false, true >(vram);
+	checkYJK<true,  false>(vram);
+	checkYJK<true,  true >(vram);
+
+	// all combinations of Y, J and K
+	std::vector<uint8_t> all;
+	for (auto y : xrange(32)) {
+		for (auto jk : xrange(64 * 64)) {
+			auto j = jk & 63, k = jk >> 6;
+			all.push_back(uint8_t((y << 3) | (k & 7)));
+			all.push_back(uint8_t((y << 3) | (k >> 3)));
+			all.push_back(uint8_t((y << 3) | (j & 7)));
+			all.push_back(uint8_t((y << 3) | (j >> 3)));
+		}
+	}
+	std::vector<uint16_t> out(all.size());
+	yjkToIndex<true, false>(all, out);
+	for (size_t i = 0; i < all.size(); i += 4) {
+		int y = all[i] >> 3;
+		int j = (all[i + 2] & 7) | ((all[i + 3] & 7) << 3); if (j >= 32) j -= 64;
+		int k = (all[i + 0] & 7) | ((all[i + 1] & 7) << 3); if (k >= 32) k -= 64;
+		int r = std::clamp(y + j, 0, 31);
+		int g = std::clamp(y + k, 0, 31);
+		int b = std::clamp((5 * y - 2 * j - k) / 4, 0, 31);
+		CHECK(out[i] == ((g << 10) | (r << 5) | b));
+	}
+}
+
+TEST_CASE("V9990PixelOps: bd16ToIndex")
+{
+	auto vram = randomVRAM();
+	std::vector<uint8_t> data(2 * 1028);
+	std::vector<uint16_t> out(1028);
+	for (auto len : lengths) {
+		auto d = std::span(data).first(2 * len);
+		auto o = std::span(out).first(len);
+		readBx(fixed(vram), 2 * 1000, d);
+		for (bool keepBit15 : {false, true}) {
+			bd16ToIndex(d, o, keepBit15);
+			for (auto i : xrange(len)) {
+				auto low  = refReadBx(vram, 2 * (1000 + i) + 0);
+				auto high = refReadBx(vram, 2 * (1000 + i) + 1);
+				CHECK(o[i] == ((low + 256 * high) & (keepBit15 ? 0xFFFF : 0x7FFF)));
+			}
+		}
+	}
+}
+
+TEST_CASE("V9990PixelOps: unpack4, unpack2")
+{
+	auto vram = randomVRAM();
+	auto in = std::span(vram).first(257);
+	std::vector<uint8_t> out(4 * 257);
+	for (auto len : {0u, 1u, 15u, 16u, 17u, 100u, 257u}) {
+		auto i = in.first(len);
+		for (uint8_t oddOr : {0, 32}) {
+			auto o4 = std::span(out).first(2 * len);
+			unpack4(i, o4, 0, oddOr);
+			for (auto n : xrange(len)) {
+				CHECK(o4[2 * n + 0] == (i[n] >> 4));
+				CHECK(o4[2 * n + 1] == ((i[n] & 0x0F) | oddOr));
+			}
+
+			auto o2 = std::span(out).first(4 * len);
+			unpack2(i, o2, 0, oddOr);
+			for (auto n : xrange(len)) {
+				CHECK(o2[4 * n + 0] == ((i[n] & 0xC0) >> 6));
+				CHECK(o2[4 * n + 1] == (((i[n] & 0x30) >> 4) | oddOr));
+				CHECK(o2[4 * n + 2] == ((i[n] & 0x0C) >> 2));
+				CHECK(o2[4 * n + 3] == (((i[n] & 0x03) >> 0) | oddOr));
+			}
+		}
+	}
+}
+
+TEST_CASE("V9990PixelOps: expandNibbles, nonZeroBytes")
+{
+	static_assert(expandNibbles(0x12345678) == 0x0807'0605'0403'0201);
+	static_assert(expandNibbles(0xF00F0000) == 0x0000'0000'0F00'000F);
+	static_assert(nonZeroBytes(0x0807'0605'0403'0201) == 0x0101'0101'0101'0101);
+	static_assert(nonZeroBytes(0x0000'0000'0F00'000F) == 0x0000'0000'0100'0001);
+
+	std::minstd_rand rng(4321);
+	for (auto round : xrange(1000)) {
+		(void)round;
+		auto pattern = uint32_t(rng()) & uint32_t(rng()); // also zero nibbles
+		auto pixels = expandNibbles(pattern);
+		auto info = nonZeroBytes(pixels);
+		for (auto i : xrange(8)) {
+			auto p = (pattern >> (28 - 4 * i)) & 0x0F;
+			CHECK(((pixels >> (8 * i)) & 0xFF) == p);
+			CHECK(((info >> (8 * i)) & 0xFF) == (p != 0));
+		}
+	}
+}
+
+// Run with: unittest "[.benchmark]"
+// Each mode converts a 1024 pixel line to 32bpp host pixels, both the old
+// per-pixel way and with the line operations.
+TEST_CASE("V9990PixelOps: benchmarks", "[.benchmark]")
+{
+	auto vram = randomVRAM();
+	std::vector<uint32_t> palette32768(32768), palette256(256), palette64(64);
+	std::minstd_rand rng(5678);
+	for (auto& p : palette32768) p = uint32_t(rng());
+	for (auto& p : palette256)   p = uint32_t(rng());
+	for (auto& p : palette64)    p = uint32_t(rng());
+
+	static constexpr unsigned WIDTH = 1024;
+	static constexpr unsigned ADDRESS = 0x1234 * 4;
+	std::array<uint32_t, WIDTH> line;
+	std::array<uint8_t, 2 * WIDTH> data;
+	std::array<uint16_t, WIDTH> indices;
+	std::array<uint8_t, WIDTH> pixels;
+
+	auto benchYJK = [&]<bool YJK, bool PAL>(const char* name) {
+		BENCHMARK(std::string(name) + " per pixel") {
+			refYJK<YJK, PAL>(vram, ADDRESS, indices);
+			for (auto i : xrange(WIDTH)) {
+				auto idx = indices[i];
+				line[i] = (PAL && (idx & 0x8000)) ? palette64[idx & 0x0F] : palette32768[idx];
+			}
+			return line[0];
+		};
+		BENCHMARK(std::string(name) + " line") {
+			readBx(fixed(vram), ADDRESS, std::span(data).first(WIDTH));
+			yjkToIndex<YJK, PAL>(std::span(data).first(WIDTH), indices);
+			for (auto i : xrange(WIDTH)) {
+				auto idx = indices[i];
+				line[i] = (PAL && (idx & 0x8000)) ? palette64[idx & 0x0F] : palette32768[idx];
+			}
+			return line[0];
+		};
+	};
+	benchYJK.operator()<false, false>("BYUV");
+	benchYJK.operator()<false, true >("BYUVP");
+	benchYJK.operator()<true,  false>("BYJK");
+	benchYJK.operator()<true,  true >("BYJKP");
+
+	BENCHMARK("BD16 per pixel") {
+		unsigned address = 2 * ADDRESS;
+		for (auto i : xrange(WIDTH)) {
+			auto low  = refReadBx(vram, address++);
+			auto high = refReadBx(vram, address++);
+			line[i] = palette32768[(low + 256 * high) & 0x7FFF];
+		}
+		return line[0];
+	};
+	BENCHMARK("BD16 line") {
+		readBx(fixed(vram), 2 * ADDRESS, data);
+		bd16ToIndex(data, indices, false);
+		for (auto i : xrange(WIDTH)) line[i] = palette32768[indices[i]];
+		return line[0];
+	};
+
+	BENCHMARK("BD8 per pixel") {
+		for (auto i : xrange(WIDTH)) line[i] = palette256[refReadBx(vram, ADDRESS + i)];
+		return line[0];
+	};
+	BENCHMARK("BD8 line") {
+		readBx(fixed(vram), ADDRESS, std::span(data).first(WIDTH));
+		for (auto i : xrange(WIDTH)) line[i] = palette256[data[i]];
+		return line[0];
+	};
+
+	BENCHMARK("BP4 per pixel") {
+		for (unsigned i = 0; i < WIDTH; i += 2) {
+			auto d = refReadBx(vram, ADDRESS + i / 2);
+			line[i + 0] = palette64[d >> 4];
+			line[i + 1] = palette64[d & 0x0F];
+		}
+		return line[0];
+	};
+	BENCHMARK("BP4 line") {
+		auto d = std::span(data).first(WIDTH / 2);
+		readBx(fixed(vram), ADDRESS, d);
+		unpack4(d, pixels);
+		for (auto i : xrange(WIDTH)) line[i] = palette64[pixels[i]];
+		return line[0];
+	};
+
+	BENCHMARK("BP2 per pixel") {
+		for (unsigned i = 0; i < WIDTH; i += 4) {
+			auto d = refReadBx(vram, ADDRESS + i / 4);
+			line[i + 0] = palette64[(d & 0xC0) >> 6];
+			line[i + 1] = palette64[(d & 0x30) >> 4];
+			line[i + 2] = palette64[(d & 0x0C) >> 2];
+			line[i + 3] = palette64[(d & 0x03) >> 0];
+		}
+		return line[0];
+	};
+	BENCHMARK("BP2 line") {
+		auto d = std::span(data).first(WIDTH / 4);
+		readBx(fixed(vram), ADDRESS, d);
+		unpack2(d, pixels);
+		for (auto i : xrange(WIDTH)) line[i] = palette64[pixels[i]];
+		return line[0];
+	};
+
+	// P2 pattern layer (512 pixels), without the name table lookups
+	BENCHMARK("P2 per pixel") {
+		for (unsigned i = 0; i < 512; i += 2) {
+			auto d = refReadBx(vram, ADDRESS + i / 2);
+			pixels[i + 0] = bool(d >> 4);
+			line  [i + 0] = palette64[d >> 4];
+			pixels[i + 1] = bool(d & 0x0F);
+			line  [i + 1] = palette64[d & 0x0F];
+		}
+		return line[0];
+	};
+	BENCHMARK("P2 per character") {
+		for (unsigned i = 0; i < 512; i += 8) {
+			uint32_t pattern = 0;
+			for (auto j : xrange(4)) {
+				pattern = (pattern << 8) | refReadBx(vram, ADDRESS + i / 2 + j);
+			}
+			auto p = expandNibbles(pattern);
+			auto info = nonZeroBytes(p);
+			std::memcpy(&pixels[i], &info, 8);
+			for (auto j : xrange(8)) line[i + j] = palette64[(p >> (8 * j)) & 0x0F];
+		}
+		return line[0];
+	};
+}
@@ -0,0 +1,84 @@
+#ifndef MPSCQUEUE_HH
+#define MPSCQUEUE_HH
+
+#include <atomic>
+#include <utility>
+#include <vector>
+
+// MPSCQueue
+//
+// A lock-free multiple-producer single-consumer queue.
+// - push() can be called from any thread (concurrently).
+// - popAll() may only be called from one thread at a time (the consumer).
+//   It takes all elements in one go (in the order in which they were pushed).
+//
+// Implementation: the producers atomically prepend a node to a singly linked
+// list (so in reverse order). The consumer atomically takes the whole list and
+// reverses it. Both operations only need a single atomic instruction (plus a
+// retry loop for push() in case of contention).
+
+template<typename T> class MPSCQueue
+{
+public:
+	MPSCQueue() = default;
+	MPSCQueue(const MPSCQueue&) = delete;
+	MPSCQueue(MPSCQueue&&) = delete;
+	MPSCQueue& operator=(const MPSCQueue&) = delete;
+	MPSCQueue& operator=(MPSCQueue&&) = delete;
+
+	~MPSCQueue() {
+		Node* node = head.load(std::memory_order_acquire);
+		while (node) {
+			delete std::exchange(node, node->next);
+		}
+	}
+
+	/** Add an element to the queue. Thread safe.
+	  * Returns true iff the queue was empty before this element was added.
+	  */
+	bool push(T t) {
+		auto* node = new Node{std::move(t), head.load(std::memory_order_relaxed)};
+		while (!head.compare_exchange_weak(node->next, node,
+		                                   std::memory_order_release,
+		                                   std::memory_order_relaxed)) {
+			// retry, 'node->next' was updated
+		}
+		return node->next == nullptr;
+	}
+
+	/** Move all elements from this queue to the end of the given vector
+	  * (in FIFO order). Returns true iff at least one element was moved.
+	  * May only be called from the consumer thread.
+	  */
+	bool popAll(std::vector<T>& result) {
+		Node* node = head.exchange(nullptr, std::memory_order_acquire);
+		if (!node) return false;
+
+		// reverse the list
+		Node* reversed = nullptr;
+		while (node) {
+			reversed = std::exchange(node, std::exchange(node->next, reversed));
+		}
+		while (reversed) {
+			result.push_back(std::move(reversed->value));
+			delete std::exchange(reversed, reversed->next);
+		}
+		return true;
+	}
+
+	/** Note: when called from a producer thread the result may already be
+	  * outdated by the time it's returned.
+	  */
+	[[nodiscard]] bool empty() const {
+		return head.load(std::memory_order_acquire) == nullptr;
+	}
+
+private:
+	struct Node {
+		T value;
+		Node* next;
+	};
+	std::atomic<Node*> head = nullptr;
+};
+
+#endif
@@ -0,0 +1,174 @@
+#ifndef POLYMORPHICLOG_HH
+#define POLYMORPHICLOG_HH
+
+#include "ranges.hh"
+
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// PolymorphicLog
+//
+// An append-only sequence of objects of (different) subclasses of 'Base'.
+// It's similar to a std::vector<std::unique_ptr<Base>>, but the objects are
+// allocated in large memory blocks instead of each with a separate heap
+// allocation. Appending an object is typically only a pointer increment. The
+// memory for each object is only its own size, plus one pointer in the index.
+//
+// Besides appending, the log can only shrink at the end (truncate(),
+// pop_back()), so the block memory is used as a stack. Memory that becomes
+// free this way is reused by later appends.
+//
+// Objects that were already allocated on the heap (e.g. by the (polymorphic)
+// loader of the serialize framework) can be adopted. Such objects must all be
+// adopted before the first object is appended via emplace_back().
+//
+// 'Base' must have a virtual destructor.
+
+template<typename Base> class PolymorphicLog
+{
+public:
+	static constexpr size_t BLOCK_SIZE = 64 * 1024;
+
+	using const_iterator = typename std::vector<Base*>::const_iterator;
+
+	PolymorphicLog() = default;
+	PolymorphicLog(const PolymorphicLog&) = delete;
+	PolymorphicLog& operator=(const PolymorphicLog&) = delete;
+	PolymorphicLog(PolymorphicLog&& other) noexcept { swap(other); }
+	PolymorphicLog& operator=(PolymorphicLog&& other) noexcept {
+		PolymorphicLog tmp(std::move(other));
+		swap(tmp);
+		return *this;
+	}
+	~PolymorphicLog() { truncate(0); }
+
+	void swap(PolymorphicLog& other) noexcept {
+		std::swap(entries,      other.entries);
+		std::swap(numAdopted,   other.numAdopted);
+		std::swap(blocks,       other.blocks);
+		std::swap(blockStart,   other.blockStart);
+		std::swap(currentBlock, other.currentBlock);
+		std::swap(used,         other.used);
+	}
+	friend void swap(PolymorphicLog& x, PolymorphicLog& y) noexcept { x.swap(y); }
+
+	[[nodiscard]] size_t size() const { return entries.size(); }
+	[[nodiscard]] bool empty() const { return entries.empty(); }
+
+	[[nodiscard]]       Base& operator[](size_t i)       { assert(i < size()); return *entries[i]; }
+	[[nodiscard]] const Base& operator[](size_t i) const { assert(i < size()); return *entries[i]; }
+	[[nodiscard]]       Base& back()       { assert(!empty()); return *entries.back(); }
+	[[nodiscard]] const Base& back() const { assert(!empty()); return *entries.back(); }
+
+	// Iterates over 'Base*' values.
+	[[nodiscard]] const_iterator begin() const { return entries.begin(); }
+	[[nodiscard]] const_iterator end()   const { return entries.end(); }
+
+	/** Construct a new object of type 'T' at the end of the log. */
+	template<typename T, typename... Args>
+	T& emplace_back(Args&& ...args) {
+		static_assert(std::is_base_of_v<Base, T>);
+		static_assert(std::has_virtual_destructor_v<Base>);
+		static_assert(sizeof(T) <= BLOCK_SIZE);
+		static_assert(alignof(T) <= alignof(std::max_align_t));
+
+		entries.reserve(entries.size() + 1); // don't throw after construction
+		void* p = allocate(sizeof(T), alignof(T));
+		T* t = new (p) T(std::forward<Args>(args)...); // if this throws, only 'p' is wasted
+		entries.push_back(t);
+		return *t;
+	}
+
+	/** Take ownership of a heap allocated object. This is only allowed
+	  * before the first call to emplace_back() (or after clear()).
+	  */
+	void adopt(std::unique_ptr<Base> t) {
+		assert(numAdopted == entries.size());
+		entries.push_back(t.get());
+		t.release();
+		++numAdopted;
+	}
+
+	/** Remove (and destroy) all objects at positions >= n. */
+	void truncate(size_t n) {
+		if (n >= entries.size()) return;
+
+		// destroy in reverse order
+		for (size_t i = entries.size(); i-- > std::max(n, numAdopted); /**/) {
+			entries[i]->~Base();
+		}
+		for (size_t i = numAdopted; i-- > n; /**/) {
+			delete entries[i];
+		}
+
+		// rewind the block allocator to where the first removed object was
+		if (n <= numAdopted) {
+			currentBlock = 0;
+			used = 0;
+			blockStart.clear();
+			numAdopted = n;
+		} else {
+			auto it = ranges::upper_bound(blockStart, n);
+			assert(it != blockStart.begin());
+			currentBlock = (it - blockStart.begin()) - 1;
+			used = reinterpret_cast<std::byte*>(entries[n]) - blocks[currentBlock].get();
+			blockStart.erase(it, blockStart.end());
+		}
+		entries.erase(entries.begin() + n, entries.end());
+	}
+
+	void pop_back() {
+		assert(!empty());
+		truncate(size() - 1);
+	}
+
+	/** Remove all objects and release all memory. */
+	void clear() {
+		PolymorphicLog().swap(*this);
+	}
+
+	/** Total allocated memory (for the objects and the index). */
+	[[nodiscard]] size_t getMemoryUsage() const {
+		return blocks.size() * BLOCK_SIZE
+		     + entries.capacity() * sizeof(Base*)
+		     + blockStart.capacity() * sizeof(size_t);
+	}
+
+private:
+	[[nodiscard]] void* allocate(size_t bytes, size_t alignment) {
+		if (!blockStart.empty()) {
+			void* p = blocks[currentBlock].get() + used;
+			size_t available = BLOCK_SIZE - used;
+			if (std::align(alignment, bytes, p, available)) {
+				used = BLOCK_SIZE - available + bytes;
+				return p;
+			}
+			++currentBlock;
+		}
+		// start a new block (possibly reuse one that was freed by truncate())
+		if (currentBlock == blocks.size()) {
+			blocks.push_back(std::make_unique<std::byte[]>(BLOCK_SIZE));
+		}
+		blockStart.push_back(entries.size());
+		used = bytes;
+		return blocks[currentBlock].get(); // aligned for any (fundamental) type
+	}
+
+private:
+	std::vector<Base*> entries;
+	size_t numAdopted = 0; // the first 'numAdopted' entries are heap allocated
+
+	std::vector<std::unique_ptr<std::byte[]>> blocks;
+	// Index of the first entry in each (used) block. Only blocks up to and
+	// including 'currentBlock' are in use, the others are kept for reuse.
+	std::vector<size_t> blockStart;
+	size_t currentBlock = 0;
+	size_t used = 0; // number of used bytes in 'currentBlock'
+};
+
+#endif
@@ -4,10 +4,19 @@
 #include "Math.hh"
 #include "MemBuffer.hh"
 #include "ScopedAssign.hh"
+#include "endian.hh"
+#include "narrow.hh"
+#include "ranges.hh"
+#include "scope_exit.hh"
+#include "xrange.hh"
 
+#include <algorithm>
+#include <barrier>
 #include <cassert>
+#include <cstring>
 #include <map>
 #include <span>
+#include <thread>
 
 namespace openmsx {
 
@@ -54,6 +63,9 @@ TigerTree::TigerTree(TTData& data_, size_t dataSize_, const std::string& name)
 
 const TigerHash& TigerTree::calcHash(const std::function<void(size_t, size_t)>& progressCallback)
 {
+	if (!entry.nodes[getTop().n].valid) {
+		calcLeavesParallel(progressCallback);
+	}
 	return calcHash(getTop(), progressCallback);
 }
 
@@ -68,19 +80,190 @@ void TigerTree::notifyChange(size_t offset, size_t len, time_t time)
 		entry.nodes[getTop().n].valid = false; // set sentinel
 		entry.numNodesValid--;
 	}
+	auto top = getTop().n;
 	auto first = offset / BLOCK_SIZE;
 	auto last = (offset + len - 1) / BLOCK_SIZE;
 	assert(first <= last); // requires len != 0
 	do {
+		// Normally an invalid node has only invalid ancestors, so we can
+		// stop at the first invalid node. Except after loadState(), then
+		// the lower levels of the tree are invalid but the upper ones
+		// can be valid.
 		auto node = getLeaf(first);
-		while (entry.nodes[node.n].valid) {
-			entry.nodes[node.n].valid = false;
-			entry.numNodesValid--;
+		while (entry.nodes[node.n].valid || (node.l < PERSIST_LEVEL)) {
+			if (entry.nodes[node.n].valid) {
+				entry.nodes[node.n].valid = false;
+				entry.numNodesValid--;
+			}
+			if (node.n == top) break;
 			node = getParent(node);
 		}
 	} while (++first <= last);
 }
 
+// Calculate the hashes of (full) leaf nodes in parallel. This is only done
+// when many leaves need to be (re)calculated (e.g. on the initial
+// calculation), the remaining leaves and all internal nodes are calculated
+// (sequentially) by calcHash().
+void TigerTree::calcLeavesParallel(const std::function<void(size_t, size_t)>& progressCallback)
+{
+	auto numThreads = std::min(std::thread::hardware_concurrency(), 8u);
+	if (numThreads <= 1) return;
+
+	static constexpr size_t BATCH = 4096; // number of blocks per batch
+	static constexpr size_t MIN_LEAVES = 64; // fewer isn't worth the threads
+	// each block is preceded by some extra bytes, see TTData::getData()
+	static constexpr size_t SLOT = BLOCK_SIZE + 64;
+
+	MemBuffer<uint8_t> buffer;
+	std::vector<size_t> todo; // block numbers
+	auto work = [&](size_t t) {
+		for (size_t i = t; i < todo.size(); i += numThreads) {
+			std::span block{&buffer[i * SLOT + (SLOT - BLOCK_SIZE)], BLOCK_SIZE};
+			tiger_leaf(block, entry.nodes[getLeaf(todo[i]).n].hash);
+		}
+	};
+
+	// The worker threads are started on the first batch and then reused
+	// for all following batches. In between batches they wait on the
+	// barrier, also when the main thread leaves this function (possibly
+	// via an exception from TTData::getData()).
+	std::barrier sync(narrow<ptrdiff_t>(numThreads));
+	bool stop = false;
+	std::vector<std::thread> threads;
+	scope_exit stopThreads([&] {
+		if (threads.empty()) return;
+		stop = true;
+		sync.arrive_and_wait();
+		for (auto& thread : threads) thread.join();
+	});
+
+	auto hashBatch = [&] {
+		// fetching the data is not thread-safe, do it upfront
+		buffer.resize(todo.size() * SLOT);
+		for (auto i : xrange(todo.size())) {
+			const auto* d = data.getData(todo[i] * BLOCK_SIZE, BLOCK_SIZE);
+			memcpy(&buffer[i * SLOT + (SLOT - BLOCK_SIZE)], d, BLOCK_SIZE);
+		}
+
+		if (threads.empty()) {
+			for (auto t : xrange(1u, numThreads)) {
+				threads.emplace_back([&, t] {
+					while (true) {
+						sync.arrive_and_wait(); // wait for a batch
+						if (stop) return;
+						work(t);
+						sync.arrive_and_wait(); // batch done
+					}
+				});
+			}
+		}
+		sync.arrive_and_wait(); // start the batch
+		work(0);
+		sync.arrive_and_wait(); // wait till all threads are done
+
+		for (auto block : todo) {
+			entry.nodes[getLeaf(block).n].valid = true;
+		}
+		entry.numNodesValid += todo.size();
+		if (progressCallback) {
+			progressCallback(entry.numNodesValid, entry.nodes.size());
+		}
+		todo.clear();
+	};
+
+	// Find the invalid leaves below invalid internal nodes (in order).
+	std::vector<Node> stack = {getTop()};
+	while (!stack.empty()) {
+		auto node = stack.back();
+		stack.pop_back();
+		if (entry.nodes[node.n].valid) continue;
+		if (node.n & 1) {
+			stack.push_back(getRightChild(node));
+			stack.push_back(getLeftChild(node));
+		} else if (auto block = node.n / 2;
+		           (block + 1) * BLOCK_SIZE <= dataSize) { // full block
+			todo.push_back(block);
+			if (todo.size() == BATCH) hashBatch();
+		}
+	}
+	if (todo.size() >= MIN_LEAVES) hashBatch();
+}
+
+namespace {
+	struct StateHeader {
+		std::array<char, 8> magic;
+		Endian::L64 dataSize;
+		Endian::L64 time;
+		Endian::L64 numNodes; // number of stored nodes
+	};
+	struct StateNode {
+		uint8_t valid;
+		std::array<uint8_t, 24> hash;
+	};
+	constexpr std::array<char, 8> STATE_MAGIC = {'o', 'M', 'S', 'X', 'T', 'T', 'H', '1'};
+}
+
+// Persisted nodes are the nodes with level >= PERSIST_LEVEL. See the
+// comment below about the node numbering: those are the nodes with
+// 'n % PERSIST_LEVEL == PERSIST_LEVEL - 1'.
+[[nodiscard]] static size_t numPersistedNodes(size_t numNodes)
+{
+	return (numNodes + 1) / TigerTree::PERSIST_LEVEL;
+}
+[[nodiscard]] static size_t persistedNode(size_t i)
+{
+	return (i + 1) * TigerTree::PERSIST_LEVEL - 1;
+}
+
+std::vector<uint8_t> TigerTree::saveState() const
+{
+	auto num = numPersistedNodes(entry.nodes.size());
+	if ((num == 0) || (entry.numNodesValid == 0)) return {};
+
+	std::vector<uint8_t> result(sizeof(StateHeader) + num * sizeof(StateNode));
+	StateHeader header;
+	header.magic = STATE_MAGIC;
+	header.dataSize = dataSize;
+	header.time = uint64_t(entry.time);
+	header.numNodes = num;
+	memcpy(result.data(), &header, sizeof(header));
+	for (auto i : xrange(num)) {
+		const auto& nod = entry.nodes[persistedNode(i)];
+		StateNode s;
+		s.valid = nod.valid;
+		s.hash = nod.hash.h8;
+		memcpy(&result[sizeof(StateHeader) + i * sizeof(StateNode)], &s, sizeof(s));
+	}
+	return result;
+}
+
+bool TigerTree::loadState(std::span<const uint8_t> state)
+{
+	auto num = numPersistedNodes(entry.nodes.size());
+	if (state.size() != sizeof(StateHeader) + num * sizeof(StateNode)) return false;
+
+	StateHeader header;
+	memcpy(&header, state.data(), sizeof(header));
+	if ((header.magic != STATE_MAGIC) ||
+	    (header.dataSize != dataSize) ||
+	    (time_t(uint64_t(header.time)) != entry.time) ||
+	    (header.numNodes != num)) {
+		return false;
+	}
+	for (auto i : xrange(num)) {
+		StateNode s;
+		memcpy(&s, &state[sizeof(StateHeader) + i * sizeof(StateNode)], sizeof(s));
+		auto& nod = entry.nodes[persistedNode(i)];
+		if (s.valid && !nod.valid) {
+			nod.hash.h8 = s.hash;
+			nod.valid = true;
+			entry.numNodesValid++;
+		}
+	}
+	return true;
+}
+
 const TigerHash& TigerTree::calcHash(Node node, const std::function<void(size_t, size_t)>& progressCallback)
 {
 	auto n = node.n;
@@ -32,6 +32,8 @@
 #include <cstdint>
 #include <ctime>
 #include <functional>
+#include <span>
+#include <vector>
 
 namespace openmsx {
 
@@ -74,6 +76,11 @@ class TigerTree
 public:
 	static constexpr size_t BLOCK_SIZE = 1024;
 
+	/** Only the nodes that cover at least this many blocks are included
+	  * in the persistent state, see saveState().
+	  */
+	static constexpr size_t PERSIST_LEVEL = 64;
+
 	/** Create TigerTree calculator for the given (abstract) data block
 	 * of given size.
 	 */
@@ -90,6 +97,22 @@ public:
 	 */
 	void notifyChange(size_t offset, size_t len, time_t time);
 
+	/** Serialize the (valid) hashes of the upper part of the tree, so that
+	  * a later session can skip most of the calculation. Only the nodes
+	  * that cover at least PERSIST_LEVEL blocks are included, that's only
+	  * a small fraction of the full tree. On a change, the missing lower
+	  * nodes are recalculated from the data.
+	  * Returns an empty vector when there's nothing worth saving.
+	  */
+	[[nodiscard]] std::vector<uint8_t> saveState() const;
+
+	/** Restore hashes saved by saveState(). This is ignored (and returns
+	  * false) when the state doesn't match the data, e.g. because the data
+	  * was modified (according to TTData::isCacheStillValid()) after the
+	  * state was saved.
+	  */
+	bool loadState(std::span<const uint8_t> state);
+
 private:
 	// functions to navigate in binary tree
 	struct Node {
@@ -104,6 +127,7 @@ private:
 	[[nodiscard]] Node getRightChild(Node node) const;
 
 	[[nodiscard]] const TigerHash& calcHash(Node node, const std::function<void(size_t, size_t)>& progressCallback);
+	void calcLeavesParallel(const std::function<void(size_t, size_t)>& progressCallback);
 
 private:
 	TTData& data;
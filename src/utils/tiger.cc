@@ -730,7 +730,8 @@ void tiger_int(const TigerHash& h0, const TigerHash& h1, TigerHash& result)
 
 void tiger_leaf(std::span<uint8_t> data, TigerHash& result)
 {
-	static std::array<uint8_t, 64> last = {
+	// not static: this function may be called from multiple threads
+	std::array<uint8_t, 64> last = {
 		0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
 		0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
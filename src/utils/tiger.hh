@@ -54,7 +54,7 @@ void tiger_int(const TigerHash& h0, const TigerHash& h1, TigerHash& result);
 /** Use for tiger-tree leaf node hash calculations.
  * Take a 1+1024-byte input block, add some marker/padding/length bytes
  * before/after and calculate a tiger-hash.
- * This function is not reentrant.
+ * This function may be called concurrently (for different data blocks).
  * This function requires that data[0] can be (temporarily) overridden (so
  * after the function returns the data buffer is unchanged, but temporarily
  * it is changed, hence the parameter cannot be const).
@@ -20,6 +20,7 @@
 #include "EnumSetting.hh"
 #include "Reactor.hh"
 #include "MSXMotherBoard.hh"
+#include "StartupTrace.hh"
 #include "HardwareConfig.hh"
 #include "TclArgParser.hh"
 #include "XMLElement.hh"
@@ -160,6 +161,7 @@ bool Display::signalEvent(const Event& event)
 			if (e.needRender()) {
 				repaint();
 				reactor.getEventDistributor().distributeEvent(FrameDrawnEvent());
+				StartupTrace::finish("first emulated frame");
 			}
 		},
 		[&](const SwitchRendererEvent& /*e*/) {
@@ -13,6 +13,7 @@
 #include "GLContext.hh"
 #include "GLScaler.hh"
 #include "GLScalerFactory.hh"
+#include "InputLatency.hh"
 #include "MSXMotherBoard.hh"
 #include "OutputSurface.hh"
 #include "PNG.hh"
@@ -50,10 +51,12 @@ PostProcessor::PostProcessor(
 	, display(display_)
 	, renderSettings(display_.getRenderSettings())
 	, eventDistributor(motherBoard_.getReactor().getEventDistributor())
+	, inputLatency(motherBoard_.getInputLatency())
 	, screen(screen_)
 	, maxWidth(maxWidth_)
 	, height(height_)
 	, canDoInterlace(canDoInterlace_)
+	, shadow(motherBoard_.isShadow())
 	, lastRotate(motherBoard_.getCurrentTime())
 {
 	if (canDoInterlace) {
@@ -127,6 +130,8 @@ unsigned PostProcessor::getLineWidth(
 
 void PostProcessor::executeUntil(EmuTime::param /*time*/)
 {
+	if (shadow) return;
+
 	// insert fake end of frame event
 	eventDistributor.distributeEvent(FinishFrameEvent(
 		getVideoSource(), getVideoSourceSetting(), false));
@@ -326,6 +331,7 @@ void PostProcessor::paint(OutputSurface& /*output*/)
 		glBindBuffer(GL_ARRAY_BUFFER, 0);
 	}
 	storedFrame = true;
+	inputLatency.framePainted();
 	//gl::checkGLError("PostProcessor::paint");
 }
 
@@ -339,6 +345,7 @@ std::unique_ptr<RawFrame> PostProcessor::rotateFrames(
 		setSyncPoint(middle);
 	}
 	lastRotate = time;
+	inputLatency.frameRendered(time);
 
 	// Figure out how many past frames we want to use.
 	int numRequired = 1;
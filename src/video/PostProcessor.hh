@@ -23,6 +23,7 @@ class DoubledFrame;
 class EventDistributor;
 class FrameSource;
 class GLScaler;
+class InputLatency;
 class MSXMotherBoard;
 class RawFrame;
 class RenderSettings;
@@ -126,6 +127,7 @@ private:
 	Display& display;
 	RenderSettings& renderSettings;
 	EventDistributor& eventDistributor;
+	InputLatency& inputLatency;
 
 	/** The surface which is visible to the user. */
 	OutputSurface& screen;
@@ -170,6 +172,10 @@ private:
 	  */
 	const bool canDoInterlace;
 
+	/** Frames of the run-ahead shadow machine are not reported (only the
+	  * real machine does that). */
+	const bool shadow;
+
 	EmuTime lastRotate;
 	/** The currently active scaler.
 	  */
@@ -133,7 +133,7 @@ PostProcessor* SDLRasterizer::getPostProcessor() const
 bool SDLRasterizer::isActive()
 {
 	return postProcessor->needRender() &&
-	       vdp.getMotherBoard().isActive() &&
+	       vdp.getMotherBoard().isVideoShown() &&
 	       !vdp.getMotherBoard().isFastForwarding();
 }
 
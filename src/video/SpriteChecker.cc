@@ -9,6 +9,7 @@ TODO:
 */
 
 #include "SpriteChecker.hh"
+#include "SpriteMasks.hh"
 #include "RenderSettings.hh"
 #include "BooleanSetting.hh"
 #include "serialize.hh"
@@ -83,21 +84,14 @@ void SpriteChecker::updateSprites1(int limit)
 
 inline void SpriteChecker::checkSprites1(int minLine, int maxLine)
 {
-	// This implementation contains a double for-loop. The outer loop goes
-	// over the sprites, the inner loop over the to-be-checked lines. This
-	// is not the order in which the real VDP performs this operation: the
-	// real VDP renders line-per-line and for each line checks all 32
-	// sprites.
-	//
-	// Though this 'reverse' order allows to skip over very large regions
-	// of the inner loop: we only have to process the lines were a
-	// particular sprite is actually visible. I measured this makes this
-	// routine 4x-5x faster!
+	// Like the real VDP, this goes line-per-line and for each line checks
+	// all 32 sprites. Though the Y-coordinates of all sprites are compared
+	// against a line in one go (see visibleSpritesMask()), so only for the
+	// sprites that are actually visible on a line there's more work to do.
 	//
 	// This routine also needs to detect the sprite number of the 'first'
 	// 5th-sprite-condition. With 'first' meaning the first line where this
-	// condition occurs. Because our loops are swapped compared to the real
-	// VDP, we need some extra fixup logic to correctly detect this.
+	// condition occurs.
 
 	// Calculate display line.
 	// This is the line sprites are checked at; the line they are displayed
@@ -111,40 +105,40 @@ inline void SpriteChecker::checkSprites1(int minLine, int maxLine)
 	int magSize = (mag + 1) * size;
 	auto attributePtr = vram.spriteAttribTable.getReadArea<32 * 4>(0);
 	byte patternIndexMask = size == 16 ? 0xFC : 0xFF;
-	int fifthSpriteNum  = -1;  // no 5th sprite detected yet
-	int fifthSpriteLine = 999; // larger than any possible valid line
+	int fifthSpriteNum = -1; // no 5th sprite detected yet
 
+	// Sprites starting from the one with Y=208 are not checked.
+	std::array<uint8_t, 32> spriteY = {};
 	int sprite = 0;
 	for (/**/; sprite < 32; ++sprite) {
-		int y = attributePtr[4 * sprite + 0];
+		auto y = attributePtr[4 * sprite + 0];
 		if (y == 208) break;
+		spriteY[sprite] = y;
+	}
+	uint32_t checkedMask = (sprite == 32) ? ~0u : ((1u << sprite) - 1);
 
-		for (int line = minLine; line < maxLine; ++line) { // 'line' changes in loop
-			// Calculate line number within the sprite.
-			int displayLine = line + displayDelta;
-			int spriteLine = (displayLine - y) & 0xFF;
-			if (spriteLine >= magSize) {
-				// Skip ahead till sprite becomes visible.
-				line += 256 - spriteLine - 1; // -1 because of for-loop
-				continue;
-			}
-
+	for (auto line : xrange(minLine, maxLine)) {
+		auto displayLine = uint8_t(line + displayDelta);
+		auto visible = visibleSpritesMask(spriteY, displayLine, magSize)
+		             & checkedMask;
+		for (/**/; visible; visible &= visible - 1) {
+			int s = std::countr_zero(visible);
 			auto visibleIndex = spriteCount[line];
 			if (visibleIndex == 4) {
-				// Find earliest line where this condition occurs.
-				if (line < fifthSpriteLine) {
-					fifthSpriteLine = line;
-					fifthSpriteNum = sprite;
-				}
-				if (limitSprites) continue;
+				// Lines are checked in order, so this is the
+				// earliest line where this condition occurs.
+				if (fifthSpriteNum == -1) fifthSpriteNum = s;
+				if (limitSprites) break;
 			}
 
+			// Calculate line number within the sprite.
+			int spriteLine = uint8_t(displayLine - spriteY[s]);
 			SpriteInfo& sip = spriteBuffer[line][visibleIndex];
-			int patternIndex = attributePtr[4 * sprite + 2] & patternIndexMask;
+			int patternIndex = attributePtr[4 * s + 2] & patternIndexMask;
 			if (mag) spriteLine /= 2;
 			sip.pattern = calculatePatternNP(patternIndex, spriteLine);
-			sip.x = attributePtr[4 * sprite + 1];
-			byte colorAttrib = attributePtr[4 * sprite + 3];
+			sip.x = attributePtr[4 * s + 1];
+			byte colorAttrib = attributePtr[4 * s + 3];
 			if (colorAttrib & 0x80) sip.x -= 32;
 			sip.colorAttrib = colorAttrib;
 
@@ -187,52 +181,27 @@ inline void SpriteChecker::checkSprites1(int minLine, int maxLine)
 	  they can collide in the V9958 extra border mask. This behaviour is
 	  the same in sprite mode 1 and 2.
 
-	Implemented by checking every pair for collisions.
-	For large numbers of sprites that would be slow,
-	but there are max 4 sprites and therefore max 6 pairs.
+	Implemented by merging the patterns of the (max 4) sprites on a line
+	into a bitmap of that line, see SpriteCollisionMask. The leftmost
+	pixel that's covered twice is the collision coordinate.
 	If any collision is found, method returns at once.
 	*/
 	bool can0collide = vdp.canSpriteColor0Collide();
 	for (auto line : xrange(minLine, maxLine)) {
-		int minXCollision = 999;
-		for (int i = std::min<int>(4, spriteCount[line]); --i >= 1; /**/) {
-			auto color1 = spriteBuffer[line][i].colorAttrib & 0xf;
-			if (!can0collide && (color1 == 0)) continue;
-			int x_i = spriteBuffer[line][i].x;
-			SpritePattern pattern_i = spriteBuffer[line][i].pattern;
-			for (int j = i; --j >= 0; /**/) {
-				auto color2 = spriteBuffer[line][j].colorAttrib & 0xf;
-				if (!can0collide && (color2 == 0)) continue;
-				// Do sprite i and sprite j collide?
-				int x_j = spriteBuffer[line][j].x;
-				int dist = x_j - x_i;
-				if ((-magSize < dist) && (dist < magSize)) {
-					SpritePattern pattern_j = spriteBuffer[line][j].pattern;
-					if (dist < 0) {
-						pattern_j <<= -dist;
-					} else {
-						pattern_j >>= dist;
-					}
-					SpritePattern colPat = pattern_i & pattern_j;
-					if (x_i < 0) {
-						assert(x_i >= -32);
-						colPat &= (1 << (32 + x_i)) - 1;
-					}
-					if (colPat) {
-						int xCollision = x_i + std::countl_zero(colPat);
-						assert(xCollision >= 0);
-						minXCollision = std::min(minXCollision, xCollision);
-					}
-				}
-			}
+		int count = std::min<int>(4, spriteCount[line]);
+		if (count < 2) continue;
+		SpriteCollisionMask collision;
+		for (const auto& s : subspan(spriteBuffer[line], 0, count)) {
+			if (!can0collide && ((s.colorAttrib & 0xf) == 0)) continue;
+			collision.add(s.x, s.pattern);
 		}
-		if (minXCollision < 256) {
+		if (int xCollision = collision.first(); xCollision < 256) {
 			vdp.setSpriteStatus(vdp.getStatusReg0() | 0x20);
 			// verified: collision coords are also filled
 			//           in for sprite mode 1
 			// x-coord should be increased by 12
 			// y-coord                         8
-			collisionX = minXCollision + 12;
+			collisionX = xCollision + 12;
 			collisionY = line - vdp.getLineZero() + 8;
 			return; // don't check lines with higher Y-coord
 		}
@@ -259,7 +228,7 @@ void SpriteChecker::updateSprites2(int limit)
 
 inline void SpriteChecker::checkSprites2(int minLine, int maxLine)
 {
-	// See comment in checkSprites1() about order of inner and outer loops.
+	// See comment in checkSprites1() about the order of the loops.
 
 	// Calculate display line.
 	// This is the line sprites are checked at; the line they are displayed
@@ -272,113 +241,83 @@ inline void SpriteChecker::checkSprites2(int minLine, int maxLine)
 	bool mag = vdp.isSpriteMag();
 	int magSize = (mag + 1) * size;
 	int patternIndexMask = (size == 16) ? 0xFC : 0xFF;
-	int ninthSpriteNum  = -1;  // no 9th sprite detected yet
-	int ninthSpriteLine = 999; // larger than any possible valid line
-
-	// Because it gave a measurable performance boost, we duplicated the
-	// code for planar and non-planar modes.
+	int ninthSpriteNum = -1; // no 9th sprite detected yet
+
+	// Collect the attributes once, then the loop over the lines is the
+	// same for planar and non-planar modes.
+	// Sprites starting from the one with Y=216 are not checked.
+	std::array<uint8_t, 32> spriteY = {};
+	std::array<uint8_t, 32> spriteX;
+	std::array<uint8_t, 32> spritePattern;
 	int sprite = 0;
 	if (planar) {
 		auto [attributePtr0, attributePtr1] =
 			vram.spriteAttribTable.getReadAreaPlanar<32 * 4>(512);
-		// TODO: Verify CC implementation.
 		for (/**/; sprite < 32; ++sprite) {
-			int y = attributePtr0[2 * sprite + 0];
+			auto y = attributePtr0[2 * sprite + 0];
 			if (y == 216) break;
-
-			for (int line = minLine; line < maxLine; ++line) { // 'line' changes in loop
-				// Calculate line number within the sprite.
-				int displayLine = line + displayDelta;
-				int spriteLine = (displayLine - y) & 0xFF;
-				if (spriteLine >= magSize) {
-					// Skip ahead till sprite is visible.
-					line += 256 - spriteLine - 1;
-					continue;
-				}
-
-				auto visibleIndex = spriteCount[line];
-				if (visibleIndex == 8) {
-					// Find earliest line where this condition occurs.
-					if (line < ninthSpriteLine) {
-						ninthSpriteLine = line;
-						ninthSpriteNum = sprite;
-					}
-					if (limitSprites) continue;
-				}
-
-				if (mag) spriteLine /= 2;
-				unsigned colorIndex = (~0u << 10) | (sprite * 16 + spriteLine);
-				byte colorAttrib =
-					vram.spriteAttribTable.readPlanar(colorIndex);
-
-				SpriteInfo& sip = spriteBuffer[line][visibleIndex];
-				int patternIndex = attributePtr0[2 * sprite + 1] & patternIndexMask;
-				sip.pattern = calculatePatternPlanar(patternIndex, spriteLine);
-				sip.x = attributePtr1[2 * sprite + 0];
-				if (colorAttrib & 0x80) sip.x -= 32;
-				sip.colorAttrib = colorAttrib;
-
-				// set sentinel (see below)
-				spriteBuffer[line][visibleIndex + 1].colorAttrib = 0;
-				spriteCount[line] = visibleIndex + 1;
-			}
+			spriteY[sprite] = y;
+			spritePattern[sprite] = attributePtr0[2 * sprite + 1];
+			spriteX[sprite] = attributePtr1[2 * sprite + 0];
 		}
 	} else {
 		auto attributePtr0 =
 			vram.spriteAttribTable.getReadArea<32 * 4>(512);
-		// TODO: Verify CC implementation.
 		for (/**/; sprite < 32; ++sprite) {
-			int y = attributePtr0[4 * sprite + 0];
+			auto y = attributePtr0[4 * sprite + 0];
 			if (y == 216) break;
+			spriteY[sprite] = y;
+			spriteX[sprite] = attributePtr0[4 * sprite + 1];
+			spritePattern[sprite] = attributePtr0[4 * sprite + 2];
+		}
+	}
+	uint32_t checkedMask = (sprite == 32) ? ~0u : ((1u << sprite) - 1);
 
-			for (int line = minLine; line < maxLine; ++line) { // 'line' changes in loop
-				// Calculate line number within the sprite.
-				int displayLine = line + displayDelta;
-				int spriteLine = (displayLine - y) & 0xFF;
-				if (spriteLine >= magSize) {
-					// Skip ahead till sprite is visible.
-					line += 256 - spriteLine - 1;
-					continue;
-				}
-
-				auto visibleIndex = spriteCount[line];
-				if (visibleIndex == 8) {
-					// Find earliest line where this condition occurs.
-					if (line < ninthSpriteLine) {
-						ninthSpriteLine = line;
-						ninthSpriteNum = sprite;
-					}
-					if (limitSprites) continue;
-				}
-
-				if (mag) spriteLine /= 2;
-				unsigned colorIndex = (~0u << 10) | (sprite * 16 + spriteLine);
-				byte colorAttrib =
-					vram.spriteAttribTable.readNP(colorIndex);
-				// Sprites with CC=1 are only visible if preceded by
-				// a sprite with CC=0. However they DO contribute towards
-				// the max-8-sprites-per-line limit, so we can't easily
-				// filter them here. See also
-				//    https://github.com/openMSX/openMSX/issues/497
-
-				SpriteInfo& sip = spriteBuffer[line][visibleIndex];
-				int patternIndex = attributePtr0[4 * sprite + 2] & patternIndexMask;
+	// TODO: Verify CC implementation.
+	for (auto line : xrange(minLine, maxLine)) {
+		auto displayLine = uint8_t(line + displayDelta);
+		auto visible = visibleSpritesMask(spriteY, displayLine, magSize)
+		             & checkedMask;
+		for (/**/; visible; visible &= visible - 1) {
+			int s = std::countr_zero(visible);
+			auto visibleIndex = spriteCount[line];
+			if (visibleIndex == 8) {
+				// Lines are checked in order, so this is the
+				// earliest line where this condition occurs.
+				if (ninthSpriteNum == -1) ninthSpriteNum = s;
+				if (limitSprites) break;
+			}
+
+			// Calculate line number within the sprite.
+			int spriteLine = uint8_t(displayLine - spriteY[s]);
+			if (mag) spriteLine /= 2;
+			unsigned colorIndex = (~0u << 10) | (s * 16 + spriteLine);
+			int patternIndex = spritePattern[s] & patternIndexMask;
+			SpriteInfo& sip = spriteBuffer[line][visibleIndex];
+			byte colorAttrib;
+			if (planar) {
+				colorAttrib = vram.spriteAttribTable.readPlanar(colorIndex);
+				sip.pattern = calculatePatternPlanar(patternIndex, spriteLine);
+			} else {
+				colorAttrib = vram.spriteAttribTable.readNP(colorIndex);
 				sip.pattern = calculatePatternNP(patternIndex, spriteLine);
-				sip.x = attributePtr0[4 * sprite + 1];
-				if (colorAttrib & 0x80) sip.x -= 32;
-				sip.colorAttrib = colorAttrib;
-
-				// Set sentinel. Sentinel is actually only
-				// needed for sprites with CC=1.
-				// In the past we set the sentinel (for all
-				// lines) at the end. But it's slightly faster
-				// to do it only for lines that actually
-				// contain sprites (even if sentinel gets
-				// overwritten a couple of times for lines with
-				// many sprites).
-				spriteBuffer[line][visibleIndex + 1].colorAttrib = 0;
-				spriteCount[line] = visibleIndex + 1;
 			}
+			// Sprites with CC=1 are only visible if preceded by a
+			// sprite with CC=0. However they DO contribute towards
+			// the max-8-sprites-per-line limit, so we can't easily
+			// filter them here. See also
+			//    https://github.com/openMSX/openMSX/issues/497
+			sip.x = spriteX[s];
+			if (colorAttrib & 0x80) sip.x -= 32;
+			sip.colorAttrib = colorAttrib;
+
+			// Set sentinel. Sentinel is actually only needed for
+			// sprites with CC=1. It's slightly faster to only set
+			// it for lines that actually contain sprites (even if
+			// sentinel gets overwritten a couple of times for lines
+			// with many sprites).
+			spriteBuffer[line][visibleIndex + 1].colorAttrib = 0;
+			spriteCount[line] = visibleIndex + 1;
 		}
 	}
 
@@ -419,58 +358,25 @@ inline void SpriteChecker::checkSprites2(int minLine, int maxLine)
 	  they can collide in the V9958 extra border mask. This behaviour is
 	  the same in sprite mode 1 and 2.
 
-	Implemented by checking every pair for collisions.
-	For large numbers of sprites that would be slow.
-	There are max 8 sprites and therefore max 42 pairs.
-	  TODO: Maybe this is slow... Think of something faster.
-	        Probably new approach is needed anyway for OR-ing.
+	Implemented like in sprite mode 1, with max 8 sprites per line.
+	  TODO: Probably new approach is needed anyway for OR-ing.
 	*/
 	bool can0collide = vdp.canSpriteColor0Collide();
 	for (auto line : xrange(minLine, maxLine)) {
-		int minXCollision = 999; // no collision
-		std::span<SpriteInfo, 32 + 1> visibleSprites = spriteBuffer[line];
-		for (int i = std::min<int>(8, spriteCount[line]); --i >= 1; /**/) {
-			auto colorAttrib1 = visibleSprites[i].colorAttrib;
-			if (!can0collide && ((colorAttrib1 & 0xf) == 0)) continue;
+		int count = std::min<int>(8, spriteCount[line]);
+		if (count < 2) continue;
+		SpriteCollisionMask collision;
+		for (const auto& s : subspan(spriteBuffer[line], 0, count)) {
+			if (!can0collide && ((s.colorAttrib & 0xf) == 0)) continue;
 			// If CC or IC is set, this sprite cannot collide.
-			if (colorAttrib1 & 0x60) continue;
-
-			int x_i = visibleSprites[i].x;
-			SpritePattern pattern_i = visibleSprites[i].pattern;
-			for (int j = i; --j >= 0; /**/) {
-				auto colorAttrib2 = visibleSprites[j].colorAttrib;
-				if (!can0collide && ((colorAttrib2 & 0xf) == 0)) continue;
-				// If CC or IC is set, this sprite cannot collide.
-				if (colorAttrib2 & 0x60) continue;
-
-				// Do sprite i and sprite j collide?
-				int x_j = visibleSprites[j].x;
-				int dist = x_j - x_i;
-				if ((-magSize < dist) && (dist < magSize)) {
-					SpritePattern pattern_j = visibleSprites[j].pattern;
-					if (dist < 0) {
-						pattern_j <<= -dist;
-					} else {
-						pattern_j >>= dist;
-					}
-					SpritePattern colPat = pattern_i & pattern_j;
-					if (x_i < 0) {
-						assert(x_i >= -32);
-						colPat &= (1 << (32 + x_i)) - 1;
-					}
-					if (colPat) {
-						int xCollision = x_i + std::countl_zero(colPat);
-						assert(xCollision >= 0);
-						minXCollision = std::min(minXCollision, xCollision);
-					}
-				}
-			}
+			if (s.colorAttrib & 0x60) continue;
+			collision.add(s.x, s.pattern);
 		}
-		if (minXCollision < 256) {
+		if (int xCollision = collision.first(); xCollision < 256) {
 			vdp.setSpriteStatus(vdp.getStatusReg0() | 0x20);
 			// x-coord should be increased by 12
 			// y-coord                         8
-			collisionX = minXCollision + 12;
+			collisionX = xCollision + 12;
 			collisionY = line - vdp.getLineZero() + 8;
 			return; // don't check lines with higher Y-coord
 		}
@@ -0,0 +1,93 @@
+#ifndef SPRITEMASKS_HH
+#define SPRITEMASKS_HH
+
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <span>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace openmsx {
+
+/** Returns a bitmask of the sprites that are visible on the given line: bit
+  * 'n' is set iff sprite 'n' (with Y-coordinate 'spriteY[n]') covers display
+  * line 'line'. All 32 sprites are checked at once.
+  * @param spriteY Y-coordinates from the sprite attribute table.
+  * @param line Display line (only the lower 8 bits matter).
+  * @param magSize Height of the sprites in pixels, including magnification.
+  */
+[[nodiscard]] inline uint32_t visibleSpritesMask(
+	std::span<const uint8_t, 32> spriteY, uint8_t line, unsigned magSize)
+{
+	assert(0 < magSize && magSize <= 32);
+#ifdef __SSE2__
+	// SSE2 version: (line - y) & 0xFF < magSize, in unsigned 8-bit lanes
+	const __m128i l = _mm_set1_epi8(char(line));
+	const __m128i s = _mm_set1_epi8(char(magSize - 1));
+	auto check = [&](const uint8_t* p) {
+		__m128i d = _mm_sub_epi8(l, _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)));
+		return uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_min_epu8(d, s), d)));
+	};
+	return check(&spriteY[0]) | (check(&spriteY[16]) << 16);
+#endif
+
+	// C++ version
+	uint32_t result = 0;
+	for (int n = 31; n >= 0; --n) {
+		auto spriteLine = uint8_t(line - spriteY[n]);
+		result = (result << 1) | (spriteLine < magSize);
+	}
+	return result;
+}
+
+/** Finds the leftmost pixel where two or more sprites on a line overlap.
+  *
+  * Instead of checking all pairs of sprites, the patterns are merged into a
+  * bitmap of the whole line, one sprite at a time. A sprite pattern covers at
+  * most two 32-pixel columns of that bitmap, these are handled together as
+  * one 64-bit mask.
+  */
+class SpriteCollisionMask
+{
+public:
+	/** Add a sprite.
+	  * @param x X-coordinate of the sprite, -32 <= x < 256.
+	  * @param pattern Sprite pattern, bit 31 is the leftmost pixel.
+	  */
+	void add(int x, uint32_t pattern) {
+		assert(-32 <= x && x < 256);
+		auto pos = unsigned(x + 32); // first column is left of the screen
+		auto col = pos / 32;
+		auto mask = (uint64_t(pattern) << 32) >> (pos % 32);
+		auto prev = (uint64_t(once[col]) << 32) | once[col + 1];
+		auto overlap = prev & mask;
+		twice[col + 0] |= uint32_t(overlap >> 32);
+		twice[col + 1] |= uint32_t(overlap);
+		once [col + 0] |= uint32_t(mask >> 32);
+		once [col + 1] |= uint32_t(mask);
+	}
+
+	/** X-coordinate of the leftmost overlapping pixel within the screen
+	  * (0 <= x < 256), or 256 if there is none. */
+	[[nodiscard]] int first() const {
+		for (unsigned col = 1; col <= 8; ++col) {
+			if (auto t = twice[col]) {
+				return int(32 * (col - 1)) + std::countl_zero(t);
+			}
+		}
+		return 256;
+	}
+
+private:
+	// Column 0 is left of the screen, columns 1-8 are on screen, column 9
+	// is right of the screen.
+	std::array<uint32_t, 10> once  = {}; // pixels covered by any sprite
+	std::array<uint32_t, 10> twice = {}; // pixels covered by 2 or more
+};
+
+} // namespace openmsx
+
+#endif
@@ -113,6 +113,8 @@ VDP::VDP(const DeviceConfig& config)
 	, cpu(getCPU()) // used frequently, so cache it
 	, fixedVDPIOdelayCycles(getDelayCycles(getMotherBoard().getMachineConfig()->getConfig().getChild("devices")))
 {
+	setFastIOHandlers<VDP>(); // ports 0x98-0x9B are very frequently accessed
+
 	// Current general defaults for saturation:
 	// - Any MSX with a TMS9x18 VDP: SatPr=SatPb=100%
 	// - Other machines with a TMS9x2x VDP and RGB output:
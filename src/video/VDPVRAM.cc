@@ -103,6 +103,7 @@ static constexpr unsigned bufferSize(unsigned size)
 VDPVRAM::VDPVRAM(VDP& vdp_, unsigned size, EmuTime::param time)
 	: vdp(vdp_)
 	, data(*vdp_.getDeviceConfig2().getXML(), bufferSize(size))
+	, generations(bufferSize(size) >> GENERATION_BLOCK_BITS, 0)
 	, logicalVRAMDebug (vdp)
 	, physicalVRAMDebug(vdp, size)
 	, actualSize(size)
@@ -136,6 +137,7 @@ void VDPVRAM::clear()
 		// give the same value.
 		ranges::fill(subspan(data, actualSize), 0xFF);
 	}
+	changedAll();
 }
 
 void VDPVRAM::updateDisplayMode(DisplayMode mode, bool cmdBit, EmuTime::param time)
@@ -213,6 +215,7 @@ void VDPVRAM::updateVRMode(bool newVRmode, EmuTime::param time)
 			std::swap(data[i], data[swapAddr(i)]);
 		}
 	}
+	changedAll();
 }
 
 void VDPVRAM::setRenderer(Renderer* newRenderer, EmuTime::param time)
@@ -294,6 +297,7 @@ void VDPVRAM::change4k8kMapping(bool mapping8k)
 	}
 	//ranges::copy(tmp, std::span{data}); // TODO error with clang-15/libc++
 	ranges::copy(tmp, std::span{data.begin(), data.end()});
+	changedAll();
 }
 
 
@@ -319,6 +323,9 @@ void VDPVRAM::serialize(Archive& ar, unsigned /*version*/)
 	}
 
 	ar.serialize_blob("data", std::span{data.data(), actualSize});
+	if constexpr (Archive::IS_LOADER) {
+		changedAll();
+	}
 	ar.serialize("cmdReadWindow",       cmdReadWindow,
 	             "cmdWriteWindow",      cmdWriteWindow,
 	             "nameTable",           nameTable,
@@ -8,7 +8,10 @@
 #include "Ram.hh"
 #include "Math.hh"
 #include "openmsx.hh"
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
+#include <vector>
 
 namespace openmsx {
 
@@ -565,6 +568,23 @@ public:
 		return {data.data(), data.size()};
 	}
 
+	/** Returns a value that changes whenever the content of the (physical)
+	  * VRAM range [begin, end) changes. E.g. the debugger uses this to
+	  * avoid decoding the same VRAM content over and over again.
+	  * Implemented as the sum of (monotonically increasing) per-block
+	  * change counters, so changes outside the given range are (mostly)
+	  * not visible.
+	  */
+	[[nodiscard]] uint64_t getGeneration(unsigned begin, unsigned end) const {
+		end = std::min(end, unsigned(data.size()));
+		uint64_t result = 0;
+		for (unsigned block = begin >> GENERATION_BLOCK_BITS;
+		     (block << GENERATION_BLOCK_BITS) < end; ++block) {
+			result += generations[block];
+		}
+		return result;
+	}
+
 	template<typename Archive>
 	void serialize(Archive& ar, unsigned version);
 
@@ -590,6 +610,7 @@ private:
 		spritePatternTable.notify(address, time);
 
 		data[address] = value;
+		++generations[address >> GENERATION_BLOCK_BITS];
 
 		// Cache dirty marking should happen after the commit,
 		// otherwise the cache could be re-validated based on old state.
@@ -619,6 +640,12 @@ private:
 
 	void setSizeMask(EmuTime::param time);
 
+	/** Called when (potentially) all of VRAM changed at once.
+	  */
+	void changedAll() {
+		for (auto& g : generations) ++g;
+	}
+
 private:
 	/** VDP this VRAM belongs to.
 	  */
@@ -628,6 +655,11 @@ private:
 	  */
 	Ram data;
 
+	/** Change counters, one per block of VRAM, see getGeneration().
+	  */
+	static constexpr unsigned GENERATION_BLOCK_BITS = 11; // 2kB
+	std::vector<uint32_t> generations;
+
 	/** Debuggable with mode dependent view on the vram
 	  *   Screen7/8 are not interleaved in this mode.
 	  *   This debuggable is also at least 128kB in size (it possibly
@@ -26,10 +26,12 @@ VideoLayer::VideoLayer(MSXMotherBoard& motherBoard_,
 	videoSourceSetting.attach(*this);
 	powerSetting.attach(*this);
 	motherBoard.getMSXEventDistributor().registerEventListener(*this);
+	motherBoard.registerVideoLayer(*this);
 }
 
 VideoLayer::~VideoLayer()
 {
+	motherBoard.unregisterVideoLayer(*this);
 	motherBoard.getMSXEventDistributor().unregisterEventListener(*this);
 	powerSetting.detach(*this);
 	videoSourceSetting.detach(*this);
@@ -64,7 +66,7 @@ void VideoLayer::calcZ()
 
 void VideoLayer::calcCoverage()
 {
-	auto cov = (!powerSetting.getBoolean() || !motherBoard.isActive())
+	auto cov = (!powerSetting.getBoolean() || !motherBoard.isVideoShown())
 	         ? Coverage::NONE
 	         : Coverage::FULL;
 	setCoverage(cov);
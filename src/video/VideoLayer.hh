@@ -48,6 +48,10 @@ public:
 	[[nodiscard]] bool needRender() const;
 	[[nodiscard]] bool needRecord() const;
 
+	/** Calculates the current coverage of this layer. Called by the
+	  * MSXMotherBoard when MSXMotherBoard::isVideoShown() changes. */
+	void calcCoverage();
+
 protected:
 	VideoLayer(MSXMotherBoard& motherBoard,
 	           const std::string& videoSource);
@@ -59,8 +63,6 @@ protected:
 private:
 	/** Calculates the current Z coordinate of this layer. */
 	void calcZ();
-	/** Calculates the current coverage of this layer. */
-	void calcCoverage();
 
 	// MSXEventListener
 	void signalMSXEvent(const Event& event,
@@ -28,11 +28,13 @@ void LDPixelRenderer::frameStart(EmuTime::param time)
 
 bool LDPixelRenderer::isActive() const
 {
-	return motherboard.isActive();
+	return motherboard.isVideoShown();
 }
 
 void LDPixelRenderer::frameEnd()
 {
+	// only the real machine (not the run-ahead shadow) reports its frames
+	if (motherboard.isShadow()) return;
 	eventDistributor.distributeEvent(FinishFrameEvent(
 		rasterizer->getPostProcessor()->getVideoSource(),
 		motherboard.getVideoSource().getSource(),
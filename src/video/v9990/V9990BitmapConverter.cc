@@ -1,6 +1,7 @@
 #include "V9990BitmapConverter.hh"
 #include "V9990VRAM.hh"
 #include "V9990.hh"
+#include "V9990PixelOps.hh"
 #include "unreachable.hh"
 #include "narrow.hh"
 #include <array>
@@ -23,117 +24,32 @@ V9990BitmapConverter::V9990BitmapConverter(
 	setColorMode(V9990ColorMode::PP, V9990DisplayMode::B0); // initialize with dummy values
 }
 
-template<bool YJK, bool PAL, bool SKIP, std::unsigned_integral Pixel, typename ColorLookup>
-static inline void draw_YJK_YUV_PAL(
-	ColorLookup color, const V9990VRAM& vram,
-	Pixel* __restrict& out, unsigned& address, int firstX = 0)
-{
-	std::array<byte, 4> data;
-	for (auto& d : data) {
-		d = vram.readVRAMBx(address++);
-	}
-
-	int u = (data[2] & 7) + ((data[3] & 3) << 3) - ((data[3] & 4) << 3);
-	int v = (data[0] & 7) + ((data[1] & 3) << 3) - ((data[1] & 4) << 3);
-
-	for (auto i : xrange(SKIP ? firstX : 0, 4)) {
-		if (PAL && (data[i] & 0x08)) {
-			*out++ = color.lookup64(data[i] >> 4);
-		} else {
-			int y = (data[i] & 0xF8) >> 3;
-			int r = std::clamp(y + u,                   0, 31);
-			int g = std::clamp((5 * y - 2 * u - v) / 4, 0, 31);
-			int b = std::clamp(y + v,                   0, 31);
-			// The only difference between YUV and YJK is that
-			// green and blue are swapped.
-			if constexpr (YJK) std::swap(g, b);
-			*out++ = color.lookup32768((g << 10) + (r << 5) + b);
-		}
-	}
-}
-
-template<std::unsigned_integral Pixel, typename ColorLookup>
-static void rasterBYUV(
-	ColorLookup color, const V9990& vdp, const V9990VRAM& vram,
-	std::span<Pixel> buf, unsigned x, unsigned y)
-{
-	Pixel* __restrict out = buf.data();
-	int nrPixels = narrow<int>(buf.size());
-	unsigned address = (x & ~3) + y * vdp.getImageWidth();
-	if (x & 3) {
-		draw_YJK_YUV_PAL<false, false, true>(
-			color, vram, out, address, x & 3);
-		nrPixels -= narrow<int>(4 - (x & 3));
-	}
-	for (/**/; nrPixels > 0; nrPixels -= 4) {
-		draw_YJK_YUV_PAL<false, false, false>(
-			color, vram, out, address);
-	}
-	// Note: this can draw up to 3 pixels too many, but that's ok.
-}
-
-template<std::unsigned_integral Pixel, typename ColorLookup>
-static void rasterBYUVP(
-	ColorLookup color, const V9990& vdp, const V9990VRAM& vram,
-	std::span<Pixel> buf, unsigned x, unsigned y)
-{
-	// TODO this mode cannot be shown in B4 and higher resolution modes
-	//      (So the dual palette for B4 modes is not an issue here.)
-	Pixel* __restrict out = buf.data();
-	int nrPixels = narrow<int>(buf.size());
-	unsigned address = (x & ~3) + y * vdp.getImageWidth();
-	if (x & 3) {
-		draw_YJK_YUV_PAL<false, true, true>(
-			color, vram, out, address, x & 3);
-		nrPixels -= narrow<int>(4 - (x & 3));
-	}
-	for (/**/; nrPixels > 0; nrPixels -= 4) {
-		draw_YJK_YUV_PAL<false, true, false>(
-			color, vram, out, address);
-	}
-	// Note: this can draw up to 3 pixels too many, but that's ok.
-}
-
-template<std::unsigned_integral Pixel, typename ColorLookup>
-static void rasterBYJK(
-	ColorLookup color, const V9990& vdp, const V9990VRAM& vram,
-	std::span<Pixel> buf, unsigned x, unsigned y)
-{
-	Pixel* __restrict out = buf.data();
-	int nrPixels = narrow<int>(buf.size());
-	unsigned address = (x & ~3) + y * vdp.getImageWidth();
-	if (x & 3) {
-		draw_YJK_YUV_PAL<true, false, true>(
-			color, vram, out, address, x & 3);
-		nrPixels -= narrow<int>(4 - (x & 3));
-	}
-	for (/**/; nrPixels > 0; nrPixels -= 4) {
-		draw_YJK_YUV_PAL<true, false, false>(
-			color, vram, out, address);
-	}
-	// Note: this can draw up to 3 pixels too many, but that's ok.
-}
+// Temporary buffers hold one display line (at most 1024 pixels), plus the
+// pixels before and after it that share the same VRAM bytes.
+static constexpr size_t MAX_PIXELS = 1024 + 4;
 
-template<std::unsigned_integral Pixel, typename ColorLookup>
-static void rasterBYJKP(
+template<bool YJK, bool PAL, std::unsigned_integral Pixel, typename ColorLookup>
+static void rasterYJK_YUV(
 	ColorLookup color, const V9990& vdp, const V9990VRAM& vram,
 	std::span<Pixel> buf, unsigned x, unsigned y)
 {
-	// TODO this mode cannot be shown in B4 and higher resolution modes
+	// TODO the 'P' modes cannot be shown in B4 and higher resolution modes
 	//      (So the dual palette for B4 modes is not an issue here.)
-	Pixel* __restrict out = buf.data();
-	int nrPixels = narrow<int>(buf.size());
-	unsigned address = (x & ~3) + y * vdp.getImageWidth();
-	if (x & 3) {
-		draw_YJK_YUV_PAL<true, true, true>(
-			color, vram, out, address, x & 3);
-		nrPixels -= narrow<int>(4 - (x & 3));
-	}
-	for (/**/; nrPixels > 0; nrPixels -= 4) {
-		draw_YJK_YUV_PAL<true, true, false>(
-			color, vram, out, address);
+	// Groups of 4 pixels share the U/V or J/K components, so always
+	// convert whole groups.
+	unsigned skip = x & 3;
+	auto num = (skip + buf.size() + 3) & ~3;
+	assert(num <= MAX_PIXELS);
+	std::array<byte, MAX_PIXELS> data;
+	std::array<uint16_t, MAX_PIXELS> indices;
+	vram.readVRAMBx((x & ~3) + y * vdp.getImageWidth(), subspan(data, 0, num));
+	V9990PixelOps::yjkToIndex<YJK, PAL>(subspan(data, 0, num), subspan(indices, 0, num));
+
+	for (auto i : xrange(buf.size())) {
+		auto idx = indices[skip + i];
+		buf[i] = (PAL && (idx & 0x8000)) ? color.lookup64(idx & 0x0F)
+		                                 : color.lookup32768(idx);
 	}
-	// Note: this can draw up to 3 pixels too many, but that's ok.
 }
 
 template<std::unsigned_integral Pixel, typename ColorLookup>
@@ -141,27 +57,23 @@ static void rasterBD16(
 	ColorLookup color, const V9990& vdp, const V9990VRAM& vram,
 	std::span<Pixel> buf, unsigned x, unsigned y)
 {
-	Pixel* __restrict out = buf.data();
-	int nrPixels = narrow<int>(buf.size());
-	unsigned address = 2 * (x + y * vdp.getImageWidth());
-	if (vdp.isSuperimposing()) {
+	auto num = buf.size();
+	assert(num <= MAX_PIXELS);
+	std::array<byte, 2 * MAX_PIXELS> data;
+	std::array<uint16_t, MAX_PIXELS> indices;
+	vram.readVRAMBx(2 * (x + y * vdp.getImageWidth()), subspan(data, 0, 2 * num));
+	bool superimpose = vdp.isSuperimposing();
+	V9990PixelOps::bd16ToIndex(subspan(data, 0, 2 * num), subspan(indices, 0, num), superimpose);
+
+	if (superimpose) {
 		auto transparent = color.lookup256(0);
-		for (/**/; nrPixels > 0; --nrPixels) {
-			byte high = vram.readVRAMBx(address + 1);
-			if (high & 0x80) {
-				*out = transparent;
-			} else {
-				byte low  = vram.readVRAMBx(address + 0);
-				*out = color.lookup32768(low + 256 * high);
-			}
-			address += 2;
-			out += 1;
+		for (auto i : xrange(num)) {
+			auto idx = indices[i];
+			buf[i] = (idx & 0x8000) ? transparent : color.lookup32768(idx);
 		}
 	} else {
-		for (/**/; nrPixels > 0; --nrPixels) {
-			byte low  = vram.readVRAMBx(address++);
-			byte high = vram.readVRAMBx(address++);
-			*out++ = color.lookup32768((low + 256 * high) & 0x7FFF);
+		for (auto i : xrange(num)) {
+			buf[i] = color.lookup32768(indices[i]);
 		}
 	}
 }
@@ -171,11 +83,11 @@ static void rasterBD8(
 	ColorLookup color, const V9990& vdp, const V9990VRAM& vram,
 	std::span<Pixel> buf, unsigned x, unsigned y)
 {
-	Pixel* __restrict out = buf.data();
-	int nrPixels = narrow<int>(buf.size());
-	unsigned address = x + y * vdp.getImageWidth();
-	for (/**/; nrPixels > 0; --nrPixels) {
-		*out++ = color.lookup256(vram.readVRAMBx(address++));
+	assert(buf.size() <= MAX_PIXELS);
+	std::array<byte, MAX_PIXELS> data;
+	vram.readVRAMBx(x + y * vdp.getImageWidth(), subspan(data, 0, buf.size()));
+	for (auto i : xrange(buf.size())) {
+		buf[i] = color.lookup256(data[i]);
 	}
 }
 
@@ -184,11 +96,38 @@ static void rasterBP6(
 	ColorLookup color, const V9990& vdp, const V9990VRAM& vram,
 	std::span<Pixel> buf, unsigned x, unsigned y)
 {
-	Pixel* __restrict out = buf.data();
-	int nrPixels = narrow<int>(buf.size());
-	unsigned address = x + y * vdp.getImageWidth();
-	for (/**/; nrPixels > 0; --nrPixels) {
-		*out++ = color.lookup64(vram.readVRAMBx(address++) & 0x3F);
+	assert(buf.size() <= MAX_PIXELS);
+	std::array<byte, MAX_PIXELS> data;
+	vram.readVRAMBx(x + y * vdp.getImageWidth(), subspan(data, 0, buf.size()));
+	for (auto i : xrange(buf.size())) {
+		buf[i] = color.lookup64(data[i] & 0x3F);
+	}
+}
+
+// Shared by the BP4 and BP2 modes, which have 'PPB' (2 or 4) pixels per byte.
+// 'evenOr' and 'oddOr' are ORed into the palette index of even resp. odd
+// pixels.
+template<unsigned PPB, std::unsigned_integral Pixel, typename ColorLookup>
+static void rasterPacked(
+	ColorLookup color, const V9990& vdp, const V9990VRAM& vram,
+	std::span<Pixel> buf, unsigned x, unsigned y, byte evenOr, byte oddOr)
+{
+	assert(!buf.empty());
+	unsigned skip = x % PPB;
+	auto numBytes = (skip + buf.size() + PPB - 1) / PPB;
+	assert(PPB * numBytes <= MAX_PIXELS);
+	std::array<byte, MAX_PIXELS / 2> data;
+	std::array<byte, MAX_PIXELS> pixels;
+	vram.readVRAMBx((x + y * vdp.getImageWidth()) / PPB, subspan(data, 0, numBytes));
+	if constexpr (PPB == 2) {
+		V9990PixelOps::unpack4(subspan(data, 0, numBytes), subspan(pixels, 0, 2 * numBytes), evenOr, oddOr);
+	} else {
+		static_assert(PPB == 4);
+		V9990PixelOps::unpack2(subspan(data, 0, numBytes), subspan(pixels, 0, 4 * numBytes), evenOr, oddOr);
+	}
+
+	for (auto i : xrange(buf.size())) {
+		buf[i] = color.lookup64(pixels[skip + i]);
 	}
 }
 
@@ -197,22 +136,8 @@ static void rasterBP4(
 	ColorLookup color, const V9990& vdp, const V9990VRAM& vram,
 	std::span<Pixel> buf, unsigned x, unsigned y)
 {
-	Pixel* __restrict out = buf.data();
-	int nrPixels = narrow<int>(buf.size());
-	assert(nrPixels > 0);
-	unsigned address = (x + y * vdp.getImageWidth()) / 2;
 	color.set64Offset((vdp.getPaletteOffset() & 0xC) << 2);
-	if (x & 1) {
-		byte data = vram.readVRAMBx(address++);
-		*out++ = color.lookup64(data & 0x0F);
-		--nrPixels;
-	}
-	for (/**/; nrPixels > 0; nrPixels -= 2) {
-		byte data = vram.readVRAMBx(address++);
-		*out++ = color.lookup64(data >> 4);
-		*out++ = color.lookup64(data & 0x0F);
-	}
-	// Note: this possibly draws 1 pixel too many, but that's ok.
+	rasterPacked<2>(color, vdp, vram, buf, x, y, 0, 0);
 }
 template<std::unsigned_integral Pixel, typename ColorLookup>
 static void rasterBP4HiRes(
@@ -222,21 +147,8 @@ static void rasterBP4HiRes(
 	// Verified on real HW:
 	//   Bit PLT05 in palette offset is ignored, instead for even pixels
 	//   bit 'PLT05' is '0', for odd pixels it's '1'.
-	Pixel* __restrict out = buf.data();
-	int nrPixels = narrow<int>(buf.size());
-	unsigned address = (x + y * vdp.getImageWidth()) / 2;
 	color.set64Offset((vdp.getPaletteOffset() & 0x4) << 2);
-	if (x & 1) {
-		byte data = vram.readVRAMBx(address++);
-		*out++ = color.lookup64(32 | (data & 0x0F));
-		--nrPixels;
-	}
-	for (/**/; nrPixels > 0; nrPixels -= 2) {
-		byte data = vram.readVRAMBx(address++);
-		*out++ = color.lookup64( 0 | (data >> 4  ));
-		*out++ = color.lookup64(32 | (data & 0x0F));
-	}
-	// Note: this possibly draws 1 pixel too many, but that's ok.
+	rasterPacked<2>(color, vdp, vram, buf, x, y, 0, 32);
 }
 
 template<std::unsigned_integral Pixel, typename ColorLookup>
@@ -244,26 +156,8 @@ static void rasterBP2(
 	ColorLookup color, const V9990& vdp, const V9990VRAM& vram,
 	std::span<Pixel> buf, unsigned x, unsigned y)
 {
-	Pixel* __restrict out = buf.data();
-	int nrPixels = narrow<int>(buf.size());
-	assert(nrPixels > 0);
-	unsigned address = (x + y * vdp.getImageWidth()) / 4;
 	color.set64Offset(vdp.getPaletteOffset() << 2);
-	if (x & 3) {
-		byte data = vram.readVRAMBx(address++);
-		if ((x & 3) <= 1) *out++ = color.lookup64((data & 0x30) >> 4);
-		if ((x & 3) <= 2) *out++ = color.lookup64((data & 0x0C) >> 2);
-		if (true)         *out++ = color.lookup64((data & 0x03) >> 0);
-		nrPixels -= narrow<int>(4 - (x & 3));
-	}
-	for (/**/; nrPixels > 0; nrPixels -= 4) {
-		byte data = vram.readVRAMBx(address++);
-		*out++ = color.lookup64((data & 0xC0) >> 6);
-		*out++ = color.lookup64((data & 0x30) >> 4);
-		*out++ = color.lookup64((data & 0x0C) >> 2);
-		*out++ = color.lookup64((data & 0x03) >> 0);
-	}
-	// Note: this can draw up to 3 pixels too many, but that's ok.
+	rasterPacked<4>(color, vdp, vram, buf, x, y, 0, 0);
 }
 template<std::unsigned_integral Pixel, typename ColorLookup>
 static void rasterBP2HiRes(
@@ -273,26 +167,8 @@ static void rasterBP2HiRes(
 	// Verified on real HW:
 	//   Bit PLT05 in palette offset is ignored, instead for even pixels
 	//   bit 'PLT05' is '0', for odd pixels it's '1'.
-	Pixel* __restrict out = buf.data();
-	int nrPixels = narrow<int>(buf.size());
-	assert(nrPixels > 0);
-	unsigned address = (x + y * vdp.getImageWidth()) / 4;
 	color.set64Offset((vdp.getPaletteOffset() & 0x7) << 2);
-	if (x & 3) {
-		byte data = vram.readVRAMBx(address++);
-		if ((x & 3) <= 1) *out++ = color.lookup64(32 | ((data & 0x30) >> 4));
-		if ((x & 3) <= 2) *out++ = color.lookup64( 0 | ((data & 0x0C) >> 2));
-		if (true)         *out++ = color.lookup64(32 | ((data & 0x03) >> 0));
-		nrPixels -= narrow<int>(4 - (x & 3));
-	}
-	for (/**/; nrPixels > 0; nrPixels -= 4) {
-		byte data = vram.readVRAMBx(address++);
-		*out++ = color.lookup64( 0 | ((data & 0xC0) >> 6));
-		*out++ = color.lookup64(32 | ((data & 0x30) >> 4));
-		*out++ = color.lookup64( 0 | ((data & 0x0C) >> 2));
-		*out++ = color.lookup64(32 | ((data & 0x03) >> 0));
-	}
-	// Note: this can draw up to 3 pixels too many, but that's ok.
+	rasterPacked<4>(color, vdp, vram, buf, x, y, 0, 32);
 }
 
 // Helper class to translate V9990 palette indices into host Pixel values.
@@ -352,10 +228,10 @@ static void raster(V9990ColorMode colorMode, bool highRes,
 {
 	switch (colorMode) {
 	using enum V9990ColorMode;
-	case BYUV:  return rasterBYUV <Pixel>(color, vdp, vram, out, x, y);
-	case BYUVP: return rasterBYUVP<Pixel>(color, vdp, vram, out, x, y);
-	case BYJK:  return rasterBYJK <Pixel>(color, vdp, vram, out, x, y);
-	case BYJKP: return rasterBYJKP<Pixel>(color, vdp, vram, out, x, y);
+	case BYUV:  return rasterYJK_YUV<false, false, Pixel>(color, vdp, vram, out, x, y);
+	case BYUVP: return rasterYJK_YUV<false, true,  Pixel>(color, vdp, vram, out, x, y);
+	case BYJK:  return rasterYJK_YUV<true,  false, Pixel>(color, vdp, vram, out, x, y);
+	case BYJKP: return rasterYJK_YUV<true,  true,  Pixel>(color, vdp, vram, out, x, y);
 	case BD16:  return rasterBD16 <Pixel>(color, vdp, vram, out, x, y);
 	case BD8:   return rasterBD8  <Pixel>(color, vdp, vram, out, x, y);
 	case BP6:   return rasterBP6  <Pixel>(color, vdp, vram, out, x, y);
@@ -468,7 +344,7 @@ void V9990BitmapConverter::convertLine(
 
 	if (cursor0.isVisible() || cursor1.isVisible()) {
 		// raster background into a temporary buffer
-		std::array<uint16_t, 1024 + 3> buf; // allow to draw upto 3 pixels too many, e.g. see rasterBP2()
+		std::array<uint16_t, 1024> buf;
 		raster(colorMode, highRes,
 		       IndexLookup(palette64_32768, palette256_32768),
 		       vdp, vram,
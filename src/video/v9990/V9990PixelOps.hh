@@ -0,0 +1,251 @@
+#ifndef V9990PIXELOPS_HH
+#define V9990PIXELOPS_HH
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <span>
+#include <utility>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/** Building blocks for V9990BitmapConverter and V9990PxConverter. Instead of
+  * handling one pixel at a time, these work on (part of) a display line. The
+  * steps that don't depend on the host palette (reading VRAM, splitting bytes
+  * into pixels, the YJK/YUV calculations) are done here, SSE2 accelerated
+  * where possible. The final palette lookup remains a scalar loop in the
+  * converters (SSE2 has no gather instruction).
+  */
+namespace openmsx::V9990PixelOps {
+
+/** Copy consecutive bytes in Bx order (see V9990VRAM::transformBx()) from a
+  * VRAM image, like calling V9990VRAM::readVRAMBx() for each address.
+  * @param vram The complete V9990 VRAM (512kB).
+  * @param address Bx address of the first byte, wraps at 512kB.
+  * @param out The bytes are written here.
+  */
+inline void readBx(std::span<const uint8_t, 0x80000> vram, unsigned address,
+                   std::span<uint8_t> out)
+{
+	for (size_t i = 0; i < out.size(); /**/) {
+		unsigned a = (address + unsigned(i)) & 0x7FFFF;
+#ifdef __SSE2__
+		// SSE2 version: even addresses are in the first, odd addresses
+		// in the second bank, so interleave 16 bytes of both banks
+		if (((a & 1) == 0) && ((out.size() - i) >= 32) && ((a >> 1) <= (0x40000 - 16))) {
+			auto* p = &vram[a >> 1];
+			__m128i bank0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+			__m128i bank1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 0x40000));
+			auto* o = reinterpret_cast<__m128i*>(&out[i]);
+			_mm_storeu_si128(o + 0, _mm_unpacklo_epi8(bank0, bank1));
+			_mm_storeu_si128(o + 1, _mm_unpackhi_epi8(bank0, bank1));
+			i += 32;
+			continue;
+		}
+#endif
+		// C++ version (also near the end of a bank)
+		out[i++] = vram[((a & 1) << 18) | (a >> 1)];
+	}
+}
+
+/** Convert BYUV(P) or BYJK(P) data to 15-bit color indices (the same layout
+  * as the index in the 32768-entry palette). In the 'P' variants pixels with
+  * bit 3 set select a color from the 64-entry palette instead, for those the
+  * result is 0x8000 plus the index in that palette.
+  * @param in VRAM data, groups of 4 bytes.
+  * @param out One index per input byte.
+  */
+template<bool YJK, bool PAL>
+inline void yjkToIndex(std::span<const uint8_t> in, std::span<uint16_t> out)
+{
+	assert((in.size() % 4) == 0);
+	assert(out.size() == in.size());
+	size_t i = 0;
+#ifdef __SSE2__
+	// SSE2 version: 2 groups (8 pixels) at a time, in 16-bit lanes
+	const __m128i zero  = _mm_setzero_si128();
+	const __m128i max   = _mm_set1_epi16(31);
+	const __m128i seven = _mm_set1_epi16(7);
+	const __m128i eight = _mm_set1_epi16(8);
+	const __m128i pal64 = _mm_set1_epi16(int16_t(0x8000));
+	auto clamp = [&](__m128i x) { return _mm_min_epi16(_mm_max_epi16(x, zero), max); };
+	// sign extend a 6-bit value
+	auto sext6 = [](__m128i x) { return _mm_srai_epi16(_mm_slli_epi16(x, 10), 10); };
+	for (/**/; (i + 8) <= in.size(); i += 8) {
+		__m128i d = _mm_unpacklo_epi8(
+			_mm_loadl_epi64(reinterpret_cast<const __m128i*>(&in[i])), zero);
+		// byte 0, 1, 2 or 3 of each group copied to all lanes of that group
+		__m128i d0 = _mm_shufflehi_epi16(_mm_shufflelo_epi16(d, 0x00), 0x00);
+		__m128i d1 = _mm_shufflehi_epi16(_mm_shufflelo_epi16(d, 0x55), 0x55);
+		__m128i d2 = _mm_shufflehi_epi16(_mm_shufflelo_epi16(d, 0xAA), 0xAA);
+		__m128i d3 = _mm_shufflehi_epi16(_mm_shufflelo_epi16(d, 0xFF), 0xFF);
+		__m128i u = sext6(_mm_or_si128(_mm_and_si128(d2, seven),
+		                               _mm_slli_epi16(_mm_and_si128(d3, seven), 3)));
+		__m128i v = sext6(_mm_or_si128(_mm_and_si128(d0, seven),
+		                               _mm_slli_epi16(_mm_and_si128(d1, seven), 3)));
+		__m128i y = _mm_srli_epi16(d, 3);
+
+		__m128i r = clamp(_mm_add_epi16(y, u));
+		// Arithmetic shift rounds down instead of towards zero, but
+		// that only matters for negative values, those get clamped to 0.
+		__m128i y5 = _mm_add_epi16(_mm_slli_epi16(y, 2), y);
+		__m128i g = clamp(_mm_srai_epi16(
+			_mm_sub_epi16(_mm_sub_epi16(y5, _mm_add_epi16(u, u)), v), 2));
+		__m128i b = clamp(_mm_add_epi16(y, v));
+		if constexpr (YJK) std::swap(g, b);
+		__m128i idx = _mm_or_si128(_mm_or_si128(_mm_slli_epi16(g, 10),
+		                                        _mm_slli_epi16(r, 5)), b);
+		if constexpr (PAL) {
+			__m128i isPal = _mm_cmpeq_epi16(_mm_and_si128(d, eight), eight);
+			__m128i p = _mm_or_si128(_mm_srli_epi16(d, 4), pal64);
+			idx = _mm_or_si128(_mm_and_si128(isPal, p), _mm_andnot_si128(isPal, idx));
+		}
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(&out[i]), idx);
+	}
+#endif
+	// C++ version (also for the remaining group)
+	for (/**/; i < in.size(); i += 4) {
+		auto data = in.subspan(i, 4);
+		int u = (data[2] & 7) + ((data[3] & 3) << 3) - ((data[3] & 4) << 3);
+		int v = (data[0] & 7) + ((data[1] & 3) << 3) - ((data[1] & 4) << 3);
+		for (auto j : {0, 1, 2, 3}) {
+			if (PAL && (data[j] & 0x08)) {
+				out[i + j] = uint16_t(0x8000 | (data[j] >> 4));
+			} else {
+				int y = (data[j] & 0xF8) >> 3;
+				int r = std::clamp(y + u,                   0, 31);
+				int g = std::clamp((5 * y - 2 * u - v) / 4, 0, 31);
+				int b = std::clamp(y + v,                   0, 31);
+				// The only difference between YUV and YJK is that
+				// green and blue are swapped.
+				if constexpr (YJK) std::swap(g, b);
+				out[i + j] = uint16_t((g << 10) + (r << 5) + b);
+			}
+		}
+	}
+}
+
+/** Combine BD16 data (low byte first) to 15-bit color indices. Bit 15 (the
+  * superimpose bit) is only kept when 'keepBit15' is set.
+  * @param in VRAM data, 2 bytes per pixel.
+  * @param out One index per pixel.
+  */
+inline void bd16ToIndex(std::span<const uint8_t> in, std::span<uint16_t> out, bool keepBit15)
+{
+	assert(in.size() == 2 * out.size());
+	uint16_t mask = keepBit15 ? 0xFFFF : 0x7FFF;
+	size_t i = 0;
+#ifdef __SSE2__
+	// SSE2 version: x86 is little endian, so the bytes already are in the
+	// right order
+	const __m128i m = _mm_set1_epi16(int16_t(mask));
+	for (/**/; (i + 8) <= out.size(); i += 8) {
+		__m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&in[2 * i]));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(&out[i]), _mm_and_si128(d, m));
+	}
+#endif
+	// C++ version (also for the remaining pixels)
+	for (/**/; i < out.size(); ++i) {
+		out[i] = uint16_t((in[2 * i + 0] | (in[2 * i + 1] << 8)) & mask);
+	}
+}
+
+/** Split each byte in two 4-bit pixels, high nibble first, e.g. for BP4.
+  * 'evenOr' resp. 'oddOr' is ORed into the even resp. odd pixels.
+  * @param in VRAM data.
+  * @param out Two pixels per input byte.
+  */
+inline void unpack4(std::span<const uint8_t> in, std::span<uint8_t> out,
+                    uint8_t evenOr = 0, uint8_t oddOr = 0)
+{
+	assert(out.size() == 2 * in.size());
+	size_t i = 0;
+#ifdef __SSE2__
+	// SSE2 version: 16 bytes (32 pixels) at a time
+	const __m128i mask = _mm_set1_epi8(0x0F);
+	const __m128i ors = _mm_set1_epi16(int16_t(evenOr | (oddOr << 8)));
+	for (/**/; (i + 16) <= in.size(); i += 16) {
+		__m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&in[i]));
+		__m128i hi = _mm_and_si128(_mm_srli_epi16(d, 4), mask);
+		__m128i lo = _mm_and_si128(d, mask);
+		auto* o = reinterpret_cast<__m128i*>(&out[2 * i]);
+		_mm_storeu_si128(o + 0, _mm_or_si128(_mm_unpacklo_epi8(hi, lo), ors));
+		_mm_storeu_si128(o + 1, _mm_or_si128(_mm_unpackhi_epi8(hi, lo), ors));
+	}
+#endif
+	// C++ version (also for the remaining bytes)
+	for (/**/; i < in.size(); ++i) {
+		out[2 * i + 0] = uint8_t((in[i] >> 4)   | evenOr);
+		out[2 * i + 1] = uint8_t((in[i] & 0x0F) | oddOr);
+	}
+}
+
+/** Split each byte in four 2-bit pixels, most significant bits first, e.g.
+  * for BP2. 'evenOr' resp. 'oddOr' is ORed into the even resp. odd pixels.
+  * @param in VRAM data.
+  * @param out Four pixels per input byte.
+  */
+inline void unpack2(std::span<const uint8_t> in, std::span<uint8_t> out,
+                    uint8_t evenOr = 0, uint8_t oddOr = 0)
+{
+	assert(out.size() == 4 * in.size());
+	size_t i = 0;
+#ifdef __SSE2__
+	// SSE2 version: 16 bytes (64 pixels) at a time, first split in 4-bit
+	// and then in 2-bit parts
+	const __m128i mask4 = _mm_set1_epi8(0x0F);
+	const __m128i mask2 = _mm_set1_epi8(0x03);
+	const __m128i ors = _mm_set1_epi16(int16_t(evenOr | (oddOr << 8)));
+	auto split2 = [&](__m128i n, __m128i* o) {
+		__m128i hi = _mm_and_si128(_mm_srli_epi16(n, 2), mask2);
+		__m128i lo = _mm_and_si128(n, mask2);
+		_mm_storeu_si128(o + 0, _mm_or_si128(_mm_unpacklo_epi8(hi, lo), ors));
+		_mm_storeu_si128(o + 1, _mm_or_si128(_mm_unpackhi_epi8(hi, lo), ors));
+	};
+	for (/**/; (i + 16) <= in.size(); i += 16) {
+		__m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&in[i]));
+		__m128i hi = _mm_and_si128(_mm_srli_epi16(d, 4), mask4);
+		__m128i lo = _mm_and_si128(d, mask4);
+		auto* o = reinterpret_cast<__m128i*>(&out[4 * i]);
+		split2(_mm_unpacklo_epi8(hi, lo), o + 0);
+		split2(_mm_unpackhi_epi8(hi, lo), o + 2);
+	}
+#endif
+	// C++ version (also for the remaining bytes)
+	for (/**/; i < in.size(); ++i) {
+		out[4 * i + 0] = uint8_t(((in[i] >> 6) & 3) | evenOr);
+		out[4 * i + 1] = uint8_t(((in[i] >> 4) & 3) | oddOr);
+		out[4 * i + 2] = uint8_t(((in[i] >> 2) & 3) | evenOr);
+		out[4 * i + 3] = uint8_t(((in[i] >> 0) & 3) | oddOr);
+	}
+}
+
+/** Split the 4 pattern bytes of one (8 pixels wide) P1/P2 character line
+  * in 4-bit pixels, all in one 64-bit register.
+  * @param pattern The pattern bytes, the first one in the upper 8 bits.
+  * @result Pixel 'i' (0 is the leftmost) is stored in byte 'i' (0 is the
+  *         least significant byte).
+  */
+[[nodiscard]] constexpr uint64_t expandNibbles(uint32_t pattern)
+{
+	// byte 'n' of the pattern to bits [16n, 16n + 8)
+	uint64_t s = (uint64_t((pattern >> 24) & 0xFF) <<  0)
+	           | (uint64_t((pattern >> 16) & 0xFF) << 16)
+	           | (uint64_t((pattern >>  8) & 0xFF) << 32)
+	           | (uint64_t((pattern >>  0) & 0xFF) << 48);
+	constexpr uint64_t MASK = 0x000F'000F'000F'000F;
+	return ((s >> 4) & MASK) | ((s & MASK) << 8);
+}
+
+/** For each byte: 1 if it is non-zero, 0 otherwise.
+  * @pre All bytes are smaller than 0x80, e.g. the result of expandNibbles().
+  */
+[[nodiscard]] constexpr uint64_t nonZeroBytes(uint64_t x)
+{
+	return ((x + 0x7F7F'7F7F'7F7F'7F7F) & 0x8080'8080'8080'8080) >> 7;
+}
+
+} // namespace openmsx::V9990PixelOps
+
+#endif
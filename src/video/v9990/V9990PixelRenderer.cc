@@ -181,10 +181,6 @@ void V9990PixelRenderer::renderUntil(EmuTime::param time)
 		// Left border
 		subdivide(lastX, lastY, toX, toY, 0, left, DRAW_BORDER);
 		// Display area
-		//  It's possible this draws a few pixels too many (this
-		//  allowed to simplify the implementation of the Bx modes).
-		//  So it's important to draw from left to right (right border
-		//  must come _after_ display area).
 		subdivide(lastX, lastY, toX, toY, left, right, DRAW_DISPLAY);
 		// Right border
 		subdivide(lastX, lastY, toX, toY, right, rightEdge, DRAW_BORDER);
@@ -54,7 +54,7 @@ PostProcessor* V9990SDLRasterizer::getPostProcessor() const
 bool V9990SDLRasterizer::isActive()
 {
 	return postProcessor->needRender() &&
-	       vdp.getMotherBoard().isActive() &&
+	       vdp.getMotherBoard().isVideoShown() &&
 	       !vdp.getMotherBoard().isFastForwarding();
 }
 
@@ -252,11 +252,6 @@ void V9990SDLRasterizer::drawBxMode(
 	unsigned scrollYBase = scrollY & ~rollMask & 0x1FFF;
 	int cursorY = displayY - vdp.getCursorYOffset();
 	while (displayHeight--) {
-		// Note: convertLine() can draw up to 3 pixels too many. But
-		// that's ok, the buffer is big enough: buffer can hold 1280
-		// pixels, max displayWidth is 1024 pixels. When taking the
-		// position of the borders into account, the display area
-		// plus 3 pixels cannot go beyond the end of the buffer.
 		unsigned y = scrollYBase + ((displayYA + scrollY) & rollMask);
 		auto dst = workFrame->getLineDirect(fromY).subspan(fromX, displayWidth);
 		bitmapConverter.convertLine(dst, x, y, cursorY, drawSprites);
@@ -2,6 +2,7 @@
 #define V9990VRAM_HH
 
 #include "V9990CmdEngine.hh"
+#include "V9990PixelOps.hh"
 
 #include "EmuTime.hh"
 #include "TrackedRam.hh"
@@ -55,6 +56,14 @@ public:
 	[[nodiscard]] inline byte readVRAMBx(unsigned address) const {
 		return data[transformBx(address)];
 	}
+	/** Read consecutive bytes in Bx order, e.g. (part of) a line of a
+	  * bitmap mode. Same result as calling readVRAMBx() for each address,
+	  * but faster.
+	  */
+	inline void readVRAMBx(unsigned address, std::span<byte> out) const {
+		V9990PixelOps::readBx(std::span<const byte, VRAM_SIZE>(data.begin(), VRAM_SIZE),
+		                      address, out);
+	}
 	[[nodiscard]] inline byte readVRAMP1(unsigned address) const {
 		return data[transformP1(address)];
 	}
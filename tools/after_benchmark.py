@@ -0,0 +1,109 @@
+#!/usr/bin/env python3
+# Measures the overhead of many pending 'after' callbacks. First registers a
+# large number of callbacks that don't trigger during the measurement ('after
+# time', 'after realtime', 'after break', 'after boot' and 'after <event>').
+# Then a short 'after time' chain triggers a callback every millisecond of MSX
+# time (and the frames trigger the 'after frame' callbacks). Reports how much
+# real time it takes to emulate a fixed amount of MSX time (with throttling and
+# rendering off). Compare the results of two openMSX builds, or of different
+# numbers of pending callbacks, to see how dispatch scales.
+#
+# Usage:
+#   after_benchmark.py [options] <openmsx-executable> [openmsx-args...]
+#
+# Options:
+#   --runs N            number of runs, default 5
+#   --seconds N         amount of emulated time per run, default 20
+#   --pending N         number of pending callbacks of each kind, default 2000
+
+from os import environ
+from os.path import join
+from statistics import median
+from subprocess import DEVNULL, TimeoutExpired, run
+from tempfile import TemporaryDirectory
+import sys
+
+SCRIPT = '''
+set renderer none
+set throttle off
+for {set i 0} {$i < %(pending)d} {incr i} {
+	after time 1000000 {}
+	after realtime 1000000 {}
+	after break {}
+	after boot {}
+	after {keyb F12} {}
+}
+proc afterbench_tick {} {
+	after time 0.001 afterbench_tick
+}
+proc afterbench_frame {} {
+	after frame afterbench_frame
+}
+after time 1 {
+	set ::afterbench_start [clock microseconds]
+	afterbench_tick
+	afterbench_frame
+	after time %(seconds)d {
+		set f [open $::env(AFTERBENCH_RESULT) w]
+		puts $f [expr {[clock microseconds] - $::afterbench_start}]
+		close $f
+		exit
+	}
+}
+'''
+
+def main(argv):
+	runs = 5
+	seconds = 20
+	pending = 2000
+	while argv and argv[0].startswith('--'):
+		option = argv.pop(0)
+		if not argv:
+			raise ValueError('missing value for option %s' % option)
+		value = argv.pop(0)
+		if option == '--runs':
+			runs = int(value)
+		elif option == '--seconds':
+			seconds = int(value)
+		elif option == '--pending':
+			pending = int(value)
+		else:
+			raise ValueError('unknown option: %s' % option)
+	if not argv:
+		raise ValueError('missing openMSX executable')
+	executable, args = argv[0], argv[1:]
+
+	with TemporaryDirectory(prefix='openmsx-afterbench-') as tmpDir:
+		scriptFile = join(tmpDir, 'afterbench.tcl')
+		with open(scriptFile, 'w') as out:
+			out.write(SCRIPT % {'pending': pending, 'seconds': seconds})
+		resultFile = join(tmpDir, 'result.txt')
+		env = dict(environ)
+		env['AFTERBENCH_RESULT'] = resultFile
+		command = [executable] + args + ['-script', scriptFile]
+
+		times = []
+		for _ in range(runs):
+			try:
+				run(command, env=env, stdout=DEVNULL, stderr=DEVNULL,
+					timeout=600)
+			except TimeoutExpired:
+				raise OSError('openMSX did not exit within the timeout')
+			try:
+				with open(resultFile) as inp:
+					times.append(int(inp.read()))
+			except (OSError, ValueError):
+				raise OSError('openMSX did not produce a result')
+
+	result = median(times) / 1e6
+	print('emulating %d s with %d pending callbacks (of each kind) took '
+		'%.3f s (median of %d runs)' % (seconds, pending, result, runs))
+	print('emulation speed: %.0f%%' % (100.0 * seconds / result))
+	return 0
+
+if __name__ == '__main__':
+	try:
+		sys.exit(main(sys.argv[1:]))
+	except (OSError, ValueError) as ex:
+		print('after_benchmark: %s' % ex, file=sys.stderr)
+		sys.exit(2)
@@ -0,0 +1,109 @@
+#!/usr/bin/env python3
+# Measures the emulation speed of I/O heavy MSX code. Runs a small generated
+# ROM that executes IN and OUT instructions on the VDP, PSG, PPI and memory
+# mapper ports in a tight loop, and reports how much real time it takes to
+# emulate a fixed amount of MSX time (with throttling and rendering off).
+# Compare the results of two openMSX builds to see the effect of a change.
+#
+# Usage:
+#   io_benchmark.py [options] <openmsx-executable> [openmsx-args...]
+#
+# Options:
+#   --runs N            number of runs, default 5
+#   --seconds N         amount of emulated time per run, default 20
+
+from os import environ
+from os.path import join
+from statistics import median
+from subprocess import DEVNULL, TimeoutExpired, run
+from tempfile import TemporaryDirectory
+import sys
+
+def createRom():
+	rom = bytearray(b'\xFF' * 0x4000)
+	rom[0:4] = b'AB\x10\x40' # cartridge header, init at 0x4010
+	code = bytes((
+		0xF3,             #        di
+		0x06, 0x00,       # loop:  ld   b,0
+		0xDB, 0x99,       # inner: in   a,(0x99)  VDP status
+		0xD3, 0x98,       #        out  (0x98),a  VDP data
+		0xD3, 0xA0,       #        out  (0xA0),a  PSG register latch
+		0xDB, 0xA2,       #        in   a,(0xA2)  PSG data
+		0xDB, 0xA9,       #        in   a,(0xA9)  PPI port B (keyboard)
+		0xDB, 0xFE,       #        in   a,(0xFE)  memory mapper
+		0x10, 0xF2,       #        djnz inner
+		0x18, 0xEE,       #        jr   loop
+		))
+	rom[0x10:0x10 + len(code)] = code
+	return rom
+
+SCRIPT = '''
+set renderer none
+set throttle off
+after time 1 {
+	set ::iobench_start [clock microseconds]
+	after time %d {
+		set f [open $::env(IOBENCH_RESULT) w]
+		puts $f [expr {[clock microseconds] - $::iobench_start}]
+		close $f
+		exit
+	}
+}
+'''
+
+def main(argv):
+	runs = 5
+	seconds = 20
+	while argv and argv[0].startswith('--'):
+		option = argv.pop(0)
+		if not argv:
+			raise ValueError('missing value for option %s' % option)
+		value = argv.pop(0)
+		if option == '--runs':
+			runs = int(value)
+		elif option == '--seconds':
+			seconds = int(value)
+		else:
+			raise ValueError('unknown option: %s' % option)
+	if not argv:
+		raise ValueError('missing openMSX executable')
+	executable, args = argv[0], argv[1:]
+
+	with TemporaryDirectory(prefix='openmsx-iobench-') as tmpDir:
+		romFile = join(tmpDir, 'iobench.rom')
+		with open(romFile, 'wb') as out:
+			out.write(createRom())
+		scriptFile = join(tmpDir, 'iobench.tcl')
+		with open(scriptFile, 'w') as out:
+			out.write(SCRIPT % seconds)
+		resultFile = join(tmpDir, 'result.txt')
+		env = dict(environ)
+		env['IOBENCH_RESULT'] = resultFile
+		command = [executable] + args + [
+			'-cart', romFile, '-script', scriptFile]
+
+		times = []
+		for _ in range(runs):
+			try:
+				run(command, env=env, stdout=DEVNULL, stderr=DEVNULL,
+					timeout=600)
+			except TimeoutExpired:
+				raise OSError('openMSX did not exit within the timeout')
+			try:
+				with open(resultFile) as inp:
+					times.append(int(inp.read()))
+			except (OSError, ValueError):
+				raise OSError('openMSX did not produce a result')
+
+	result = median(times) / 1e6
+	print('emulating %d s of I/O heavy code took %.3f s (median of %d runs)'
+		% (seconds, result, runs))
+	print('emulation speed: %.0f%%' % (100.0 * seconds / result))
+	return 0
+
+if __name__ == '__main__':
+	try:
+		sys.exit(main(sys.argv[1:]))
+	except (OSError, ValueError) as ex:
+		print('io_benchmark: %s' % ex, file=sys.stderr)
+		sys.exit(2)
@@ -0,0 +1,126 @@
+#!/usr/bin/env python3
+# Measures the time from process start until the first emulated frame is
+# displayed, using the startup trace that openMSX writes when the environment
+# variable OPENMSX_STARTUP_TRACE is set.
+#
+# Usage:
+#   startup_benchmark.py [options] <openmsx-executable> [openmsx-args...]
+#
+# Options:
+#   --runs N            number of (timed) runs, default 5
+#   --baseline FILE     compare against the result stored in FILE, exit with
+#                       a non-zero status on a regression
+#   --tolerance PCT     allowed slowdown compared to the baseline, default 10
+#   --save FILE         store the result (to be used later as baseline)
+#   --trace FILE        keep the trace of the last run (for chrome://tracing)
+#
+# The openMSX window must be able to open (the frame needs to be displayed),
+# so this won't work with e.g. the 'none' renderer.
+
+from json import dump, load
+from os import close, environ, remove
+from os.path import exists
+from shutil import copyfile
+from statistics import median
+from subprocess import DEVNULL, TimeoutExpired, run
+from tempfile import mkstemp
+import sys
+
+MILESTONE = 'first emulated frame'
+
+def runOnce(executable, args):
+	# only the name is needed, openMSX (re)creates the file
+	fd, traceFile = mkstemp(prefix='openmsx-startup-', suffix='.json')
+	close(fd)
+	remove(traceFile)
+	env = dict(environ)
+	env['OPENMSX_STARTUP_TRACE'] = traceFile
+	command = [executable] + args + ['-command', 'after frame {after frame exit}']
+	try:
+		run(command, env=env, stdout=DEVNULL, stderr=DEVNULL, timeout=120)
+	except TimeoutExpired:
+		raise OSError('openMSX did not exit within the timeout')
+	if not exists(traceFile):
+		raise OSError('openMSX did not write a startup trace')
+	with open(traceFile) as inp:
+		events = load(inp)['traceEvents']
+	firstFrame = None
+	phases = {}
+	for event in events:
+		if event.get('ph') == 'i' and event['name'] == MILESTONE:
+			firstFrame = event['ts']
+		elif event.get('ph') == 'X':
+			phases[event['name']] = phases.get(event['name'], 0) + event['dur']
+	if firstFrame is None:
+		raise OSError('startup trace does not contain "%s"' % MILESTONE)
+	return firstFrame, phases, traceFile
+
+def main(argv):
+	runs = 5
+	baselineFile = None
+	tolerance = 10.0
+	saveFile = None
+	keepTrace = None
+	while argv and argv[0].startswith('--'):
+		option = argv.pop(0)
+		if not argv:
+			raise ValueError('missing value for option %s' % option)
+		value = argv.pop(0)
+		if option == '--runs':
+			runs = int(value)
+		elif option == '--baseline':
+			baselineFile = value
+		elif option == '--tolerance':
+			tolerance = float(value)
+		elif option == '--save':
+			saveFile = value
+		elif option == '--trace':
+			keepTrace = value
+		else:
+			raise ValueError('unknown option: %s' % option)
+	if not argv:
+		raise ValueError('missing openMSX executable')
+	executable, args = argv[0], argv[1:]
+
+	# warm-up run: fills OS file caches and (re)generates openMSX's own
+	# caches (e.g. the software database cache)
+	firstFrame, phases, traceFile = runOnce(executable, args)
+	remove(traceFile)
+
+	times = []
+	allPhases = {}
+	for i in range(runs):
+		firstFrame, phases, traceFile = runOnce(executable, args)
+		times.append(firstFrame)
+		for name, duration in phases.items():
+			allPhases.setdefault(name, []).append(duration)
+		if keepTrace and i == runs - 1:
+			copyfile(traceFile, keepTrace)
+		remove(traceFile)
+
+	result = median(times)
+	for name, durations in sorted(allPhases.items()):
+		print('%10.1f ms  %s' % (median(durations) / 1000.0, name))
+	print('time to first emulated frame: %.1f ms (median of %d runs)'
+		% (result / 1000.0, runs))
+
+	if saveFile:
+		with open(saveFile, 'w') as out:
+			dump({'first_frame_us': result}, out)
+	if baselineFile:
+		with open(baselineFile) as inp:
+			baseline = load(inp)['first_frame_us']
+		limit = baseline * (1.0 + tolerance / 100.0)
+		print('baseline: %.1f ms, limit: %.1f ms'
+			% (baseline / 1000.0, limit / 1000.0))
+		if result > limit:
+			print('REGRESSION: startup got slower', file=sys.stderr)
+			return 1
+	return 0
+
+if __name__ == '__main__':
+	try:
+		sys.exit(main(sys.argv[1:]))
+	except (OSError, ValueError) as ex:
+		print('startup_benchmark: %s' % ex, file=sys.stderr)
+		sys.exit(2)